@@ -25,7 +25,8 @@ enum class EventType {
     OTA_PROCESS_START,
     OTA_PROCESS_END,
     CARD_CONFIG_CHANGED,
-    CARD_TITLE_UPDATED
+    CARD_TITLE_UPDATED,
+    INSIGHT_REDRAW_REQUESTED  // A card needs its last data drawn again (widgets rebuilt, or shown after deferring)
 };
 
 /**
@@ -63,15 +64,26 @@ struct Event {
  */
 using EventCallback = std::function<void(const Event&)>;
 
+/**
+ * @brief Handle returned by subscribe(), used to unsubscribe
+ */
+using EventSubscription = uint32_t;
+
 /**
  * @brief Thread-safe event queue for handling system events
  */
 class EventQueue {
 private:
     QueueHandle_t eventQueue;
-    SemaphoreHandle_t callbackMutex;
-    std::vector<EventCallback> eventCallbacks;
+    // Only the processing task touches eventCallbacks. Other tasks queue
+    // changes under subscriptionMutex, which is never held while callbacks run.
+    SemaphoreHandle_t subscriptionMutex;
+    std::vector<std::pair<EventSubscription, EventCallback>> eventCallbacks;
+    std::vector<std::pair<EventSubscription, EventCallback>> pendingSubscribes;
+    std::vector<EventSubscription> pendingUnsubscribes;
+    EventSubscription nextSubscription;
     
+    void applyPendingSubscriptions();
     static void eventProcessingTask(void* parameter);
     TaskHandle_t taskHandle;
     bool isRunning;
@@ -124,9 +136,25 @@ public:
     /**
      * @brief Subscribe to events
      * 
+     * Takes effect from the next event the processing task picks up.
+     * 
      * @param callback Function to call when an event is processed
+     * @return Handle to pass to unsubscribe()
+     */
+    EventSubscription subscribe(EventCallback callback);
+
+    /**
+     * @brief Remove a subscription
+     * 
+     * Doesn't wait for the processing task: the subscription is removed
+     * before the next event is dispatched, so a callback already running,
+     * or about to run for the current event, may still be called. Objects
+     * that unsubscribe in their destructor must have the callback check
+     * they are still alive.
+     * 
+     * @param subscription Handle returned by subscribe()
      */
-    void subscribe(EventCallback callback);
+    void unsubscribe(EventSubscription subscription);
     
     /**
      * @brief Start the event processing task
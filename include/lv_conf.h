@@ -79,8 +79,11 @@
 #define LV_STDARG_INCLUDE       <stdarg.h>    // Default
 
 #if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
-    /** Size of memory available for `lv_malloc()` in bytes (>= 2kB) */
+    /** Size of memory available for `lv_malloc()` in bytes (>= 2kB)
+     *  The host simulator passes a larger pool: its pointers are twice the size. */
+    #ifndef LV_MEM_SIZE
     #define LV_MEM_SIZE (32 * 1024U)          /**< [bytes] - Migrated from old config (was 32k) */
+    #endif
 
     /** Size of the memory expand for `lv_malloc()` in bytes */
     #define LV_MEM_POOL_EXPAND_SIZE 0         // Default
@@ -553,7 +556,7 @@
 /*==================
  * OTHERS
  *==================*/
-#define LV_USE_SNAPSHOT 0 // Default
+#define LV_USE_SNAPSHOT 1 // Card transitions slide snapshots instead of the live cards
 #define LV_USE_SYSMON   0 // Keep disabled (old perf/mem monitors were 0)
 #if LV_USE_SYSMON
     #define LV_SYSMON_GET_IDLE lv_os_get_idle_percent // Default
@@ -0,0 +1,124 @@
+#include "HostFlushBackend.h"
+
+HostFlushBackend::HostFlushBackend(uint16_t width, uint16_t height, uint32_t spi_hz)
+    : _width(width),
+      _height(height),
+      _spi_hz(spi_hz),
+      _running(false),
+      _pending(false),
+      _transfer(),
+      _framebuffer((size_t)width * height, 0),
+      _flush_count(0),
+      _pixels_flushed(0),
+      _busy_us(0) {
+}
+
+HostFlushBackend::~HostFlushBackend() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _cv.notify_all();
+    if (_worker.joinable()) {
+        _worker.join();
+    }
+}
+
+bool HostFlushBackend::begin() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_running) {
+        return true;
+    }
+    _running = true;
+    _worker = std::thread(&HostFlushBackend::_run, this);
+    return true;
+}
+
+void HostFlushBackend::flush(int32_t x, int32_t y, uint32_t w, uint32_t h, const uint16_t* pixels, uint32_t stride) {
+    Transfer transfer = {x, y, w, h, pixels, stride};
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!_running) {
+        _blit(transfer);
+        _flush_count++;
+        _pixels_flushed += (uint64_t)w * h;
+        lock.unlock();
+        _signal_done();
+        return;
+    }
+
+    // DisplayInterface keeps one flush outstanding, like the real backend
+    _cv.wait(lock, [this] { return !_pending || !_running; });
+    _transfer = transfer;
+    _pending = true;
+    lock.unlock();
+    _cv.notify_all();
+}
+
+void HostFlushBackend::_run() {
+    while (true) {
+        Transfer transfer;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [this] { return _pending || !_running; });
+            if (!_running) {
+                return;
+            }
+            transfer = _transfer;
+        }
+
+        uint64_t bytes = (uint64_t)transfer.w * transfer.h * sizeof(uint16_t);
+        uint64_t transfer_us = _spi_hz ? bytes * 8 * 1000000ULL / _spi_hz : 0;
+        if (transfer_us) {
+            std::this_thread::sleep_for(std::chrono::microseconds(transfer_us));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _blit(transfer);
+            _flush_count++;
+            _pixels_flushed += (uint64_t)transfer.w * transfer.h;
+            _busy_us += transfer_us;
+            _pending = false;
+        }
+        _cv.notify_all();
+        _signal_done();
+    }
+}
+
+void HostFlushBackend::_blit(const Transfer& transfer) {
+    for (uint32_t row = 0; row < transfer.h; row++) {
+        int32_t y = transfer.y + (int32_t)row;
+        if (y < 0 || y >= _height) continue;
+        for (uint32_t col = 0; col < transfer.w; col++) {
+            int32_t x = transfer.x + (int32_t)col;
+            if (x < 0 || x >= _width) continue;
+            _framebuffer[(size_t)y * _width + x] = transfer.pixels[(size_t)row * transfer.stride + col];
+        }
+    }
+}
+
+void HostFlushBackend::waitIdle() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cv.wait(lock, [this] { return !_pending || !_running; });
+}
+
+std::vector<uint16_t> HostFlushBackend::framebuffer() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _framebuffer;
+}
+
+uint64_t HostFlushBackend::flushCount() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _flush_count;
+}
+
+uint64_t HostFlushBackend::pixelsFlushed() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pixels_flushed;
+}
+
+uint64_t HostFlushBackend::busyMicros() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _busy_us;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "hardware/FlushBackend.h"
+
+/**
+ * @class HostFlushBackend
+ * @brief Flush backend for host builds that emulates the SPI transfer
+ *
+ * A worker thread holds each flush for as long as the panel link would take
+ * to clock the pixels out, then copies them into an in-memory framebuffer and
+ * signals completion. The copy happens at the end on purpose: if LVGL ever
+ * drew into a buffer still "on the wire", the corruption shows in the frame.
+ *
+ * Transfer time is bytes * 8 / spi_hz, ignoring command overhead.
+ */
+class HostFlushBackend : public FlushBackend {
+public:
+    /**
+     * @param width Framebuffer width in pixels
+     * @param height Framebuffer height in pixels
+     * @param spi_hz Emulated SPI clock; 0 completes every flush immediately
+     */
+    HostFlushBackend(uint16_t width, uint16_t height, uint32_t spi_hz = 40000000);
+    ~HostFlushBackend() override;
+
+    bool begin() override;
+    void flush(int32_t x, int32_t y, uint32_t w, uint32_t h, const uint16_t* pixels, uint32_t stride) override;
+    const char* name() const override { return "host-emulated"; }
+
+    /**
+     * @brief Block until the transfer in flight, if any, has completed
+     */
+    void waitIdle();
+
+    /**
+     * @brief Copy of what the panel currently shows, RGB565, row-major
+     */
+    std::vector<uint16_t> framebuffer() const;
+
+    uint16_t width() const { return _width; }
+    uint16_t height() const { return _height; }
+
+    // Totals since begin(), for comparing frame time against transfer time
+    uint64_t flushCount() const;
+    uint64_t pixelsFlushed() const;
+    uint64_t busyMicros() const;   ///< Emulated time spent transferring
+
+private:
+    struct Transfer {
+        int32_t x;
+        int32_t y;
+        uint32_t w;
+        uint32_t h;
+        const uint16_t* pixels;
+        uint32_t stride;
+    };
+
+    uint16_t _width;
+    uint16_t _height;
+    uint32_t _spi_hz;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    std::thread _worker;
+    bool _running;
+    bool _pending;                  ///< _transfer waiting for the worker
+    Transfer _transfer;
+    std::vector<uint16_t> _framebuffer;
+
+    uint64_t _flush_count;
+    uint64_t _pixels_flushed;
+    uint64_t _busy_us;
+
+    void _run();
+
+    /**
+     * @brief Copy a finished transfer into the framebuffer, clipped to it
+     */
+    void _blit(const Transfer& transfer);
+};
@@ -0,0 +1,102 @@
+#include "PngWriter.h"
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+static uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0) {
+    static uint32_t table[256];
+    static bool table_ready = false;
+    if (!table_ready) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        table_ready = true;
+    }
+
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static void putBE32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back((uint8_t)(value >> 24));
+    out.push_back((uint8_t)(value >> 16));
+    out.push_back((uint8_t)(value >> 8));
+    out.push_back((uint8_t)value);
+}
+
+static void putChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+    putBE32(out, (uint32_t)data.size());
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    putBE32(out, crc32(&out[start], out.size() - start));
+}
+
+bool writePngRgb565(const char* path, const uint16_t* pixels, uint16_t width, uint16_t height) {
+    // Raw scanlines: filter byte 0 then RGB888
+    std::vector<uint8_t> raw;
+    raw.reserve((size_t)height * (1 + (size_t)width * 3));
+    for (uint32_t y = 0; y < height; y++) {
+        raw.push_back(0);
+        for (uint32_t x = 0; x < width; x++) {
+            uint16_t c = pixels[(size_t)y * width + x];
+            uint8_t r = (uint8_t)((c >> 11) & 0x1F);
+            uint8_t g = (uint8_t)((c >> 5) & 0x3F);
+            uint8_t b = (uint8_t)(c & 0x1F);
+            raw.push_back((uint8_t)((r << 3) | (r >> 2)));
+            raw.push_back((uint8_t)((g << 2) | (g >> 4)));
+            raw.push_back((uint8_t)((b << 3) | (b >> 2)));
+        }
+    }
+
+    // zlib stream of stored blocks, at most 65535 bytes each
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    size_t offset = 0;
+    do {
+        size_t block = raw.size() - offset;
+        if (block > 65535) block = 65535;
+        bool last = offset + block == raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back((uint8_t)block);
+        zlib.push_back((uint8_t)(block >> 8));
+        zlib.push_back((uint8_t)~block);
+        zlib.push_back((uint8_t)(~block >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + block);
+        offset += block;
+    } while (offset < raw.size());
+
+    uint32_t a = 1, b = 0;
+    for (uint8_t byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    putBE32(zlib, (b << 16) | a);
+
+    std::vector<uint8_t> header;
+    putBE32(header, width);
+    putBE32(header, height);
+    header.push_back(8);  // Bit depth
+    header.push_back(2);  // Colour type: RGB
+    header.push_back(0);  // Compression
+    header.push_back(0);  // Filter
+    header.push_back(0);  // Interlace
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    putChunk(png, "IHDR", header);
+    putChunk(png, "IDAT", zlib);
+    putChunk(png, "IEND", {});
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fwrite(png.data(), 1, png.size(), file) == png.size();
+    return fclose(file) == 0 && ok;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Write an RGB565 framebuffer as an 8-bit RGB PNG
+ *
+ * Uses stored (uncompressed) deflate blocks, so no zlib is needed. Frames are
+ * 240x135, which keeps the files around 100KB.
+ *
+ * @return false if the file couldn't be written
+ */
+bool writePngRgb565(const char* path, const uint16_t* pixels, uint16_t width, uint16_t height);
@@ -0,0 +1,165 @@
+#include "SimDisplay.h"
+#include "PngWriter.h"
+#include <Arduino.h>
+
+SimDisplay::SimDisplay(uint16_t width, uint16_t height, uint16_t buffer_rows, uint32_t spi_hz,
+                       DisplayBufferMode mode)
+    : _width(width),
+      _height(height),
+      _buffer_rows(buffer_rows),
+      _mode(mode),
+      _backend(width, height, spi_hz),
+      _display(nullptr),
+      _completed(0),
+      _in_refresh(false),
+      _refresh_started_us(0),
+      _refresh_started_ms(0),
+      _refresh_wait_us(0),
+      _refresh_areas(0),
+      _refresh_pixels(0),
+      _dispatch_us(0),
+      _record_dir(nullptr) {
+}
+
+SimDisplay::~SimDisplay() {
+    _backend.waitIdle();
+    if (_display) {
+        lv_display_delete(_display);
+        _display = nullptr;
+    }
+}
+
+bool SimDisplay::begin() {
+    size_t rows = _mode == DisplayBufferMode::STRIPS_INTERNAL ? _buffer_rows : _height;
+    _buf1.resize((size_t)_width * rows);
+    if (_mode != DisplayBufferMode::DIRECT_SINGLE) {
+        _buf2.resize((size_t)_width * rows);
+    }
+
+    _backend.setCompletionCallback(_flush_complete, this);
+    _backend.begin();
+
+    _display = lv_display_create(_width, _height);
+    if (!_display) {
+        Serial.println("[SimDisplay] Failed to create LVGL display");
+        return false;
+    }
+
+    lv_display_set_user_data(_display, this);
+    lv_display_set_flush_cb(_display, _flush_cb);
+    lv_display_set_flush_wait_cb(_display, _flush_wait_cb);
+    lv_display_set_buffers(_display, _buf1.data(), _buf2.empty() ? nullptr : _buf2.data(),
+                           _buf1.size() * sizeof(lv_color_t),
+                           _mode == DisplayBufferMode::DIRECT_SINGLE ? LV_DISPLAY_RENDER_MODE_DIRECT
+                                                                     : LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_add_event_cb(_display, _refresh_event_cb, LV_EVENT_REFR_START, this);
+    lv_display_add_event_cb(_display, _refresh_event_cb, LV_EVENT_REFR_READY, this);
+    _profiler.begin(_display);
+    _refresh.begin(_display);
+
+    lv_obj_set_style_bg_color(lv_screen_active(), lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(lv_screen_active(), LV_OPA_COVER, 0);
+    lv_obj_set_style_border_width(lv_screen_active(), 0, 0);
+
+    Serial.printf("[SimDisplay] %ux%u, %s buffers (%u bytes), flush backend %s\n",
+                  _width, _height, displayBufferModeToString(_mode), (unsigned int)bufferBytes(), _backend.name());
+    return true;
+}
+
+bool SimDisplay::savePng(const char* path) {
+    _backend.waitIdle();
+    std::vector<uint16_t> pixels = _backend.framebuffer();
+    if (!writePngRgb565(path, pixels.data(), _width, _height)) {
+        Serial.printf("[SimDisplay] Failed to write %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+void SimDisplay::recordFrames(const char* directory) {
+    _record_dir = directory;
+}
+
+void SimDisplay::_flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map) {
+    SimDisplay* self = static_cast<SimDisplay*>(lv_display_get_user_data(disp));
+    uint32_t w = area->x2 - area->x1 + 1;
+    uint32_t h = area->y2 - area->y1 + 1;
+
+    self->_refresh_areas++;
+    self->_refresh_pixels += (uint64_t)w * h;
+
+    self->_profiler.flushStarted(w, h, lv_display_flush_is_last(disp));
+
+    // Completion arrives through _flush_complete(); LVGL waits in _flush_wait_cb()
+    const uint16_t* pixels = (const uint16_t*)px_map;
+    uint32_t stride = w;
+    if (self->_mode == DisplayBufferMode::DIRECT_SINGLE) {
+        // px_map is the whole screen buffer, as on the device
+        stride = self->_width;
+        pixels += (size_t)area->y1 * stride + area->x1;
+    }
+    self->_backend.flush(area->x1, area->y1, w, h, pixels, stride);
+}
+
+void SimDisplay::_flush_wait_cb(lv_display_t* disp) {
+    SimDisplay* self = static_cast<SimDisplay*>(lv_display_get_user_data(disp));
+    uint32_t start = micros();
+    self->_profiler.waitStarted();
+
+    std::unique_lock<std::mutex> lock(self->_done_mutex);
+    self->_done_cv.wait(lock, [self] { return self->_completed > 0; });
+    self->_completed--;
+    lock.unlock();
+    self->_profiler.waitFinished();
+
+    if (self->_in_refresh) {
+        self->_refresh_wait_us += micros() - start;
+    }
+}
+
+void SimDisplay::_flush_complete(void* context) {
+    SimDisplay* self = static_cast<SimDisplay*>(context);
+    self->_profiler.flushCompleted();
+    {
+        std::lock_guard<std::mutex> lock(self->_done_mutex);
+        self->_completed++;
+    }
+    self->_done_cv.notify_all();
+}
+
+void SimDisplay::_refresh_event_cb(lv_event_t* e) {
+    SimDisplay* self = static_cast<SimDisplay*>(lv_event_get_user_data(e));
+
+    if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+        self->_in_refresh = true;
+        self->_refresh_started_us = micros();
+        self->_refresh_started_ms = millis();
+        self->_refresh_wait_us = 0;
+        self->_refresh_areas = 0;
+        self->_refresh_pixels = 0;
+        return;
+    }
+
+    self->_in_refresh = false;
+    if (self->_refresh_areas == 0) {
+        return; // Nothing was invalidated, not a frame
+    }
+
+    FrameStats frame;
+    frame.index = (uint32_t)self->_frames.size();
+    frame.at_ms = self->_refresh_started_ms;
+    frame.flush_wait_us = self->_refresh_wait_us;
+    uint32_t elapsed_us = micros() - self->_refresh_started_us;
+    frame.render_us = elapsed_us > frame.flush_wait_us ? elapsed_us - frame.flush_wait_us : 0;
+    frame.dispatch_us = self->_dispatch_us;
+    self->_dispatch_us = 0;
+    frame.areas = self->_refresh_areas;
+    frame.pixels = self->_refresh_pixels;
+    self->_frames.push_back(frame);
+
+    if (self->_record_dir) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/frame_%05u.png", self->_record_dir, (unsigned int)frame.index);
+        self->savePng(path);
+    }
+}
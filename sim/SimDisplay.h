@@ -0,0 +1,109 @@
+#pragma once
+
+#include <lvgl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include "HostFlushBackend.h"
+#include "hardware/RenderProfiler.h"
+#include "hardware/DisplayBufferMode.h"
+#include "hardware/AdaptiveRefresh.h"
+
+/**
+ * @class SimDisplay
+ * @brief LVGL display for the host simulator, flushing into HostFlushBackend
+ *
+ * Set up like DisplayInterface on the device: draw buffers laid out per
+ * DisplayBufferMode, flushes handed to a backend that completes
+ * asynchronously, and a flush wait callback so LVGL only blocks when it needs
+ * a buffer back. Host memory has no PSRAM or DMA distinction, so the modes
+ * differ here only in buffer size and render mode.
+ *
+ * Each refresh that flushed anything is recorded as a frame: wall-clock
+ * render time (excluding time blocked on the emulated link), the number of
+ * flushed areas and the pixels they covered.
+ */
+class SimDisplay {
+public:
+    struct FrameStats {
+        uint32_t index;
+        uint32_t at_ms;          ///< millis() when the refresh started
+        uint32_t render_us;      ///< Refresh time minus flush waits
+        uint32_t flush_wait_us;  ///< Time LVGL spent waiting for the backend
+        uint32_t dispatch_us;    ///< UI queue work run since the previous frame, e.g. renderer apply()
+        uint32_t areas;
+        uint64_t pixels;
+    };
+
+    /**
+     * @param buffer_rows Rows per strip in STRIPS_INTERNAL mode
+     * @param spi_hz Emulated panel link speed, 0 for instant flushes
+     */
+    SimDisplay(uint16_t width, uint16_t height, uint16_t buffer_rows, uint32_t spi_hz,
+               DisplayBufferMode mode = defaultDisplayBufferMode());
+    ~SimDisplay();
+
+    /**
+     * @brief Create the LVGL display; lv_init() must already have run
+     */
+    bool begin();
+
+    /**
+     * @brief Write what the panel shows now, once in-flight transfers land
+     */
+    bool savePng(const char* path);
+
+    /**
+     * @brief Also write every frame as frame_NNNNN.png into a directory
+     * @param directory nullptr to stop
+     */
+    void recordFrames(const char* directory);
+
+    /**
+     * @brief Time spent running UI queue work, counted towards the next frame
+     */
+    void recordDispatch(uint32_t us) { _dispatch_us += us; }
+
+    const std::vector<FrameStats>& frames() const { return _frames; }
+    HostFlushBackend& backend() { return _backend; }
+    RenderProfiler& profiler() { return _profiler; }
+    AdaptiveRefresh& refresh() { return _refresh; }
+    DisplayBufferMode bufferMode() const { return _mode; }
+    size_t bufferBytes() const { return (_buf1.size() + _buf2.size()) * sizeof(lv_color_t); }
+
+private:
+    uint16_t _width;
+    uint16_t _height;
+    uint16_t _buffer_rows;
+    DisplayBufferMode _mode;
+    HostFlushBackend _backend;
+    RenderProfiler _profiler; ///< Same statistics as on the device, for the diagnostics card
+    AdaptiveRefresh _refresh;  ///< Same refresh policy as on the device
+    lv_display_t* _display;
+    std::vector<lv_color_t> _buf1;
+    std::vector<lv_color_t> _buf2; ///< Empty in DIRECT_SINGLE mode
+
+    // Completion handshake, like DisplayInterface's semaphore
+    std::mutex _done_mutex;
+    std::condition_variable _done_cv;
+    uint32_t _completed;
+
+    // Frame being refreshed
+    bool _in_refresh;
+    uint32_t _refresh_started_us;
+    uint32_t _refresh_started_ms;
+    uint32_t _refresh_wait_us;
+    uint32_t _refresh_areas;
+    uint64_t _refresh_pixels;
+    uint32_t _dispatch_us;     ///< UI queue work since the last frame
+
+    std::vector<FrameStats> _frames;
+    const char* _record_dir;
+
+    static void _flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map);
+    static void _flush_wait_cb(lv_display_t* disp);
+    static void _flush_complete(void* context);
+    static void _refresh_event_cb(lv_event_t* e);
+};
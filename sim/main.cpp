@@ -0,0 +1,424 @@
+/**
+ * DeskHog - Headless Simulator
+ * ============================
+ *
+ * Runs the real card UI (CardController, CardNavigationStack, every card and
+ * renderer) against LVGL on a workstation, with an in-memory display in place
+ * of the ST7789. A script drives it: configure cards, inject insight JSON
+ * through EventQueue, press buttons, and dump PNGs of the screen. Every
+ * frame's render time and flushed pixels go to frames.csv, with a summary at
+ * the end.
+ *
+ * See simulator-readme.md for the script format.
+ *
+ * Like main.cpp, keep this file to setup and the UI loop; the pieces live in
+ * SimDisplay, HostFlushBackend and the shims.
+ */
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ConfigManager.h"
+#include "EventQueue.h"
+#include "SimDisplay.h"
+#include "Style.h"
+#include "SystemController.h"
+#include "hardware/Input.h"
+#include "hardware/WifiInterface.h"
+#include "posthog/PostHogClient.h"
+#include "ui/CardController.h"
+
+// Same geometry as the device
+#define SCREEN_WIDTH 240
+#define SCREEN_HEIGHT 135
+#define LVGL_BUFFER_ROWS 27
+
+// Button timings, matching ButtonInterface
+#define TAP_MS 80
+#define LONG_PRESS_MS 600
+#define REPEAT_DELAY_MS 400
+#define REPEAT_INTERVAL_MS 150
+
+#define NUM_BUTTONS 3
+
+// The device's UI loop limits, see src/main.cpp
+#define UI_IDLE_MAX_MS 1000
+#define UI_CONTINUOUS_MS 5
+
+// Read directly by the games, as on the device
+Bounce2::Button buttons[NUM_BUTTONS];
+
+// Global objects
+EventQueue* eventQueue;
+ConfigManager* configManager;
+PostHogClient* posthogClient;
+WiFiInterface* wifiInterface;
+CardController* cardController;
+SimDisplay* simDisplay;
+
+struct Options {
+    std::string script = "sim/scripts/tour.txt";
+    std::string outDir = "sim_out";
+    uint32_t spiHz = 40000000;
+    DisplayBufferMode bufferMode = defaultDisplayBufferMode();
+    bool record = false;
+};
+
+// A scripted button being held down
+struct HeldButton {
+    bool held = false;
+    uint32_t pressedAt = 0;
+    uint32_t releaseAt = 0;
+    uint32_t nextRepeat = 0;
+    bool longPressSent = false;
+};
+
+static HeldButton heldButtons[NUM_BUTTONS];
+static uint32_t lastConfigProcessMs = 0;
+static uint32_t loopWakeups = 0;   ///< UI loop iterations, for the summary
+static uint32_t loopRunMs = 0;     ///< Time spent in runFor()
+
+static uint8_t pressedLevel(uint8_t button) {
+    return button == Input::BUTTON_DOWN ? LOW : HIGH;
+}
+
+static bool parseButton(const std::string& name, uint8_t& button) {
+    if (name == "up") button = Input::BUTTON_UP;
+    else if (name == "down") button = Input::BUTTON_DOWN;
+    else if (name == "center") button = Input::BUTTON_CENTER;
+    else return false;
+    return true;
+}
+
+// Start holding a button: drive its pin and deliver the press, like
+// ButtonInterface does once the edge has settled
+static void pressButton(uint8_t button, uint32_t holdMs) {
+    HeldButton& held = heldButtons[button];
+    uint32_t now = millis();
+    held.held = true;
+    held.pressedAt = now;
+    held.releaseAt = now + holdMs;
+    held.nextRepeat = now + REPEAT_DELAY_MS;
+    held.longPressSent = false;
+
+    simSetPinLevel(button, pressedLevel(button));
+    cardController->getCardStack()->handleButtonPress(button);
+}
+
+// Releases, long presses and auto-repeats that have come due
+static void serviceButtons() {
+    uint32_t now = millis();
+    for (uint8_t button = 0; button < NUM_BUTTONS; button++) {
+        HeldButton& held = heldButtons[button];
+        if (!held.held) continue;
+
+        if ((int32_t)(now - held.releaseAt) >= 0) {
+            held.held = false;
+            simReleasePin(button);
+            continue;
+        }
+        if (!held.longPressSent && now - held.pressedAt >= LONG_PRESS_MS) {
+            held.longPressSent = true;
+            cardController->getCardStack()->handleLongPress(button);
+        }
+        bool repeats = (button == Input::BUTTON_UP || button == Input::BUTTON_DOWN);
+        if (repeats && (int32_t)(now - held.nextRepeat) >= 0) {
+            held.nextRepeat = now + REPEAT_INTERVAL_MS;
+            cardController->getCardStack()->handleButtonPress(button);
+        }
+    }
+}
+
+// The device's lvglHandlerTask loop, run for a while
+static void runFor(uint32_t ms) {
+    uint32_t start = millis();
+    uint32_t until = start + ms;
+    do {
+        Input::update();
+        serviceButtons();
+
+        uint32_t dispatchStartUs = micros();
+        bool uiWorkPending = cardController->processUIQueue();
+        simDisplay->recordDispatch(micros() - dispatchStartUs);
+        bool continuous = cardController->isActiveCardContinuous();
+        simDisplay->refresh().setContinuousUpdates(continuous);
+
+        simDisplay->refresh().apply();
+        uint32_t lvglIdleMs = lv_timer_handler();
+        loopWakeups++;
+
+        // The portal task's job on the device
+        if (millis() - lastConfigProcessMs >= 100) {
+            configManager->process();
+            lastConfigProcessMs = millis();
+        }
+
+        // Sleep as the device does; scripted buttons are polled instead of
+        // notifying, so poll while one is held
+        bool buttonHeld = false;
+        for (const HeldButton& held : heldButtons) {
+            buttonHeld = buttonHeld || held.held;
+        }
+        uint32_t sleepMs = std::min<uint32_t>(lvglIdleMs, UI_IDLE_MAX_MS);
+        if (continuous || buttonHeld) {
+            sleepMs = std::min<uint32_t>(sleepMs, UI_CONTINUOUS_MS);
+        }
+        int32_t remaining = (int32_t)(until - millis());
+        sleepMs = std::min<uint32_t>(sleepMs, remaining > 0 ? (uint32_t)remaining : 0);
+        ulTaskNotifyTake(pdTRUE, uiWorkPending ? 1 : std::max<uint32_t>(sleepMs, 1));
+    } while ((int32_t)(millis() - until) < 0);
+    loopRunMs += millis() - start;
+}
+
+static bool readFile(const std::string& path, std::string& contents) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+static bool runCommand(const std::vector<std::string>& args, const Options& options) {
+    const std::string& command = args[0];
+
+    if (command == "wait" && args.size() == 2) {
+        runFor((uint32_t)strtoul(args[1].c_str(), nullptr, 10));
+        return true;
+    }
+
+    if ((command == "press" && args.size() == 2) || (command == "hold" && args.size() == 3)) {
+        uint8_t button;
+        if (!parseButton(args[1], button)) return false;
+        uint32_t holdMs = command == "hold" ? (uint32_t)strtoul(args[2].c_str(), nullptr, 10) : TAP_MS;
+        pressButton(button, holdMs);
+        runFor(holdMs + 20); // Let the release debounce
+        return true;
+    }
+
+    if (command == "cards") {
+        std::vector<CardConfig> configs;
+        for (size_t i = 1; i < args.size(); i++) {
+            std::string type = args[i];
+            std::string config;
+            size_t colon = type.find(':');
+            if (colon != std::string::npos) {
+                config = type.substr(colon + 1);
+                type = type.substr(0, colon);
+            }
+            configs.push_back(CardConfig(stringToCardType(type.c_str()), config.c_str(), (int)configs.size(), type.c_str()));
+        }
+        return configManager->saveCardConfigs(configs);
+    }
+
+    // What the portal's save actions do with their form fields
+    if (command == "save-wifi" && args.size() == 3) {
+        return configManager->saveWiFiCredentials(args[1].c_str(), args[2].c_str());
+    }
+
+    if (command == "save-device" && args.size() == 4) {
+        configManager->setTeamId(atoi(args[1].c_str()));
+        configManager->setApiKey(args[2].c_str());
+        configManager->setRegion(args[3].c_str());
+        return true;
+    }
+
+    if (command == "insight" && args.size() == 3) {
+        std::string json;
+        if (!readFile(args[2], json)) {
+            Serial.printf("[Sim] Can't read %s\n", args[2].c_str());
+            return false;
+        }
+        return eventQueue->publishEvent(EventType::INSIGHT_DATA_RECEIVED, args[1].c_str(), String(json.c_str()));
+    }
+
+    if (command == "wifi" && args.size() == 2) {
+        EventType type;
+        if (args[1] == "connecting") type = EventType::WIFI_CONNECTING;
+        else if (args[1] == "connected") type = EventType::WIFI_CONNECTED;
+        else if (args[1] == "failed") type = EventType::WIFI_CONNECTION_FAILED;
+        else if (args[1] == "ap") type = EventType::WIFI_AP_STARTED;
+        else return false;
+        return eventQueue->publishEvent(type, "");
+    }
+
+    if (command == "snap" && args.size() == 2) {
+        std::string path = options.outDir + "/" + args[1] + ".png";
+        if (!simDisplay->savePng(path.c_str())) return false;
+        Serial.printf("[Sim] Wrote %s\n", path.c_str());
+        return true;
+    }
+
+    return false;
+}
+
+static bool runScript(const Options& options) {
+    std::ifstream script(options.script);
+    if (!script) {
+        Serial.printf("[Sim] Can't open script %s\n", options.script.c_str());
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(script, line)) {
+        lineNumber++;
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+
+        std::istringstream words(line);
+        std::vector<std::string> args;
+        std::string word;
+        while (words >> word) args.push_back(word);
+        if (args.empty()) continue;
+
+        if (!runCommand(args, options)) {
+            Serial.printf("[Sim] %s:%d: can't run '%s'\n", options.script.c_str(), lineNumber, line.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+static void reportFrames(const Options& options) {
+    const std::vector<SimDisplay::FrameStats>& frames = simDisplay->frames();
+
+    std::string csvPath = options.outDir + "/frames.csv";
+    FILE* csv = fopen(csvPath.c_str(), "w");
+    if (csv) {
+        fprintf(csv, "frame,time_ms,render_us,flush_wait_us,dispatch_us,areas,pixels\n");
+        for (const SimDisplay::FrameStats& frame : frames) {
+            fprintf(csv, "%u,%u,%u,%u,%u,%u,%llu\n", frame.index, frame.at_ms, frame.render_us,
+                    frame.flush_wait_us, frame.dispatch_us, frame.areas, (unsigned long long)frame.pixels);
+        }
+        fclose(csv);
+    }
+
+    if (frames.empty()) {
+        Serial.println("[Sim] No frames rendered");
+        return;
+    }
+
+    std::vector<uint32_t> render;
+    uint64_t renderTotal = 0;
+    uint64_t waitTotal = 0;
+    uint64_t pixelsTotal = 0;
+    uint64_t dispatchTotal = 0;
+    uint32_t dispatchMax = 0;
+    for (const SimDisplay::FrameStats& frame : frames) {
+        render.push_back(frame.render_us);
+        renderTotal += frame.render_us;
+        waitTotal += frame.flush_wait_us;
+        pixelsTotal += frame.pixels;
+        dispatchTotal += frame.dispatch_us;
+        dispatchMax = std::max(dispatchMax, frame.dispatch_us);
+    }
+    std::sort(render.begin(), render.end());
+
+    Serial.printf("[Sim] %u frames: render mean %llu us, p50 %u us, p95 %u us, max %u us\n",
+                  (unsigned int)frames.size(), (unsigned long long)(renderTotal / frames.size()),
+                  render[render.size() / 2], render[render.size() * 95 / 100], render.back());
+    Serial.printf("[Sim] UI queue work: mean %llu us per frame, max %u us\n",
+                  (unsigned long long)(dispatchTotal / frames.size()), dispatchMax);
+    Serial.printf("[Sim] Flushed %llu pixels (%llu per frame, full screen is %u), waited %llu us on the link\n",
+                  (unsigned long long)pixelsTotal, (unsigned long long)(pixelsTotal / frames.size()),
+                  SCREEN_WIDTH * SCREEN_HEIGHT, (unsigned long long)waitTotal);
+    Serial.printf("[Sim] Emulated link busy %llu us at %u Hz; per-frame detail in %s\n",
+                  (unsigned long long)simDisplay->backend().busyMicros(), options.spiHz, csvPath.c_str());
+    Serial.printf("[Sim] Buffers %s, %u bytes\n",
+                  displayBufferModeToString(simDisplay->bufferMode()), (unsigned int)simDisplay->bufferBytes());
+    Serial.printf("[Sim] UI loop woke %u times in %u ms (%u per second)\n",
+                  loopWakeups, loopRunMs, loopRunMs ? (unsigned int)((uint64_t)loopWakeups * 1000 / loopRunMs) : 0);
+}
+
+static void usage(const char* program) {
+    printf("Usage: %s [--script FILE] [--out DIR] [--spi-hz HZ] [--buffer-mode MODE] [--record]\n"
+           "  --script  Script to run (default sim/scripts/tour.txt)\n"
+           "  --out     Directory for PNGs and frames.csv (default sim_out)\n"
+           "  --spi-hz  Emulated panel link speed, 0 for instant (default 40000000)\n"
+           "  --buffer-mode  FULL_PSRAM, STRIPS_INTERNAL or DIRECT_SINGLE (default: build default)\n"
+           "  --record  Also write every frame as a PNG\n", program);
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--script" && i + 1 < argc) options.script = argv[++i];
+        else if (arg == "--out" && i + 1 < argc) options.outDir = argv[++i];
+        else if (arg == "--spi-hz" && i + 1 < argc) options.spiHz = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--buffer-mode" && i + 1 < argc) {
+            if (!stringToDisplayBufferMode(argv[++i], options.bufferMode)) {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        else if (arg == "--record") options.record = true;
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    mkdir(options.outDir.c_str(), 0755);
+
+    SystemController::begin();
+    Style::init();
+
+    eventQueue = new EventQueue(20);
+    eventQueue->begin();
+
+    configManager = new ConfigManager(*eventQueue);
+    configManager->begin();
+
+    posthogClient = new PostHogClient(*configManager, *eventQueue);
+    wifiInterface = new WiFiInterface(*configManager, *eventQueue);
+
+    lv_init();
+    lv_tick_set_cb([]() -> uint32_t { return (uint32_t)millis(); });
+
+    simDisplay = new SimDisplay(SCREEN_WIDTH, SCREEN_HEIGHT, LVGL_BUFFER_ROWS, options.spiHz, options.bufferMode);
+    if (!simDisplay->begin()) {
+        return 1;
+    }
+    if (options.record) {
+        simDisplay->recordFrames(options.outDir.c_str());
+    }
+
+    // This thread plays the LVGL task
+    claimUIThread();
+    Input::configureButtons();
+
+    cardController = new CardController(
+        lv_screen_active(),
+        SCREEN_WIDTH,
+        SCREEN_HEIGHT,
+        *configManager,
+        *wifiInterface,
+        *posthogClient,
+        *eventQueue
+    );
+    cardController->setRenderProfiler(&simDisplay->profiler());
+    cardController->initialize(nullptr);
+
+    SystemController::setSystemState(SystemState::SYS_READY);
+    runFor(100);
+
+    bool ok = runScript(options);
+    runFor(100);
+    reportFrames(options);
+
+    // Whatever a clean shutdown would still write
+    configManager->flush();
+    Serial.printf("[Sim] %u NVS writes (%u counted by ConfigManager)\n",
+                  Preferences::writeCount(), configManager->getFlashWriteCount());
+
+    // Background tasks are detached threads; just leave
+    fflush(stdout);
+    _exit(ok ? 0 : 1);
+}
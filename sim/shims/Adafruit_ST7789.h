@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#define ST77XX_BLACK 0x0000
+
+/**
+ * @class Adafruit_ST7789
+ * @brief Type only, so headers that mention the panel compile on the host
+ *
+ * The simulator draws through its own LVGL display and never creates one.
+ */
+class Adafruit_ST7789 {
+public:
+    Adafruit_ST7789(SPIClass* spi, int8_t cs, int8_t dc, int8_t rst) {
+        (void)spi;
+        (void)cs;
+        (void)dc;
+        (void)rst;
+    }
+    void init(uint16_t width, uint16_t height) { (void)width; (void)height; }
+    void setRotation(uint8_t rotation) { (void)rotation; }
+    void fillScreen(uint16_t color) { (void)color; }
+    void startWrite() {}
+    void endWrite() {}
+    void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) { (void)x; (void)y; (void)w; (void)h; }
+    void writePixels(uint16_t* colors, uint32_t len) { (void)colors; (void)len; }
+};
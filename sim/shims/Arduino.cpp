@@ -0,0 +1,103 @@
+#include "Arduino.h"
+#include <stdarg.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+static const auto s_start = std::chrono::steady_clock::now();
+
+// Pins the simulator drives, and the pulls configured by pinMode()
+static constexpr int NUM_PINS = 64;
+static std::atomic<int> s_driven[NUM_PINS];
+static std::atomic<int> s_pull[NUM_PINS];
+static bool s_pins_ready = false;
+
+static void initPins() {
+    if (s_pins_ready) return;
+    for (int i = 0; i < NUM_PINS; i++) {
+        s_driven[i] = -1;
+        s_pull[i] = LOW;
+    }
+    s_pins_ready = true;
+}
+
+unsigned long millis() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - s_start).count();
+}
+
+unsigned long micros() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - s_start).count();
+}
+
+void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+long random(long max) {
+    return max > 0 ? rand() % max : 0;
+}
+
+long random(long min, long max) {
+    return max > min ? min + random(max - min) : min;
+}
+
+void randomSeed(unsigned long seed) {
+    srand((unsigned int)seed);
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    if (in_max == in_min) return out_min;
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    initPins();
+    if (pin >= NUM_PINS) return;
+    s_pull[pin] = (mode == INPUT_PULLUP) ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+    initPins();
+    if (pin >= NUM_PINS) return LOW;
+    int driven = s_driven[pin];
+    return driven >= 0 ? driven : (int)s_pull[pin];
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    simSetPinLevel(pin, value);
+}
+
+void simSetPinLevel(uint8_t pin, int level) {
+    initPins();
+    if (pin < NUM_PINS) s_driven[pin] = level ? HIGH : LOW;
+}
+
+void simReleasePin(uint8_t pin) {
+    initPins();
+    if (pin < NUM_PINS) s_driven[pin] = -1;
+}
+
+bool psramFound() {
+    return true;
+}
+
+int HardwareSerial::printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = vprintf(format, args);
+    va_end(args);
+    return n;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+/**
+ * Host stand-in for the parts of the Arduino-ESP32 core the UI code uses.
+ *
+ * Time is wall-clock since start-up, pins are whatever the simulator drives
+ * them to, and Serial goes to stdout. Nothing here talks to hardware.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <cmath>
+#include "WString.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+
+using std::abs;
+using std::isinf;
+using std::isnan;
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT          0x01
+#define OUTPUT         0x03
+#define INPUT_PULLUP   0x05
+#define INPUT_PULLDOWN 0x09
+
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+#define sq(x) ((x) * (x))
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define EXT_RAM_ATTR
+#define ARDUINO_ISR_ATTR
+#define PROGMEM
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+
+bool psramFound();
+
+/**
+ * @brief Drive an input pin from the simulator, e.g. to press a button
+ */
+void simSetPinLevel(uint8_t pin, int level);
+
+/**
+ * @brief Stop driving a pin so it falls back to its pull-up or pull-down
+ */
+void simReleasePin(uint8_t pin);
+
+/**
+ * @class IPAddress
+ * @brief Dotted-quad address, enough for display and logging
+ */
+class IPAddress {
+public:
+    IPAddress() : _bytes{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _bytes{a, b, c, d} {}
+    uint8_t operator[](int index) const { return _bytes[index & 3]; }
+    bool operator==(const IPAddress& other) const { return memcmp(_bytes, other._bytes, 4) == 0; }
+    String toString() const {
+        char buffer[16];
+        snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", _bytes[0], _bytes[1], _bytes[2], _bytes[3]);
+        return String(buffer);
+    }
+
+private:
+    uint8_t _bytes[4];
+};
+
+/**
+ * @class HardwareSerial
+ * @brief Serial port that writes to stdout
+ */
+class HardwareSerial {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void flush() { fflush(stdout); }
+    int printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    size_t print(const char* str) { return fputs(str ? str : "", stdout) >= 0 ? strlen(str ? str : "") : 0; }
+    size_t print(const String& str) { return print(str.c_str()); }
+    size_t print(char c) { return fputc(c, stdout) != EOF ? 1 : 0; }
+    size_t print(const IPAddress& ip) { return print(ip.toString()); }
+    template <typename T>
+    size_t print(T value, int base = DEC) { return print(String(value, base)); }
+    size_t print(float value, int decimals = 2) { return print(String(value, (unsigned int)decimals)); }
+    size_t print(double value, int decimals = 2) { return print(String(value, (unsigned int)decimals)); }
+
+    size_t println() { return print("\n"); }
+    template <typename T>
+    size_t println(const T& value) { size_t n = print(value); return n + println(); }
+    template <typename T>
+    size_t println(const T& value, int format) { size_t n = print(value, format); return n + println(); }
+};
+
+extern HardwareSerial Serial;
+
+/**
+ * @class EspClass
+ * @brief Memory figures for logs; the host reports fixed, generous numbers
+ */
+class EspClass {
+public:
+    uint32_t getFreeHeap() const { return 256 * 1024; }
+    uint32_t getHeapSize() const { return 320 * 1024; }
+    uint32_t getPsramSize() const { return 2 * 1024 * 1024; }
+    uint32_t getFreePsram() const { return 2 * 1024 * 1024; }
+};
+
+extern EspClass ESP;
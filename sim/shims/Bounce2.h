@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Host stand-in for the Bounce2 button API the firmware uses, reading the
+ * pins the simulator drives through digitalRead().
+ */
+namespace Bounce2 {
+
+class Button {
+public:
+    void attach(int pin, int mode) {
+        _pin = (uint8_t)pin;
+        pinMode(_pin, (uint8_t)mode);
+        _stable = digitalRead(_pin);
+        _raw = _stable;
+        _changed_at = millis();
+    }
+    void interval(uint16_t ms) { _interval_ms = ms; }
+    void setPressedState(bool state) { _pressed_state = state; }
+
+    bool update() {
+        _changed = false;
+        int level = digitalRead(_pin);
+        unsigned long now = millis();
+        if (level != _raw) {
+            _raw = level;
+            _changed_at = now;
+        } else if (level != _stable && now - _changed_at >= _interval_ms) {
+            _stable = level;
+            _changed = true;
+        }
+        return _changed;
+    }
+
+    int read() const { return _stable; }
+    bool isPressed() const { return _stable == (int)_pressed_state; }
+    bool pressed() const { return _changed && isPressed(); }
+    bool released() const { return _changed && !isPressed(); }
+    bool changed() const { return _changed; }
+
+private:
+    uint8_t _pin = 0;
+    uint16_t _interval_ms = 10;
+    bool _pressed_state = LOW;
+    int _stable = LOW;
+    int _raw = LOW;
+    unsigned long _changed_at = 0;
+    bool _changed = false;
+};
+
+}  // namespace Bounce2
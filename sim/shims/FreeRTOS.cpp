@@ -0,0 +1,292 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+unsigned long millis();
+
+struct SimTask {
+    std::string name;
+    std::mutex mutex;
+    std::condition_variable cv;
+    uint32_t notify_count = 0;
+};
+
+struct SimQueue {
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t item_size;
+    size_t length;
+    std::deque<std::vector<uint8_t>> items;
+};
+
+struct SimSemaphore {
+    std::mutex mutex;
+    std::condition_variable cv;
+    UBaseType_t count;
+    UBaseType_t max_count;
+    bool recursive = false;
+    SimTask* holder = nullptr;
+    UBaseType_t depth = 0;
+};
+
+// Thrown by vTaskDelete(nullptr) to unwind out of the task function
+struct SimTaskExit {};
+
+static thread_local SimTask* t_current = nullptr;
+
+// Waits on cv until ready() or the tick timeout runs out
+template <typename Ready>
+static bool waitFor(std::condition_variable& cv, std::unique_lock<std::mutex>& lock,
+                    TickType_t ticks, Ready ready) {
+    if (ticks == portMAX_DELAY) {
+        cv.wait(lock, ready);
+        return true;
+    }
+    return cv.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+BaseType_t xPortGetCoreID() {
+    return 0;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack_depth,
+                       void* parameter, UBaseType_t priority, TaskHandle_t* handle) {
+    return xTaskCreatePinnedToCore(function, name, stack_depth, parameter, priority, handle, tskNO_AFFINITY);
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stack_depth,
+                                   void* parameter, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t core) {
+    (void)stack_depth;
+    (void)priority;
+    (void)core;
+
+    SimTask* task = new SimTask();
+    task->name = name ? name : "task";
+    if (handle) {
+        *handle = task;
+    }
+
+    // Tasks are never joined, and their handles live for the whole run
+    std::thread([task, function, parameter]() {
+        t_current = task;
+        try {
+            function(parameter);
+        } catch (const SimTaskExit&) {
+        }
+    }).detach();
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if (task == nullptr || task == t_current) {
+        throw SimTaskExit();
+    }
+}
+
+void vTaskDelay(TickType_t ticks) {
+    if (ticks == 0) {
+        std::this_thread::yield();
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+TickType_t xTaskGetTickCount() {
+    return (TickType_t)millis();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    if (!t_current) {
+        // Threads not started through xTaskCreate, i.e. the simulator's main thread
+        t_current = new SimTask();
+        t_current->name = "main";
+    }
+    return t_current;
+}
+
+char* pcTaskGetName(TaskHandle_t task) {
+    if (!task) task = xTaskGetCurrentTaskHandle();
+    return const_cast<char*>(task->name.c_str());
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks) {
+    SimTask* task = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(task->mutex);
+    waitFor(task->cv, lock, ticks, [task] { return task->notify_count > 0; });
+    uint32_t count = task->notify_count;
+    if (count > 0) {
+        task->notify_count = clear_on_exit ? 0 : count - 1;
+    }
+    return count;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    if (!task) return pdFAIL;
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->notify_count++;
+    }
+    task->cv.notify_all();
+    return pdPASS;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    SimQueue* queue = new SimQueue();
+    queue->length = length;
+    queue->item_size = item_size;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+static BaseType_t queueSend(QueueHandle_t queue, const void* item, TickType_t ticks, bool to_front) {
+    if (!queue) return pdFAIL;
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(queue->cv, lock, ticks, [queue] { return queue->items.size() < queue->length; })) {
+        return pdFAIL;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(item);
+    std::vector<uint8_t> copy(bytes, bytes + queue->item_size);
+    if (to_front) {
+        queue->items.push_front(std::move(copy));
+    } else {
+        queue->items.push_back(std::move(copy));
+    }
+    lock.unlock();
+    queue->cv.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    return queueSend(queue, item, ticks, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void* item, TickType_t ticks) {
+    return queueSend(queue, item, ticks, true);
+}
+
+static BaseType_t queueReceive(QueueHandle_t queue, void* item, TickType_t ticks, bool remove) {
+    if (!queue) return pdFAIL;
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (!waitFor(queue->cv, lock, ticks, [queue] { return !queue->items.empty(); })) {
+        return pdFAIL;
+    }
+    memcpy(item, queue->items.front().data(), queue->item_size);
+    if (remove) {
+        queue->items.pop_front();
+        lock.unlock();
+        queue->cv.notify_all();
+    }
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks) {
+    return queueReceive(queue, item, ticks, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticks) {
+    return queueReceive(queue, item, ticks, false);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    if (!queue) return 0;
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    return (UBaseType_t)queue->items.size();
+}
+
+static SemaphoreHandle_t createSemaphore(UBaseType_t max_count, UBaseType_t initial_count, bool recursive) {
+    SimSemaphore* semaphore = new SimSemaphore();
+    semaphore->max_count = max_count;
+    semaphore->count = initial_count;
+    semaphore->recursive = recursive;
+    return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return createSemaphore(1, 1, false);
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() {
+    return createSemaphore(1, 1, true);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return createSemaphore(1, 0, false);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count, UBaseType_t initial_count) {
+    return createSemaphore(max_count, initial_count, false);
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    if (!semaphore) return pdFAIL;
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    if (!waitFor(semaphore->cv, lock, ticks, [semaphore] { return semaphore->count > 0; })) {
+        return pdFAIL;
+    }
+    semaphore->count--;
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    if (!semaphore) return pdFAIL;
+    {
+        std::lock_guard<std::mutex> lock(semaphore->mutex);
+        if (semaphore->count >= semaphore->max_count) {
+            return pdFAIL;
+        }
+        semaphore->count++;
+    }
+    semaphore->cv.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    if (!semaphore) return pdFAIL;
+    SimTask* self = xTaskGetCurrentTaskHandle();
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    if (semaphore->holder == self) {
+        semaphore->depth++;
+        return pdPASS;
+    }
+    if (!waitFor(semaphore->cv, lock, ticks, [semaphore] { return semaphore->count > 0; })) {
+        return pdFAIL;
+    }
+    semaphore->count--;
+    semaphore->holder = self;
+    semaphore->depth = 1;
+    return pdPASS;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t semaphore) {
+    if (!semaphore) return pdFAIL;
+    {
+        std::lock_guard<std::mutex> lock(semaphore->mutex);
+        if (semaphore->holder != xTaskGetCurrentTaskHandle() || semaphore->depth == 0) {
+            return pdFAIL;
+        }
+        if (--semaphore->depth > 0) {
+            return pdPASS;
+        }
+        semaphore->holder = nullptr;
+        semaphore->count++;
+    }
+    semaphore->cv.notify_all();
+    return pdPASS;
+}
@@ -0,0 +1,6 @@
+#include <SPI.h>
+#include <WiFi.h>
+
+// Library singletons the device core would provide
+WiFiClass WiFi;
+SPIClass SPI;
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Arduino.h>
+#include "WiFiClientSecure.h"
+
+#define HTTP_CODE_OK 200
+#define HTTPC_ERROR_CONNECTION_REFUSED (-1)
+
+/**
+ * @class HTTPClient
+ * @brief Offline HTTP client; every request fails to connect
+ *
+ * The simulator feeds insight JSON through EventQueue instead of the network.
+ */
+class HTTPClient {
+public:
+    bool begin(WiFiClientSecure& client, const String& url) { (void)client; (void)url; return true; }
+    bool begin(const String& url) { (void)url; return true; }
+    void end() {}
+    void setReuse(bool reuse) { (void)reuse; }
+    void setTimeout(uint16_t timeout) { (void)timeout; }
+    void addHeader(const String& name, const String& value) { (void)name; (void)value; }
+    int GET() { return HTTPC_ERROR_CONNECTION_REFUSED; }
+    int getSize() { return -1; }
+    String getString() { return String(); }
+    static String errorToString(int error) { (void)error; return String("connection refused (simulator)"); }
+};
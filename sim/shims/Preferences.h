@@ -0,0 +1,125 @@
+#pragma once
+
+#include <Arduino.h>
+#include <map>
+#include <mutex>
+#include <string>
+
+/**
+ * @class Preferences
+ * @brief In-memory NVS stand-in; namespaces are shared by all instances
+ *
+ * Nothing survives the process, so every simulator run starts as a freshly
+ * erased device. Writes are counted so flash traffic can be compared.
+ */
+class Preferences {
+public:
+    bool begin(const char* name, bool read_only = false) {
+        _namespace = name ? name : "";
+        _read_only = read_only;
+        _open = true;
+        return true;
+    }
+
+    void end() { _open = false; }
+
+    bool isKey(const char* key) {
+        std::lock_guard<std::mutex> lock(_mutex());
+        return _store().count(_key(key)) > 0;
+    }
+
+    bool remove(const char* key) {
+        if (!_writable()) return false;
+        std::lock_guard<std::mutex> lock(_mutex());
+        _writes()++;
+        return _store().erase(_key(key)) > 0;
+    }
+
+    bool clear() {
+        if (!_writable()) return false;
+        std::lock_guard<std::mutex> lock(_mutex());
+        std::string prefix = _namespace + "/";
+        for (auto it = _store().begin(); it != _store().end();) {
+            if (it->first.compare(0, prefix.length(), prefix) == 0) {
+                it = _store().erase(it);
+            } else {
+                ++it;
+            }
+        }
+        _writes()++;
+        return true;
+    }
+
+    size_t putString(const char* key, const String& value) { return _put(key, value.c_str()) ? value.length() : 0; }
+    size_t putString(const char* key, const char* value) { return putString(key, String(value)); }
+    size_t putBool(const char* key, bool value) { return _put(key, value ? "1" : "0") ? 1 : 0; }
+    size_t putInt(const char* key, int32_t value) { return _put(key, String(value).c_str()) ? 4 : 0; }
+    size_t putUInt(const char* key, uint32_t value) { return _put(key, String(value).c_str()) ? 4 : 0; }
+    size_t putUChar(const char* key, uint8_t value) { return _put(key, String(value).c_str()) ? 1 : 0; }
+
+    String getString(const char* key, const String& default_value = String()) {
+        std::string value;
+        return _get(key, value) ? String(value.c_str()) : default_value;
+    }
+    bool getBool(const char* key, bool default_value = false) {
+        std::string value;
+        return _get(key, value) ? value == "1" : default_value;
+    }
+    int32_t getInt(const char* key, int32_t default_value = 0) {
+        std::string value;
+        return _get(key, value) ? (int32_t)strtol(value.c_str(), nullptr, 10) : default_value;
+    }
+    uint32_t getUInt(const char* key, uint32_t default_value = 0) {
+        std::string value;
+        return _get(key, value) ? (uint32_t)strtoul(value.c_str(), nullptr, 10) : default_value;
+    }
+    uint8_t getUChar(const char* key, uint8_t default_value = 0) {
+        std::string value;
+        return _get(key, value) ? (uint8_t)strtoul(value.c_str(), nullptr, 10) : default_value;
+    }
+
+    /**
+     * @brief Writes and removals across every namespace since start-up
+     */
+    static uint32_t writeCount() {
+        std::lock_guard<std::mutex> lock(_mutex());
+        return _writes();
+    }
+
+private:
+    std::string _namespace;
+    bool _read_only = false;
+    bool _open = false;
+
+    static std::map<std::string, std::string>& _store() {
+        static std::map<std::string, std::string> store;
+        return store;
+    }
+    static std::mutex& _mutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+    static uint32_t& _writes() {
+        static uint32_t writes = 0;
+        return writes;
+    }
+
+    std::string _key(const char* key) const { return _namespace + "/" + (key ? key : ""); }
+    bool _writable() const { return _open && !_read_only; }
+
+    bool _put(const char* key, const char* value) {
+        if (!_writable()) return false;
+        std::lock_guard<std::mutex> lock(_mutex());
+        _store()[_key(key)] = value;
+        _writes()++;
+        return true;
+    }
+
+    bool _get(const char* key, std::string& value) {
+        std::lock_guard<std::mutex> lock(_mutex());
+        auto it = _store().find(_key(key));
+        if (it == _store().end()) return false;
+        value = it->second;
+        return true;
+    }
+};
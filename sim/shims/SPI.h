@@ -0,0 +1,11 @@
+#pragma once
+
+#include <Arduino.h>
+
+class SPIClass {
+public:
+    void begin() {}
+    void end() {}
+};
+
+extern SPIClass SPI;
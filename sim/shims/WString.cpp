@@ -0,0 +1,91 @@
+#include "WString.h"
+#include <algorithm>
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+bool String::equalsIgnoreCase(const String& other) const {
+    if (_str.length() != other._str.length()) return false;
+    for (size_t i = 0; i < _str.length(); i++) {
+        if (tolower((unsigned char)_str[i]) != tolower((unsigned char)other._str[i])) return false;
+    }
+    return true;
+}
+
+bool String::endsWith(const String& suffix) const {
+    if (suffix._str.length() > _str.length()) return false;
+    return _str.compare(_str.length() - suffix._str.length(), suffix._str.length(), suffix._str) == 0;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= _str.length()) return String();
+    if (to > _str.length()) to = (unsigned int)_str.length();
+    return String(_str.substr(from, to - from));
+}
+
+void String::replace(char find, char replacement) {
+    std::replace(_str.begin(), _str.end(), find, replacement);
+}
+
+void String::replace(const String& find, const String& replacement) {
+    if (find._str.empty()) return;
+    size_t pos = 0;
+    while ((pos = _str.find(find._str, pos)) != std::string::npos) {
+        _str.replace(pos, find._str.length(), replacement._str);
+        pos += replacement._str.length();
+    }
+}
+
+void String::toLowerCase() {
+    for (char& c : _str) c = (char)tolower((unsigned char)c);
+}
+
+void String::toUpperCase() {
+    for (char& c : _str) c = (char)toupper((unsigned char)c);
+}
+
+void String::trim() {
+    size_t start = 0;
+    while (start < _str.length() && isspace((unsigned char)_str[start])) start++;
+    size_t end = _str.length();
+    while (end > start && isspace((unsigned char)_str[end - 1])) end--;
+    _str = _str.substr(start, end - start);
+}
+
+void String::toCharArray(char* buffer, unsigned int size, unsigned int index) const {
+    if (!buffer || size == 0) return;
+    if (index >= _str.length()) {
+        buffer[0] = 0;
+        return;
+    }
+    size_t n = std::min((size_t)size - 1, _str.length() - index);
+    memcpy(buffer, _str.data() + index, n);
+    buffer[n] = 0;
+}
+
+std::string String::_format_unsigned(unsigned long long value, unsigned char base) {
+    if (base < 2 || base > 16) base = DEC;
+    char digits[65];
+    int i = 64;
+    digits[i] = 0;
+    do {
+        int d = (int)(value % base);
+        digits[--i] = (char)(d < 10 ? '0' + d : 'a' + d - 10);
+        value /= base;
+    } while (value);
+    return std::string(&digits[i]);
+}
+
+std::string String::_format_signed(long long value, unsigned char base) {
+    if (base == DEC && value < 0) {
+        return "-" + _format_unsigned((unsigned long long)(-(value + 1)) + 1, base);
+    }
+    return _format_unsigned((unsigned long long)value, base);
+}
+
+std::string String::_format_float(double value, unsigned int decimals) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", (int)decimals, value);
+    return std::string(buffer);
+}
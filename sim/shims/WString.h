@@ -0,0 +1,122 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+/**
+ * @class String
+ * @brief Host stand-in for the Arduino String, backed by std::string
+ *
+ * Covers the part of the Arduino API the firmware uses. Unlike the device
+ * String it is not safe to copy bitwise, so it must never be memcpy'd
+ * through a FreeRTOS queue.
+ */
+class String {
+public:
+    String() {}
+    String(const char* str) : _str(str ? str : "") {}
+    String(const std::string& str) : _str(str) {}
+    String(char c) : _str(1, c) {}
+    String(unsigned char value, unsigned char base = DEC) : _str(_format_unsigned(value, base)) {}
+    String(int value, unsigned char base = DEC) : _str(_format_signed(value, base)) {}
+    String(unsigned int value, unsigned char base = DEC) : _str(_format_unsigned(value, base)) {}
+    String(long value, unsigned char base = DEC) : _str(_format_signed(value, base)) {}
+    String(unsigned long value, unsigned char base = DEC) : _str(_format_unsigned(value, base)) {}
+    String(long long value, unsigned char base = DEC) : _str(_format_signed(value, base)) {}
+    String(unsigned long long value, unsigned char base = DEC) : _str(_format_unsigned(value, base)) {}
+    String(float value, unsigned int decimals = 2) : _str(_format_float(value, decimals)) {}
+    String(double value, unsigned int decimals = 2) : _str(_format_float(value, decimals)) {}
+
+    const char* c_str() const { return _str.c_str(); }
+    unsigned int length() const { return (unsigned int)_str.length(); }
+    bool isEmpty() const { return _str.empty(); }
+    bool reserve(unsigned int size) { _str.reserve(size); return true; }
+
+    char charAt(unsigned int index) const { return index < _str.length() ? _str[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char& operator[](unsigned int index) { return _str[index]; }
+    void setCharAt(unsigned int index, char c) { if (index < _str.length()) _str[index] = c; }
+
+    bool concat(const String& other) { _str += other._str; return true; }
+    bool concat(const char* str) { if (str) _str += str; return true; }
+    bool concat(const char* str, unsigned int length) { if (str) _str.append(str, length); return true; }
+    bool concat(char c) { _str += c; return true; }
+    template <typename T>
+    bool concat(T value) { return concat(String(value)); }
+
+    String& operator+=(const String& other) { concat(other); return *this; }
+    String& operator+=(const char* str) { concat(str); return *this; }
+    String& operator+=(char c) { concat(c); return *this; }
+    template <typename T>
+    String& operator+=(T value) { concat(String(value)); return *this; }
+
+    int compareTo(const String& other) const { return _str.compare(other._str); }
+    bool equals(const String& other) const { return _str == other._str; }
+    bool equals(const char* str) const { return _str == (str ? str : ""); }
+    bool equalsIgnoreCase(const String& other) const;
+    bool startsWith(const String& prefix) const { return _str.compare(0, prefix._str.length(), prefix._str) == 0; }
+    bool endsWith(const String& suffix) const;
+
+    int indexOf(char c, unsigned int from = 0) const { return _npos_to_int(_str.find(c, from)); }
+    int indexOf(const String& str, unsigned int from = 0) const { return _npos_to_int(_str.find(str._str, from)); }
+    int lastIndexOf(char c) const { return _npos_to_int(_str.rfind(c)); }
+    int lastIndexOf(const String& str) const { return _npos_to_int(_str.rfind(str._str)); }
+
+    String substring(unsigned int from) const { return from < _str.length() ? String(_str.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const;
+
+    void replace(char find, char replacement);
+    void replace(const String& find, const String& replacement);
+    void remove(unsigned int index) { if (index < _str.length()) _str.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < _str.length()) _str.erase(index, count); }
+    void toLowerCase();
+    void toUpperCase();
+    void trim();
+
+    long toInt() const { return strtol(_str.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(_str.c_str(), nullptr); }
+    double toDouble() const { return strtod(_str.c_str(), nullptr); }
+
+    void toCharArray(char* buffer, unsigned int size, unsigned int index = 0) const;
+
+    const std::string& std() const { return _str; }
+
+    friend bool operator==(const String& a, const String& b) { return a._str == b._str; }
+    friend bool operator==(const String& a, const char* b) { return a.equals(b); }
+    friend bool operator==(const char* a, const String& b) { return b.equals(a); }
+    friend bool operator!=(const String& a, const String& b) { return !(a == b); }
+    friend bool operator!=(const String& a, const char* b) { return !(a == b); }
+    friend bool operator!=(const char* a, const String& b) { return !(b == a); }
+    friend bool operator<(const String& a, const String& b) { return a._str < b._str; }
+    friend bool operator>(const String& a, const String& b) { return a._str > b._str; }
+    friend bool operator<=(const String& a, const String& b) { return a._str <= b._str; }
+    friend bool operator>=(const String& a, const String& b) { return a._str >= b._str; }
+
+    friend String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+    friend String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+    friend String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+    friend String operator+(const String& a, char b) { String r(a); r += b; return r; }
+    template <typename T>
+    friend String operator+(const String& a, T b) { String r(a); r += String(b); return r; }
+
+private:
+    std::string _str;
+
+    static int _npos_to_int(size_t pos) { return pos == std::string::npos ? -1 : (int)pos; }
+    static std::string _format_unsigned(unsigned long long value, unsigned char base);
+    static std::string _format_signed(long long value, unsigned char base);
+    static std::string _format_float(double value, unsigned int decimals);
+};
+
+namespace std {
+template <>
+struct hash<String> {
+    size_t operator()(const String& s) const { return hash<std::string>()(s.std()); }
+};
+}
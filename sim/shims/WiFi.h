@@ -0,0 +1,112 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Host stand-in for the ESP32 WiFi library: a radio that never associates.
+ *
+ * The simulator drives connection state through EventQueue instead, so these
+ * calls only need to succeed quietly.
+ */
+
+typedef enum { WIFI_OFF = 0, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+
+typedef enum {
+    WIFI_AUTH_OPEN = 0,
+    WIFI_AUTH_WEP,
+    WIFI_AUTH_WPA_PSK,
+    WIFI_AUTH_WPA2_PSK,
+    WIFI_AUTH_WPA_WPA2_PSK,
+    WIFI_AUTH_WPA2_ENTERPRISE,
+    WIFI_AUTH_WPA3_PSK,
+    WIFI_AUTH_WPA2_WPA3_PSK
+} wifi_auth_mode_t;
+
+typedef enum { WIFI_PS_NONE, WIFI_PS_MIN_MODEM, WIFI_PS_MAX_MODEM } wifi_ps_type_t;
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL,
+    WL_SCAN_COMPLETED,
+    WL_CONNECTED,
+    WL_CONNECT_FAILED,
+    WL_CONNECTION_LOST,
+    WL_DISCONNECTED,
+    WL_NO_SHIELD = 255
+} wl_status_t;
+
+typedef enum {
+    ARDUINO_EVENT_WIFI_READY = 0,
+    ARDUINO_EVENT_WIFI_STA_START,
+    ARDUINO_EVENT_WIFI_STA_CONNECTED,
+    ARDUINO_EVENT_WIFI_STA_DISCONNECTED,
+    ARDUINO_EVENT_WIFI_STA_GOT_IP,
+    ARDUINO_EVENT_WIFI_AP_START,
+    ARDUINO_EVENT_WIFI_AP_STACONNECTED
+} arduino_event_id_t;
+
+typedef arduino_event_id_t WiFiEvent_t;
+typedef void (*WiFiEventCb)(arduino_event_id_t event);
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED  (-2)
+
+class WiFiClass {
+public:
+    int onEvent(WiFiEventCb callback) { (void)callback; return 0; }
+    bool mode(wifi_mode_t mode) { _mode = mode; return true; }
+    wifi_mode_t getMode() const { return _mode; }
+    bool setSleep(wifi_ps_type_t type) { (void)type; return true; }
+    bool setSleep(bool enabled) { (void)enabled; return true; }
+
+    wl_status_t begin(const char* ssid, const char* password = nullptr) {
+        (void)ssid;
+        (void)password;
+        return WL_DISCONNECTED;
+    }
+    bool disconnect(bool wifi_off = false) { (void)wifi_off; return true; }
+    wl_status_t status() const { return WL_DISCONNECTED; }
+    bool isConnected() const { return false; }
+
+    IPAddress localIP() const { return IPAddress(); }
+    String SSID() const { return String(); }
+    int32_t RSSI() const { return 0; }
+    uint8_t* macAddress(uint8_t* mac) const {
+        static const uint8_t sim_mac[6] = {0x02, 0x00, 0x00, 0x5e, 0xd0, 0x9e};
+        memcpy(mac, sim_mac, sizeof(sim_mac));
+        return mac;
+    }
+    String macAddress() const { return String("02:00:00:5E:D0:9E"); }
+
+    bool softAPConfig(IPAddress local_ip, IPAddress gateway, IPAddress subnet) {
+        _ap_ip = local_ip;
+        (void)gateway;
+        (void)subnet;
+        return true;
+    }
+    bool softAP(const char* ssid, const char* password = nullptr) {
+        (void)ssid;
+        (void)password;
+        return true;
+    }
+    bool softAPdisconnect(bool wifi_off = false) { (void)wifi_off; return true; }
+    IPAddress softAPIP() const { return _ap_ip; }
+    uint8_t softAPgetStationNum() const { return 0; }
+
+    int16_t scanNetworks(bool async = false, bool show_hidden = false) {
+        (void)async;
+        (void)show_hidden;
+        return 0;
+    }
+    void scanDelete() {}
+    String SSID(uint8_t index) const { (void)index; return String(); }
+    int32_t RSSI(uint8_t index) const { (void)index; return 0; }
+    wifi_auth_mode_t encryptionType(uint8_t index) const { (void)index; return WIFI_AUTH_OPEN; }
+    int32_t channel(uint8_t index) const { (void)index; return 0; }
+
+private:
+    wifi_mode_t _mode = WIFI_OFF;
+    IPAddress _ap_ip;
+};
+
+extern WiFiClass WiFi;
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <Arduino.h>
+
+class WiFiClientSecure {
+public:
+    void setInsecure() {}
+    void setCACert(const char* cert) { (void)cert; }
+    void stop() {}
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+/**
+ * Host stand-in for the FreeRTOS API the firmware uses, on top of std::thread.
+ *
+ * One tick is one millisecond. Core affinity and priorities are accepted and
+ * ignored. Queues copy items bytewise, exactly like the real thing, so only
+ * trivially copyable types may go through them.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef uint32_t TickType_t;
+typedef int32_t BaseType_t;
+typedef uint32_t UBaseType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE  ((BaseType_t)1)
+#define pdFAIL  pdFALSE
+#define pdPASS  pdTRUE
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define tskIDLE_PRIORITY ((UBaseType_t)0)
+#define tskNO_AFFINITY ((BaseType_t)0x7FFFFFFF)
+
+BaseType_t xPortGetCoreID();
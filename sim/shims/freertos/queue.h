@@ -0,0 +1,16 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+struct SimQueue;
+typedef SimQueue* QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks);
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void* item, TickType_t ticks);
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks);
+BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t ticks);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+#define xQueueSendToBack xQueueSend
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+struct SimTask;
+typedef SimTask* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stack_depth,
+                       void* parameter, UBaseType_t priority, TaskHandle_t* handle);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stack_depth,
+                                   void* parameter, UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t core);
+
+/**
+ * @brief Delete a task
+ *
+ * vTaskDelete(nullptr) ends the calling task. Threads can't be killed from
+ * outside, so deleting another task only detaches it; the firmware's tasks
+ * all leave their loops before that happens.
+ */
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+char* pcTaskGetName(TaskHandle_t task);
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+
+#define taskYIELD() vTaskDelay(0)
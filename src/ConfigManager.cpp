@@ -15,23 +15,45 @@ void ConfigManager::setEventQueue(EventQueue* queue) {
 }
 
 void ConfigManager::begin() {
-    // Initialize preferences
+    // Initialize preferences; they stay open, writes go straight to NVS
     _preferences.begin(_namespace, false);
     _insightsPrefs.begin(_insightsNamespace, false);
     _cardPrefs.begin(_cardNamespace, false);
     
+    _mutex = xSemaphoreCreateMutex();
+    if (_mutex == nullptr) {
+        Serial.println("Could not create config mutex");
+    }
+    
+    loadSettings();
+    
     // Check initial API configuration state
     updateApiConfigurationState();
 }
 
+void ConfigManager::loadSettings() {
+    lock();
+    
+    _hasCredentials = _preferences.getBool(_hasCredentialsKey, false);
+    _ssid = _preferences.isKey(_ssidKey) ? _preferences.getString(_ssidKey, "") : "";
+    _password = _preferences.isKey(_passwordKey) ? _preferences.getString(_passwordKey, "") : "";
+    
+    _teamId = _preferences.isKey(_teamIdKey) ? _preferences.getInt(_teamIdKey) : NO_TEAM_ID;
+    _apiKey = _preferences.isKey(_apiKeyKey) ? _preferences.getString(_apiKeyKey, "") : "";
+    _region = _preferences.isKey(_regionKey) ? _preferences.getString(_regionKey, "") : "";
+    
+    _hasDisplayBufferMode = _preferences.isKey(_displayBufferModeKey);
+    _displayBufferMode = _preferences.getUChar(_displayBufferModeKey, 0);
+    
+    _cardConfigs = readCardConfigs();
+    _dirty = 0;
+    
+    unlock();
+}
+
 // Private helper to check and update API configuration state
 void ConfigManager::updateApiConfigurationState() {
-    if (!_preferences.isKey(_teamIdKey) || getTeamId() == NO_TEAM_ID) {
-        SystemController::setApiState(ApiState::API_AWAITING_CONFIG);
-        return;
-    }
-    
-    if (!_preferences.isKey(_apiKeyKey) || getApiKey().isEmpty()) {
+    if (getTeamId() == NO_TEAM_ID || getApiKey().isEmpty()) {
         SystemController::setApiState(ApiState::API_AWAITING_CONFIG);
         return;
     }
@@ -40,33 +62,46 @@ void ConfigManager::updateApiConfigurationState() {
     SystemController::setApiState(ApiState::API_CONFIGURED);
 }
 
-// Helper method to commit changes to flash
-void ConfigManager::commit() {
-    _preferences.end();
-    _insightsPrefs.end();
-    _cardPrefs.end();
-    
-    _preferences.begin(_namespace, false);
-    _insightsPrefs.begin(_insightsNamespace, false);
-    _cardPrefs.begin(_cardNamespace, false);
+bool ConfigManager::lock() {
+    // Before begin() there is no mutex, and no other task using the config yet
+    return _mutex == nullptr || xSemaphoreTake(_mutex, portMAX_DELAY) == pdTRUE;
+}
+
+void ConfigManager::unlock() {
+    if (_mutex) {
+        xSemaphoreGive(_mutex);
+    }
+}
+
+void ConfigManager::markDirty(uint8_t flags) {
+    _dirty |= flags;
+    // Each group keeps its own quiet period, so a run of renames can't hold back other settings
+    if (flags & DIRTY_CARD_NAMES) {
+        _namesChangedMs = millis();
+    }
+    if (flags & ~DIRTY_CARD_NAMES) {
+        _changedMs = millis();
+    }
 }
 
 bool ConfigManager::saveWiFiCredentials(const String& ssid, const String& password) {
     if (ssid.length() == 0 || ssid.length() > MAX_SSID_LENGTH) {
         return false;
     }
-
+    
     if (password.length() > MAX_PASSWORD_LENGTH) {
         return false;
     }
-
-    // Save credentials
-    _preferences.putString(_ssidKey, ssid);
-    _preferences.putString(_passwordKey, password);
-    _preferences.putBool(_hasCredentialsKey, true);
     
-    // Commit changes
-    commit();
+    // Save credentials
+    lock();
+    if (!_hasCredentials || _ssid != ssid || _password != password) {
+        _ssid = ssid;
+        _password = password;
+        _hasCredentials = true;
+        markDirty(DIRTY_WIFI);
+    }
+    unlock();
     
     // Publish event if event queue is available
     if (_eventQueue != nullptr) {
@@ -77,24 +112,27 @@ bool ConfigManager::saveWiFiCredentials(const String& ssid, const String& passwo
 }
 
 bool ConfigManager::getWiFiCredentials(String& ssid, String& password) {
-    if (!hasWiFiCredentials()) {
-        return false;
+    lock();
+    bool hasCredentials = _hasCredentials;
+    if (hasCredentials) {
+        // Retrieve credentials
+        ssid = _ssid;
+        password = _password;
     }
-
-    // Retrieve credentials
-    ssid = _preferences.getString(_ssidKey, "");
-    password = _preferences.getString(_passwordKey, "");
+    unlock();
     
-    return true;
+    return hasCredentials;
 }
 
 void ConfigManager::clearWiFiCredentials() {
-    _preferences.remove(_ssidKey);
-    _preferences.remove(_passwordKey);
-    _preferences.putBool(_hasCredentialsKey, false);
-    
-    // Commit changes
-    commit();
+    lock();
+    if (_hasCredentials || !_ssid.isEmpty() || !_password.isEmpty()) {
+        _ssid = "";
+        _password = "";
+        _hasCredentials = false;
+        markDirty(DIRTY_WIFI);
+    }
+    unlock();
     
     // Publish event if event queue is available
     if (_eventQueue != nullptr) {
@@ -103,7 +141,10 @@ void ConfigManager::clearWiFiCredentials() {
 }
 
 bool ConfigManager::hasWiFiCredentials() {
-    return _preferences.getBool(_hasCredentialsKey, false);
+    lock();
+    bool hasCredentials = _hasCredentials;
+    unlock();
+    return hasCredentials;
 }
 
 bool ConfigManager::checkWiFiCredentialsAndPublish() {
@@ -122,44 +163,43 @@ bool ConfigManager::checkWiFiCredentialsAndPublish() {
 
 
 void ConfigManager::setTeamId(int teamId) {
-    _preferences.putInt(_teamIdKey, teamId);
-    
-    // Commit changes
-    commit();
+    lock();
+    if (_teamId != teamId) {
+        _teamId = teamId;
+        markDirty(DIRTY_TEAM_ID);
+    }
+    unlock();
     
     updateApiConfigurationState();
 }
 
 int ConfigManager::getTeamId() {
-    if (!_preferences.isKey(_teamIdKey)) {
-        return NO_TEAM_ID;
-    }
-    return _preferences.getInt(_teamIdKey);
+    lock();
+    int teamId = _teamId;
+    unlock();
+    return teamId;
 }
 
 void ConfigManager::setRegion(String region) {
-    _preferences.putString(_regionKey, region);
-    
-    // Commit changes
-    commit();
+    lock();
+    if (_region != region) {
+        _region = region;
+        markDirty(DIRTY_REGION);
+    }
+    unlock();
     
     updateApiConfigurationState();
 }
 
 String ConfigManager::getRegion() {
-    if (!_preferences.isKey(_regionKey)) {
-        return "us";
-    }
-    return _preferences.getString(_regionKey);
+    lock();
+    String region = _region.isEmpty() ? String("us") : _region;
+    unlock();
+    return region;
 }
 
 void ConfigManager::clearTeamId() {
-    _preferences.remove(_teamIdKey);
-    
-    // Commit changes
-    commit();
-    
-    SystemController::setApiState(ApiState::API_AWAITING_CONFIG);
+    setTeamId(NO_TEAM_ID);
 }
 
 bool ConfigManager::setApiKey(const String& apiKey) {
@@ -167,30 +207,66 @@ bool ConfigManager::setApiKey(const String& apiKey) {
         SystemController::setApiState(ApiState::API_CONFIG_INVALID);
         return false;
     }
-
-    _preferences.putString(_apiKeyKey, apiKey);
     
-    // Commit changes
-    commit();
+    lock();
+    if (_apiKey != apiKey) {
+        _apiKey = apiKey;
+        markDirty(DIRTY_API_KEY);
+    }
+    unlock();
     
     updateApiConfigurationState();
     return true;
 }
 
 String ConfigManager::getApiKey() {
-    return _preferences.getString(_apiKeyKey, "");
+    lock();
+    String apiKey = _apiKey;
+    unlock();
+    return apiKey;
 }
 
 void ConfigManager::clearApiKey() {
-    _preferences.remove(_apiKeyKey);
-    
-    // Commit changes
-    commit();
+    lock();
+    if (!_apiKey.isEmpty()) {
+        _apiKey = "";
+        markDirty(DIRTY_API_KEY);
+    }
+    unlock();
     
     SystemController::setApiState(ApiState::API_AWAITING_CONFIG);
 }
 
+void ConfigManager::setDisplayBufferMode(DisplayBufferMode mode) {
+    lock();
+    if (!_hasDisplayBufferMode || _displayBufferMode != (uint8_t)mode) {
+        _hasDisplayBufferMode = true;
+        _displayBufferMode = (uint8_t)mode;
+        markDirty(DIRTY_DISPLAY);
+    }
+    unlock();
+}
+
+DisplayBufferMode ConfigManager::getDisplayBufferMode(DisplayBufferMode fallback) {
+    lock();
+    bool stored = _hasDisplayBufferMode;
+    uint8_t mode = _displayBufferMode;
+    unlock();
+    
+    if (!stored || mode > (uint8_t)DisplayBufferMode::DIRECT_SINGLE) {
+        return fallback;
+    }
+    return (DisplayBufferMode)mode;
+}
+
 std::vector<CardConfig> ConfigManager::getCardConfigs() {
+    lock();
+    std::vector<CardConfig> configs = _cardConfigs;
+    unlock();
+    return configs;
+}
+
+std::vector<CardConfig> ConfigManager::readCardConfigs() {
     std::vector<CardConfig> configs;
     
     // Check if the key exists first to avoid error logs
@@ -227,7 +303,28 @@ std::vector<CardConfig> ConfigManager::getCardConfigs() {
     return configs;
 }
 
-bool ConfigManager::saveCardConfigs(const std::vector<CardConfig>& configs) {
+ConfigManager::CardConfigChange ConfigManager::classifyCardConfigChange(
+    const std::vector<CardConfig>& before, const std::vector<CardConfig>& after) {
+    if (before.size() != after.size()) {
+        return CardConfigChange::STRUCTURAL;
+    }
+    
+    CardConfigChange change = CardConfigChange::NONE;
+    for (size_t i = 0; i < before.size(); i++) {
+        // Anything that decides which cards exist, or where, needs a reconcile
+        if (before[i].type != after[i].type ||
+            before[i].config != after[i].config ||
+            before[i].order != after[i].order) {
+            return CardConfigChange::STRUCTURAL;
+        }
+        if (before[i].name != after[i].name) {
+            change = CardConfigChange::COSMETIC;
+        }
+    }
+    return change;
+}
+
+bool ConfigManager::writeCardConfigs(const std::vector<CardConfig>& configs) {
     // Create JSON document
     DynamicJsonDocument doc(2048);
     JsonArray array = doc.to<JsonArray>();
@@ -251,13 +348,140 @@ bool ConfigManager::saveCardConfigs(const std::vector<CardConfig>& configs) {
     // Save to preferences
     _cardPrefs.putString("config_list", jsonString);
     
-    // Commit changes
-    commit();
+    return true;
+}
+
+bool ConfigManager::saveCardConfigs(const std::vector<CardConfig>& configs) {
+    lock();
     
-    // Publish event if event queue is available
-    if (_eventQueue != nullptr) {
+    // Against the RAM copy, so a save that only repeats pending renames is free
+    CardConfigChange change = classifyCardConfigChange(_cardConfigs, configs);
+    if (change != CardConfigChange::NONE) {
+        _cardConfigs = configs;
+        markDirty(DIRTY_CARDS);
+    }
+    
+    unlock();
+    
+    // Only structural changes make the card stack reconcile
+    if (change == CardConfigChange::STRUCTURAL && _eventQueue != nullptr) {
         _eventQueue->publishEvent(EventType::CARD_CONFIG_CHANGED, "");
     }
     
     return true;
-}
\ No newline at end of file
+}
+
+void ConfigManager::updateCardName(CardType type, const String& config, const String& name) {
+    lock();
+    
+    bool changed = false;
+    for (CardConfig& cardConfig : _cardConfigs) {
+        if (cardConfig.type == type && cardConfig.config == config && cardConfig.name != name) {
+            cardConfig.name = name;
+            changed = true;
+        }
+    }
+    
+    if (changed) {
+        markDirty(DIRTY_CARD_NAMES);
+    }
+    
+    unlock();
+}
+
+bool ConfigManager::removeKey(const char* key) {
+    if (!_preferences.isKey(key)) {
+        return false;
+    }
+    _preferences.remove(key);
+    return true;
+}
+
+void ConfigManager::flushLocked() {
+    uint8_t dirty = _dirty;
+    if (dirty == 0) {
+        return;
+    }
+    
+    uint32_t writes = 0;
+    if (dirty & DIRTY_WIFI) {
+        if (_hasCredentials) {
+            _preferences.putString(_ssidKey, _ssid);
+            _preferences.putString(_passwordKey, _password);
+            writes += 2;
+        } else {
+            writes += removeKey(_ssidKey);
+            writes += removeKey(_passwordKey);
+        }
+        _preferences.putBool(_hasCredentialsKey, _hasCredentials);
+        writes++;
+    }
+    if (dirty & DIRTY_TEAM_ID) {
+        if (_teamId != NO_TEAM_ID) {
+            _preferences.putInt(_teamIdKey, _teamId);
+            writes++;
+        } else {
+            writes += removeKey(_teamIdKey);
+        }
+    }
+    if (dirty & DIRTY_API_KEY) {
+        if (!_apiKey.isEmpty()) {
+            _preferences.putString(_apiKeyKey, _apiKey);
+            writes++;
+        } else {
+            writes += removeKey(_apiKeyKey);
+        }
+    }
+    if (dirty & DIRTY_REGION) {
+        if (!_region.isEmpty()) {
+            _preferences.putString(_regionKey, _region);
+            writes++;
+        } else {
+            writes += removeKey(_regionKey);
+        }
+    }
+    if (dirty & DIRTY_DISPLAY) {
+        _preferences.putUChar(_displayBufferModeKey, _displayBufferMode);
+        writes++;
+    }
+    // Don't retry a card config that can't be serialized
+    if ((dirty & (DIRTY_CARDS | DIRTY_CARD_NAMES)) && writeCardConfigs(_cardConfigs)) {
+        writes++;
+    }
+    
+    _dirty = 0;
+    _flashWrites += writes;
+    Serial.printf("Saved settings to flash: %lu writes (%lu since boot)\n",
+                  (unsigned long)writes, (unsigned long)_flashWrites);
+}
+
+void ConfigManager::flush() {
+    lock();
+    flushLocked();
+    unlock();
+}
+
+uint32_t ConfigManager::getFlashWriteCount() {
+    lock();
+    uint32_t writes = _flashWrites;
+    unlock();
+    return writes;
+}
+
+void ConfigManager::process() {
+    // Cheap unlocked peek; re-checked under the lock
+    if (_dirty == 0) {
+        return;
+    }
+    
+    lock();
+    // Renames trickle in as insights load, so give them longer to settle.
+    // Either group settling writes everything dirty in one go.
+    unsigned long now = millis();
+    bool settingsSettled = (_dirty & ~DIRTY_CARD_NAMES) && now - _changedMs >= PERSIST_DELAY_MS;
+    bool namesSettled = (_dirty & DIRTY_CARD_NAMES) && now - _namesChangedMs >= CARD_NAME_PERSIST_DELAY_MS;
+    if (settingsSettled || namesSettled) {
+        flushLocked();
+    }
+    unlock();
+}
@@ -3,8 +3,11 @@
 #include <Arduino.h>
 #include <Preferences.h>
 #include <vector>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 #include "EventQueue.h"
 #include "config/CardConfig.h"
+#include "hardware/DisplayBufferMode.h"
 
 /**
  * @class ConfigManager
@@ -19,11 +22,27 @@
  * 
  * Uses ESP32's non-volatile storage (NVS) through Preferences library
  * with size limits enforced for all stored values.
+ *
+ * Every setting is read from flash once in begin() and served from RAM after
+ * that. Setters change the RAM copy and mark it dirty; process() writes all
+ * dirty settings together once they have been unchanged for PERSIST_DELAY_MS
+ * (CARD_NAME_PERSIST_DELAY_MS for card names), and flush() writes them
+ * straight away. A setting that is set to the value it
+ * already has costs no write at all.
  */
 class ConfigManager {
 public:
     static const int NO_TEAM_ID = -1;  // Sentinel value for no team ID
 
+    /**
+     * @brief How a new card configuration differs from the stored one
+     */
+    enum class CardConfigChange {
+        NONE,       ///< Identical, nothing to write
+        COSMETIC,   ///< Only display fields (name) differ; cards stay as they are
+        STRUCTURAL  ///< Cards added, removed, reordered or reconfigured
+    };
+
     /**
      * @brief Default constructor
      */
@@ -126,6 +145,18 @@ public:
      */
     void clearApiKey();
 
+    /**
+     * @brief Store the display buffer mode to use from the next boot
+     * @param mode Draw buffer mode
+     */
+    void setDisplayBufferMode(DisplayBufferMode mode);
+
+    /**
+     * @brief Retrieve the stored display buffer mode
+     * @param fallback Mode to use when none is stored, usually the build default
+     * @return The stored mode, or fallback
+     */
+    DisplayBufferMode getDisplayBufferMode(DisplayBufferMode fallback);
 
     /**
      * @brief Get all configured cards from persistent storage
@@ -135,11 +166,57 @@ public:
 
     /**
      * @brief Save card configurations to persistent storage
+     * 
+     * Nothing is written if the configuration is unchanged, and
+     * CARD_CONFIG_CHANGED is only published for structural changes. The new
+     * configuration is visible at once and written with the next batch.
+     * 
      * @param configs Vector of CardConfig objects to save
      * @return true if saved successfully, false otherwise
      */
     bool saveCardConfigs(const std::vector<CardConfig>& configs);
 
+    /**
+     * @brief Rename every card with the given type and config value
+     * 
+     * Cosmetic, so no event is published. The new name is visible through
+     * getCardConfigs() straight away. process() waits
+     * CARD_NAME_PERSIST_DELAY_MS for names to stop changing before writing
+     * them, unless other settings settle first and take them along. Renames
+     * never delay other settings.
+     * 
+     * @param type Card type to match
+     * @param config Config value to match, e.g. the insight ID
+     * @param name New display name
+     */
+    void updateCardName(CardType type, const String& config, const String& name);
+
+    /**
+     * @brief Write pending changes to flash once they have settled
+     * Call regularly from a background task; does nothing when nothing is pending.
+     */
+    void process();
+
+    /**
+     * @brief Write every pending change to flash now
+     * Use before a restart or deep sleep, or when a change must survive one.
+     */
+    void flush();
+
+    /**
+     * @brief NVS writes (puts and removes) made since boot
+     */
+    uint32_t getFlashWriteCount();
+
+    /**
+     * @brief Compare two card configurations
+     * @param before Currently stored configuration
+     * @param after Configuration about to be saved
+     * @return The most significant kind of difference between them
+     */
+    static CardConfigChange classifyCardConfigChange(const std::vector<CardConfig>& before,
+                                                     const std::vector<CardConfig>& after);
+
 private:
     
     /**
@@ -153,13 +230,53 @@ private:
     void updateApiConfigurationState();
 
     /**
-     * @brief Ensures preferences changes are persisted to flash
-     * 
-     * Closes and reopens both preference namespaces to ensure changes
-     * are written to flash storage. Required after any preference modifications
-     * to ensure changes survive power cycles.
+     * @brief Bits of _dirty, one per group of keys written together
      */
-    void commit();
+    enum DirtyFlag : uint8_t {
+        DIRTY_WIFI = 1 << 0,         ///< SSID, password and credentials flag
+        DIRTY_TEAM_ID = 1 << 1,
+        DIRTY_API_KEY = 1 << 2,
+        DIRTY_REGION = 1 << 3,
+        DIRTY_DISPLAY = 1 << 4,      ///< Display buffer mode
+        DIRTY_CARDS = 1 << 5,        ///< Card list saved
+        DIRTY_CARD_NAMES = 1 << 6    ///< Only card names changed
+    };
+
+    /**
+     * @brief Read every setting from flash into RAM
+     */
+    void loadSettings();
+
+    /**
+     * @brief Mark settings dirty and restart the quiet period; call locked
+     */
+    void markDirty(uint8_t flags);
+
+    /**
+     * @brief Write the dirty settings to flash; call locked
+     */
+    void flushLocked();
+
+    /**
+     * @brief Read card configurations straight from flash
+     * @return Stored configurations, empty if none or unparseable
+     */
+    std::vector<CardConfig> readCardConfigs();
+
+    /**
+     * @brief Serialize card configurations and write them to flash
+     * @return true if written, false if serialization failed
+     */
+    bool writeCardConfigs(const std::vector<CardConfig>& configs);
+
+    /**
+     * @brief Remove a key only if it exists, to avoid NVS error logs
+     * @return true if a write was made
+     */
+    bool removeKey(const char* key);
+
+    bool lock();
+    void unlock();
 
     // Preferences instances for persistent storage
     Preferences _preferences;      ///< Main preferences storage instance
@@ -181,6 +298,9 @@ private:
     const char* _apiKeyKey = "api_key";           ///< Key for stored API key
     const char* _regionKey = "region";           ///< Key for stored region
 
+    // Storage keys for display configuration
+    const char* _displayBufferModeKey = "disp_buf"; ///< Key for stored display buffer mode
+
 
     // Storage size limits
     /** @brief Maximum length for WiFi SSID (per IEEE 802.11 spec) */
@@ -193,6 +313,28 @@ private:
     static const size_t MAX_API_KEY_LENGTH = 64;
     /** @brief Maximum length for insight identifier */
     static const size_t MAX_INSIGHT_ID_LENGTH = 64;
+    /** @brief How long settings must stay unchanged before they are written */
+    static const unsigned long PERSIST_DELAY_MS = 2000;
+    /** @brief How long card names must stay unchanged before they are written on their own */
+    static const unsigned long CARD_NAME_PERSIST_DELAY_MS = 10000;
+
+    // RAM copy of every stored setting, loaded by begin()
+    String _ssid;
+    String _password;
+    bool _hasCredentials = false;
+    int _teamId = NO_TEAM_ID;
+    String _apiKey;                               ///< Empty when not set
+    String _region;                               ///< Empty when not set
+    bool _hasDisplayBufferMode = false;
+    uint8_t _displayBufferMode = 0;
+    std::vector<CardConfig> _cardConfigs;
+
+    // Write batching
+    uint8_t _dirty = 0;                           ///< DirtyFlag bits not yet written
+    unsigned long _changedMs = 0;                 ///< When a setting other than a card name last changed
+    unsigned long _namesChangedMs = 0;            ///< When a card name last changed
+    uint32_t _flashWrites = 0;                    ///< NVS puts and removes since boot
+    SemaphoreHandle_t _mutex = nullptr;           ///< Guards the RAM copy, dirty bits and flash writes
 
     // Event system
     EventQueue* _eventQueue = nullptr;  ///< Optional event queue for state notifications
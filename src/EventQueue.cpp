@@ -1,11 +1,13 @@
 #include "EventQueue.h"
+#include <new>
 
-EventQueue::EventQueue(size_t queueSize) : isRunning(false), taskHandle(nullptr) {
-    // Create the event queue
-    eventQueue = xQueueCreate(queueSize, sizeof(Event));
+EventQueue::EventQueue(size_t queueSize) : nextSubscription(1), isRunning(false), taskHandle(nullptr) {
+    // Create the event queue. It holds pointers: Event owns Strings and a
+    // shared_ptr, which must not be copied bytewise
+    eventQueue = xQueueCreate(queueSize, sizeof(Event*));
     
-    // Create mutex for callback access
-    callbackMutex = xSemaphoreCreateMutex();
+    // Create mutex for queued subscription changes
+    subscriptionMutex = xSemaphoreCreateMutex();
 }
 
 EventQueue::~EventQueue() {
@@ -14,13 +16,17 @@ EventQueue::~EventQueue() {
     
     // Clean up resources
     if (eventQueue) {
+        Event* pending;
+        while (xQueueReceive(eventQueue, &pending, 0) == pdPASS) {
+            delete pending;
+        }
         vQueueDelete(eventQueue);
         eventQueue = nullptr;
     }
     
-    if (callbackMutex) {
-        vSemaphoreDelete(callbackMutex);
-        callbackMutex = nullptr;
+    if (subscriptionMutex) {
+        vSemaphoreDelete(subscriptionMutex);
+        subscriptionMutex = nullptr;
     }
 }
 
@@ -45,18 +51,55 @@ bool EventQueue::publishEvent(EventType eventType, const String& insightId, cons
 }
 
 bool EventQueue::publishEvent(const Event& event) {
-    // Add the event to the queue
-    if (xQueueSend(eventQueue, &event, 0) == pdPASS) {
+    // Add a copy of the event to the queue; the processing task deletes it
+    Event* queued = new (std::nothrow) Event(event);
+    if (!queued) {
+        return false;
+    }
+    if (xQueueSend(eventQueue, &queued, 0) == pdPASS) {
         return true;
     }
+    delete queued;
     return false;
 }
 
-void EventQueue::subscribe(EventCallback callback) {
-    // Protect access to the callbacks vector
-    if (xSemaphoreTake(callbackMutex, portMAX_DELAY) == pdTRUE) {
-        eventCallbacks.push_back(callback);
-        xSemaphoreGive(callbackMutex);
+EventSubscription EventQueue::subscribe(EventCallback callback) {
+    EventSubscription subscription = 0;
+    // Queued for the processing task, so this never waits on a callback
+    if (xSemaphoreTake(subscriptionMutex, portMAX_DELAY) == pdTRUE) {
+        subscription = nextSubscription++;
+        pendingSubscribes.emplace_back(subscription, std::move(callback));
+        xSemaphoreGive(subscriptionMutex);
+    }
+    return subscription;
+}
+
+void EventQueue::unsubscribe(EventSubscription subscription) {
+    if (xSemaphoreTake(subscriptionMutex, portMAX_DELAY) == pdTRUE) {
+        pendingUnsubscribes.push_back(subscription);
+        xSemaphoreGive(subscriptionMutex);
+    }
+}
+
+void EventQueue::applyPendingSubscriptions() {
+    std::vector<std::pair<EventSubscription, EventCallback>> added;
+    std::vector<EventSubscription> removed;
+    if (xSemaphoreTake(subscriptionMutex, portMAX_DELAY) == pdTRUE) {
+        added.swap(pendingSubscribes);
+        removed.swap(pendingUnsubscribes);
+        xSemaphoreGive(subscriptionMutex);
+    }
+    // Additions first, so a subscription removed before it was applied still goes
+    for (auto& subscriber : added) {
+        eventCallbacks.push_back(std::move(subscriber));
+    }
+    for (EventSubscription subscription : removed) {
+        for (auto it = eventCallbacks.begin(); it != eventCallbacks.end(); ++it) {
+            if (it->first == subscription) {
+                eventCallbacks.erase(it);
+                break;
+            }
+        }
     }
 }
 
@@ -90,19 +133,18 @@ void EventQueue::end() {
 
 void EventQueue::eventProcessingTask(void* parameter) {
     EventQueue* self = static_cast<EventQueue*>(parameter);
-    Event event;
+    Event* event;
     
     // Process events in a loop
     while (self->isRunning) {
         // Wait for an event (block until an event arrives)
         if (xQueueReceive(self->eventQueue, &event, pdMS_TO_TICKS(100)) == pdPASS) {
             // Process the event by calling all registered callbacks
-            if (xSemaphoreTake(self->callbackMutex, portMAX_DELAY) == pdTRUE) {
-                for (const auto& callback : self->eventCallbacks) {
-                    callback(event);
-                }
-                xSemaphoreGive(self->callbackMutex);
+            self->applyPendingSubscriptions();
+            for (const auto& subscriber : self->eventCallbacks) {
+                subscriber.second(*event);
             }
+            delete event;
         }
         // Small delay to prevent CPU hogging
         vTaskDelay(1);
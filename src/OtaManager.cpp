@@ -76,8 +76,9 @@ struct UpdateTaskParams {
 };
 
 // Constructor
-OtaManager::OtaManager(const String& currentVersion, const String& repoOwner, const String& repoName)
-    : _currentVersion(currentVersion),
+OtaManager::OtaManager(ConfigManager& configManager, const String& currentVersion, const String& repoOwner, const String& repoName)
+    : _configManager(configManager),
+      _currentVersion(currentVersion),
       _repoOwner(repoOwner),
       _repoName(repoName),
       _checkTaskHandle(NULL),
@@ -862,6 +863,7 @@ void OtaManager::_updateTaskRunner(void* pvParameters) {
             } else {
                 self->_setUpdateStatus(UpdateStatus::State::SUCCESS, "Update successful! Rebooting...", 100);
                 Serial.println("OtaManager: [_updateTaskRunner] Update successful. Rebooting...");
+                self->_configManager.flush(); // Settings still waiting in RAM would be lost
                 delay(1000); // Give a moment for serial message to get out
                 ESP.restart();
             }
@@ -13,6 +13,8 @@
 // Add these includes for FreeRTOS mutex
 #include <freertos/semphr.h>
 
+#include "ConfigManager.h"
+
 // Forward declarations if needed, e.g., if using WiFiClientSecure pointer
 // class WiFiClientSecure;
 
@@ -56,11 +58,12 @@ class OtaManager {
 public:
     /**
      * @brief Constructor
+     * @param configManager Settings to write to flash before rebooting into an update.
      * @param currentVersion The firmware version currently running.
      * @param repoOwner GitHub repository owner (e.g., "PostHog").
      * @param repoName GitHub repository name (e.g., "DeskHog").
      */
-    OtaManager(const String& currentVersion, const String& repoOwner, const String& repoName);
+    OtaManager(ConfigManager& configManager, const String& currentVersion, const String& repoOwner, const String& repoName);
 
     /**
      * @brief Initiates a check for firmware updates in a non-blocking manner.
@@ -95,6 +98,7 @@ public:
     void process(); // Optional, depending on async approach
 
 private:
+    ConfigManager& _configManager;
     String _currentVersion;
     String _repoOwner;
     String _repoName;
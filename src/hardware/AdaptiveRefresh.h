@@ -0,0 +1,60 @@
+#pragma once
+
+#include <lvgl.h>
+#include <stdint.h>
+
+/**
+ * @brief Raises LVGL's refresh and animation rate only while something moves
+ *
+ * LVGL redraws invalidated areas on its refresh timer and steps animations on
+ * its animation timer, both at LV_DEF_REFR_PERIOD. That is plenty for cards
+ * that change a number every few seconds, and both timers pause themselves
+ * when there is nothing to do. While an animation runs or a game redraws
+ * every loop, both timers run at ACTIVE_PERIOD_MS instead, then drop back.
+ *
+ * UI task only. Call apply() before each lv_timer_handler().
+ */
+class AdaptiveRefresh {
+public:
+    static constexpr uint32_t IDLE_PERIOD_MS = LV_DEF_REFR_PERIOD;
+    static constexpr uint32_t ACTIVE_PERIOD_MS = 16; ///< About 60 fps; full-screen frames are capped lower by the panel link
+
+    AdaptiveRefresh() : _display(nullptr), _continuous(false), _period_ms(IDLE_PERIOD_MS) {}
+
+    void begin(lv_display_t* display) {
+        _display = display;
+        _period_ms = IDLE_PERIOD_MS;
+    }
+
+    /**
+     * @brief Note whether the active card wants an update every loop (games)
+     */
+    void setContinuousUpdates(bool continuous) { _continuous = continuous; }
+
+    /**
+     * @brief Pick the timer period for what is on screen right now
+     */
+    void apply() {
+        if (!_display) return;
+
+        uint32_t period = (_continuous || lv_anim_count_running() > 0) ? ACTIVE_PERIOD_MS : IDLE_PERIOD_MS;
+        if (period == _period_ms) return;
+        _period_ms = period;
+
+        lv_timer_t* refresh = lv_display_get_refr_timer(_display);
+        if (refresh) {
+            lv_timer_set_period(refresh, period);
+        }
+        lv_timer_t* anim = lv_anim_get_timer();
+        if (anim) {
+            lv_timer_set_period(anim, period);
+        }
+    }
+
+    uint32_t getPeriodMs() const { return _period_ms; }
+
+private:
+    lv_display_t* _display;
+    bool _continuous;
+    uint32_t _period_ms;
+};
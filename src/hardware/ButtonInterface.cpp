@@ -0,0 +1,196 @@
+#include "ButtonInterface.h"
+#include "Input.h"
+#include <driver/gpio.h>
+#include <esp_sleep.h>
+
+ButtonInterface::ButtonInterface()
+    : _queue(nullptr), _task(nullptr), _receiver(nullptr), _mux(portMUX_INITIALIZER_UNLOCKED) {
+    // Button indexes are also the GPIO numbers
+    const uint8_t pressed_levels[NUM_BUTTONS] = {
+        LOW,   // BUTTON_DOWN: BOOT button, pulled up
+        HIGH,  // BUTTON_CENTER: pulled down
+        HIGH   // BUTTON_UP: pulled down
+    };
+
+    for (uint8_t i = 0; i < NUM_BUTTONS; i++) {
+        Button& button = _buttons[i];
+        button.owner = this;
+        button.pin = i;
+        button.pressed_level = pressed_levels[i];
+        button.repeats = (i == Input::BUTTON_UP || i == Input::BUTTON_DOWN);
+        button.edge_pending = false;
+        button.first_edge_ms = 0;
+        button.last_edge_ms = 0;
+        button.held = false;
+        button.pressed_at_ms = 0;
+        button.next_repeat_ms = 0;
+        button.long_press_sent = false;
+    }
+}
+
+void ButtonInterface::begin() {
+    _queue = xQueueCreate(QUEUE_DEPTH, sizeof(Event));
+    if (!_queue) {
+        Serial.println("[ButtonInterface] Failed to create event queue");
+        return;
+    }
+
+    // Above the LVGL task, so debouncing never waits behind a render
+    xTaskCreatePinnedToCore(_task_function, "buttonTask", 3072, this, 3, &_task, 1);
+
+    for (Button& button : _buttons) {
+        int level = digitalRead(button.pin);
+        button.held = (level == button.pressed_level);
+
+        // Fire on the level the pin isn't at yet; the ISR flips it each time.
+        // Level, not edge, so the same interrupt can wake from light sleep.
+        attachInterruptArg(button.pin, _edge_isr, &button, level ? ONLOW : ONHIGH);
+        gpio_wakeup_enable((gpio_num_t)button.pin, level ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+    }
+    esp_sleep_enable_gpio_wakeup();
+    Serial.println("[ButtonInterface] Button interrupts and light sleep wakeup configured");
+}
+
+void ARDUINO_ISR_ATTR ButtonInterface::_edge_isr(void* arg) {
+    Button* button = static_cast<Button*>(arg);
+    ButtonInterface* self = button->owner;
+    uint32_t now = millis();
+
+    // Re-arm for the opposite level so the next change fires too
+    int level = digitalRead(button->pin);
+    gpio_wakeup_enable((gpio_num_t)button->pin, level ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+
+    portENTER_CRITICAL_ISR(&self->_mux);
+    if (!button->edge_pending) {
+        button->edge_pending = true;
+        button->first_edge_ms = now;
+    }
+    button->last_edge_ms = now;
+    portEXIT_CRITICAL_ISR(&self->_mux);
+
+    BaseType_t woken = pdFALSE;
+    if (self->_task) {
+        vTaskNotifyGiveFromISR(self->_task, &woken);
+    }
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+void ButtonInterface::_task_function(void* arg) {
+    ButtonInterface* self = static_cast<ButtonInterface*>(arg);
+    TickType_t wait = portMAX_DELAY;
+
+    while (1) {
+        // Sleeps until an edge or the next debounce/repeat/long-press deadline
+        ulTaskNotifyTake(pdTRUE, wait);
+
+        uint32_t now = millis();
+        for (Button& button : self->_buttons) {
+            self->_service(button, now);
+        }
+        wait = self->_next_wait(millis());
+    }
+}
+
+void ButtonInterface::_service(Button& button, uint32_t now) {
+    bool settled = false;
+    uint32_t first_edge_ms = 0;
+
+    portENTER_CRITICAL(&_mux);
+    if (button.edge_pending && now - button.last_edge_ms >= DEBOUNCE_MS) {
+        button.edge_pending = false;
+        first_edge_ms = button.first_edge_ms;
+        settled = true;
+    }
+    portEXIT_CRITICAL(&_mux);
+
+    // A burst that ends where it started is just noise
+    if (settled) {
+        bool down = (digitalRead(button.pin) == button.pressed_level);
+        if (down != button.held) {
+            button.held = down;
+            if (down) {
+                button.pressed_at_ms = first_edge_ms;
+                button.next_repeat_ms = first_edge_ms + REPEAT_DELAY_MS;
+                button.long_press_sent = false;
+                _send(button, EventType::PRESS, first_edge_ms);
+            }
+        }
+    }
+
+    if (!button.held) {
+        return;
+    }
+
+    if (!button.long_press_sent && now - button.pressed_at_ms >= LONG_PRESS_MS) {
+        button.long_press_sent = true;
+        _send(button, EventType::LONG_PRESS, button.pressed_at_ms + LONG_PRESS_MS);
+    }
+
+    if (button.repeats && (int32_t)(now - button.next_repeat_ms) >= 0) {
+        _send(button, EventType::REPEAT, now);
+        button.next_repeat_ms += REPEAT_INTERVAL_MS;
+        if ((int32_t)(now - button.next_repeat_ms) >= 0) {
+            button.next_repeat_ms = now + REPEAT_INTERVAL_MS; // Fell behind, don't burst
+        }
+    }
+}
+
+TickType_t ButtonInterface::_next_wait(uint32_t now) {
+    uint32_t wait_ms = UINT32_MAX;
+    auto until = [&](uint32_t deadline_ms) {
+        int32_t remaining = (int32_t)(deadline_ms - now);
+        uint32_t due = remaining > 0 ? (uint32_t)remaining : 0;
+        if (due < wait_ms) wait_ms = due;
+    };
+
+    for (const Button& button : _buttons) {
+        portENTER_CRITICAL(&_mux);
+        bool edge_pending = button.edge_pending;
+        uint32_t last_edge_ms = button.last_edge_ms;
+        portEXIT_CRITICAL(&_mux);
+
+        if (edge_pending) {
+            until(last_edge_ms + DEBOUNCE_MS);
+        }
+        if (button.held) {
+            if (!button.long_press_sent) {
+                until(button.pressed_at_ms + LONG_PRESS_MS);
+            }
+            if (button.repeats) {
+                until(button.next_repeat_ms);
+            }
+        }
+    }
+
+    if (wait_ms == UINT32_MAX) {
+        return portMAX_DELAY;
+    }
+    return pdMS_TO_TICKS(wait_ms) + 1; // Round up so the deadline has passed
+}
+
+void ButtonInterface::_send(const Button& button, EventType type, uint32_t timestamp_ms) {
+    Event event;
+    event.button = button.pin;
+    event.type = type;
+    event.timestamp_ms = timestamp_ms;
+
+    // Wait for room rather than lose a press; the UI task drains every loop
+    xQueueSend(_queue, &event, portMAX_DELAY);
+
+    // The UI task may be asleep until its next LVGL timer
+    TaskHandle_t receiver = _receiver;
+    if (receiver) {
+        xTaskNotifyGive(receiver);
+    }
+}
+
+bool ButtonInterface::receiveEvent(Event& event) {
+    _receiver = xTaskGetCurrentTaskHandle();
+    return _queue && xQueueReceive(_queue, &event, 0) == pdTRUE;
+}
+
+bool ButtonInterface::isHeld(uint8_t button) const {
+    return button < NUM_BUTTONS && _buttons[button].held;
+}
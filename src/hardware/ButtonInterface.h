@@ -0,0 +1,110 @@
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+
+/**
+ * @class ButtonInterface
+ * @brief Interrupt-driven button input feeding a timestamped event queue
+ *
+ * Each button pin has a level interrupt that is flipped to the opposite level
+ * every time it fires, so it behaves like an edge interrupt while still being
+ * usable as a light-sleep wakeup source. The ISR only records when the pin
+ * last changed and wakes a small input task; that task debounces once the pin
+ * has been quiet for DEBOUNCE_MS, then classifies presses, auto-repeats and
+ * long presses and queues them for the UI task.
+ *
+ * Nothing polls: the input task sleeps until an edge arrives or a held
+ * button's next repeat or long-press deadline. Events are never dropped; the
+ * input task waits for room if the UI task falls behind. Each queued event
+ * notifies the task that reads them, so that task can sleep too.
+ */
+class ButtonInterface {
+public:
+    enum class EventType : uint8_t {
+        PRESS,      ///< Button went down
+        REPEAT,     ///< Button still held, auto-repeat interval elapsed
+        LONG_PRESS  ///< Button held past LONG_PRESS_MS, sent once per press
+    };
+
+    struct Event {
+        uint8_t button;        ///< Input::BUTTON_* index
+        EventType type;
+        uint32_t timestamp_ms; ///< millis() of the first edge of the press, or of the repeat
+    };
+
+    ButtonInterface();
+
+    /**
+     * @brief Create the queue and input task, then attach the pin interrupts
+     *
+     * Pins must already be configured (Input::configureButtons()). Also
+     * registers the buttons as light-sleep wakeup sources.
+     */
+    void begin();
+
+    /**
+     * @brief Take the oldest queued event
+     *
+     * The calling task is notified (xTaskNotifyGive) whenever an event is
+     * queued from then on.
+     *
+     * @return false if the queue is empty
+     */
+    bool receiveEvent(Event& event);
+
+    /**
+     * @brief Debounced state of a button
+     */
+    bool isHeld(uint8_t button) const;
+
+private:
+    static constexpr uint8_t NUM_BUTTONS = 3;
+    static constexpr uint32_t DEBOUNCE_MS = 5;          ///< Pin must be quiet this long to count
+    static constexpr uint32_t LONG_PRESS_MS = 600;
+    static constexpr uint32_t REPEAT_DELAY_MS = 400;    ///< Hold before the first repeat
+    static constexpr uint32_t REPEAT_INTERVAL_MS = 150;
+    static constexpr UBaseType_t QUEUE_DEPTH = 16;
+
+    struct Button {
+        ButtonInterface* owner;
+        uint8_t pin;
+        uint8_t pressed_level;
+        bool repeats;                    ///< Auto-repeat while held (navigation buttons)
+
+        // Written by the ISR, read under _mux
+        volatile bool edge_pending;
+        volatile uint32_t first_edge_ms; ///< Start of the current burst of edges
+        volatile uint32_t last_edge_ms;
+
+        // Input task only
+        volatile bool held;              ///< Also read by isHeld()
+        uint32_t pressed_at_ms;
+        uint32_t next_repeat_ms;
+        bool long_press_sent;
+    };
+
+    Button _buttons[NUM_BUTTONS];
+    QueueHandle_t _queue;
+    TaskHandle_t _task;
+    volatile TaskHandle_t _receiver; ///< Task seen calling receiveEvent(), notified per event
+    portMUX_TYPE _mux;
+
+    static void _edge_isr(void* arg);
+    static void _task_function(void* arg);
+
+    /**
+     * @brief Debounce and classify one button, queueing any events
+     */
+    void _service(Button& button, uint32_t now);
+
+    /**
+     * @brief How long the input task may sleep before a deadline is due
+     * @return portMAX_DELAY if no button is bouncing or held
+     */
+    TickType_t _next_wait(uint32_t now);
+
+    void _send(const Button& button, EventType type, uint32_t timestamp_ms);
+};
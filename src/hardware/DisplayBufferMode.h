@@ -0,0 +1,57 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Where LVGL's draw buffers live and how LVGL renders into them
+ *
+ * The trade-off is internal SRAM against frame time:
+ * - FULL_PSRAM keeps the whole screen double buffered without touching
+ *   internal RAM, but LVGL draws through the PSRAM cache.
+ * - STRIPS_INTERNAL draws into fast internal DMA-capable RAM, but a large
+ *   dirty area is rendered and sent strip by strip.
+ * - DIRECT_SINGLE keeps one screen-sized buffer in PSRAM that always holds
+ *   the current frame, so only dirty areas are redrawn and sent. Drawing
+ *   can't overlap the transfer.
+ *
+ * The build default comes from -DDISPLAY_BUFFER_MODE=<name>. A mode saved
+ * through the portal replaces it from the next boot.
+ */
+enum class DisplayBufferMode : uint8_t {
+    FULL_PSRAM,      ///< Two screen-sized buffers in PSRAM, partial rendering
+    STRIPS_INTERNAL, ///< Two strips of buffer_rows rows in internal DMA-capable RAM
+    DIRECT_SINGLE    ///< One screen-sized buffer in PSRAM, LVGL direct mode
+};
+
+#ifndef DISPLAY_BUFFER_MODE
+#define DISPLAY_BUFFER_MODE FULL_PSRAM
+#endif
+
+/**
+ * @brief Buffer mode selected at build time
+ */
+inline DisplayBufferMode defaultDisplayBufferMode() {
+    return DisplayBufferMode::DISPLAY_BUFFER_MODE;
+}
+
+inline const char* displayBufferModeToString(DisplayBufferMode mode) {
+    switch (mode) {
+        case DisplayBufferMode::FULL_PSRAM: return "FULL_PSRAM";
+        case DisplayBufferMode::STRIPS_INTERNAL: return "STRIPS_INTERNAL";
+        case DisplayBufferMode::DIRECT_SINGLE: return "DIRECT_SINGLE";
+        default: return "UNKNOWN";
+    }
+}
+
+/**
+ * @brief Parse a mode name
+ * @return false if the name isn't a mode; mode is left untouched
+ */
+inline bool stringToDisplayBufferMode(const char* str, DisplayBufferMode& mode) {
+    if (!str) return false;
+    if (strcmp(str, "FULL_PSRAM") == 0) { mode = DisplayBufferMode::FULL_PSRAM; return true; }
+    if (strcmp(str, "STRIPS_INTERNAL") == 0) { mode = DisplayBufferMode::STRIPS_INTERNAL; return true; }
+    if (strcmp(str, "DIRECT_SINGLE") == 0) { mode = DisplayBufferMode::DIRECT_SINGLE; return true; }
+    return false;
+}
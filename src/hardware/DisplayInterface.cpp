@@ -1,4 +1,8 @@
 #include "DisplayInterface.h"
+#include "TftFlushBackend.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include "ui/UICallback.h"
 
 // A pointer to the instance for use in static callbacks
 static DisplayInterface* instance = nullptr;
@@ -22,7 +26,17 @@ DisplayInterface::DisplayInterface(
     _display(nullptr),
     _buf1(nullptr),
     _buf2(nullptr),
-    _lvgl_mutex(nullptr) {
+    _buffer_mode(defaultDisplayBufferMode()),
+    _buffer_bytes(0),
+    _flush_backend(nullptr),
+    _owns_flush_backend(false),
+    _flush_done(nullptr),
+    _input_pressed_at_ms(0),
+    _flushing_input_ms(0),
+    _last_input_latency_ms(0),
+    _worst_input_latency_ms(0),
+    _input_events(0),
+    _logged_input_events(0) {
     
     // Store instance for static callbacks
     instance = this;
@@ -34,44 +48,32 @@ DisplayInterface::DisplayInterface(
         return;
     }
     
-    // Allocate display buffers using C++ new operator instead of malloc
-    try {
-        _buf1 = new lv_color_t[_screen_width * _buffer_rows];
-        _buf2 = new lv_color_t[_screen_width * _buffer_rows];
-    } catch (std::bad_alloc&) {
-        Serial.println("Failed to allocate display buffers");
-        // Clean up already allocated resources
-        delete _tft;
-        _tft = nullptr;
-        if (_buf1) {
-            delete[] _buf1;
-            _buf1 = nullptr;
-        }
-        return;
-    }
-    
-    // Create LVGL mutex
-    _lvgl_mutex = xSemaphoreCreateMutex();
-    if (_lvgl_mutex == nullptr) {
-        Serial.println("Could not create mutex");
-        // Clean up already allocated resources
-        delete _tft;
-        _tft = nullptr;
-        delete[] _buf1;
-        _buf1 = nullptr;
-        delete[] _buf2;
-        _buf2 = nullptr;
-        return;
-    }
+    // Draw buffers wait for begin(), once the buffer mode is known
 }
 
 void DisplayInterface::begin() {
     // Check if initialization failed
-    if (!_tft || !_buf1 || !_buf2 || !_lvgl_mutex) {
+    if (!_tft) {
         Serial.println("Cannot initialize display: resources not allocated");
         return;
     }
     
+    size_t internal_before = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    if (!_allocateBuffers(_buffer_mode)) {
+        Serial.printf("Display buffers for %s don't fit, falling back to %s\n",
+                      displayBufferModeToString(_buffer_mode),
+                      displayBufferModeToString(DisplayBufferMode::STRIPS_INTERNAL));
+        _buffer_mode = DisplayBufferMode::STRIPS_INTERNAL;
+        if (!_allocateBuffers(_buffer_mode)) {
+            Serial.println("Failed to allocate display buffers");
+            return;
+        }
+    }
+    size_t internal_after = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    Serial.printf("Display buffers: %s, %u bytes, internal heap free %u -> %u\n",
+                  displayBufferModeToString(_buffer_mode), (unsigned int)_buffer_bytes,
+                  (unsigned int)internal_before, (unsigned int)internal_after);
+    
     // Initialize SPI
     SPI.begin();
     
@@ -92,8 +94,23 @@ void DisplayInterface::begin() {
     
     _tft->fillScreen(ST77XX_BLACK);
     
+    // Hand the panel to the flush backend; nothing else writes to it after this
+    _flush_done = xSemaphoreCreateBinary();
+    if (!_flush_done) {
+        Serial.println("Failed to create flush semaphore");
+        return;
+    }
+    if (!_flush_backend) {
+        _flush_backend = new TftFlushBackend(_tft);
+        _owns_flush_backend = true;
+    }
+    _flush_backend->setCompletionCallback(_flush_complete, this);
+    _flush_backend->begin();
+    Serial.printf("Display flush backend: %s\n", _flush_backend->name());
+    
     // Initialize LVGL
     lv_init();
+    lv_tick_set_cb(_tick_cb);
     
     // Initialize and register display for LVGL v9
     _display = lv_display_create(_screen_width, _screen_height);
@@ -103,14 +120,17 @@ void DisplayInterface::begin() {
     }
     
     lv_display_set_flush_cb(_display, _disp_flush);
+    lv_display_set_flush_wait_cb(_display, _flush_wait);
+    _profiler.begin(_display);
+    _refresh.begin(_display);
     
-    // Set the buffer correctly
+    // Set the buffer correctly; direct mode renders in place in one screen buffer
     lv_display_set_buffers(
         _display, 
         _buf1, 
         _buf2, 
-        _screen_width * _buffer_rows * sizeof(lv_color_t),
-        LV_DISPLAY_RENDER_MODE_PARTIAL
+        _buf2 ? _buffer_bytes / 2 : _buffer_bytes,
+        _buffer_mode == DisplayBufferMode::DIRECT_SINGLE ? LV_DISPLAY_RENDER_MODE_DIRECT : LV_DISPLAY_RENDER_MODE_PARTIAL
     );
     
     // Set screen background to black
@@ -119,72 +139,153 @@ void DisplayInterface::begin() {
     lv_obj_set_style_border_width(lv_scr_act(), 0, 0);
 }
 
-Adafruit_ST7789* DisplayInterface::getDisplay() {
-    return _tft;
+void DisplayInterface::setBufferMode(DisplayBufferMode mode) {
+    _buffer_mode = mode;
 }
 
-void DisplayInterface::handleLVGLTasks() {
-    if (takeMutex()) {
-        lv_timer_handler();
-        giveMutex();
+bool DisplayInterface::_allocateBuffers(DisplayBufferMode mode) {
+    size_t screen_bytes = (size_t)_screen_width * _screen_height * sizeof(lv_color_t);
+    size_t strip_bytes = (size_t)_screen_width * _buffer_rows * sizeof(lv_color_t);
+    
+    switch (mode) {
+        case DisplayBufferMode::FULL_PSRAM:
+            _buf1 = (lv_color_t*)heap_caps_malloc(screen_bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            _buf2 = (lv_color_t*)heap_caps_malloc(screen_bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            _buffer_bytes = 2 * screen_bytes;
+            break;
+        case DisplayBufferMode::STRIPS_INTERNAL:
+            _buf1 = (lv_color_t*)heap_caps_malloc(strip_bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+            _buf2 = (lv_color_t*)heap_caps_malloc(strip_bytes, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+            _buffer_bytes = 2 * strip_bytes;
+            break;
+        case DisplayBufferMode::DIRECT_SINGLE:
+            _buf1 = (lv_color_t*)heap_caps_malloc(screen_bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+            _buffer_bytes = screen_bytes;
+            break;
+    }
+    
+    bool ok = _buf1 && (_buf2 || mode == DisplayBufferMode::DIRECT_SINGLE);
+    if (!ok) {
+        _freeBuffers();
     }
+    return ok;
 }
 
-void DisplayInterface::tickTask(void* arg) {
-    (void)arg;  // Silence unused parameter warning
-    while (1) {
-        lv_tick_inc(10);
-        vTaskDelay(pdMS_TO_TICKS(10));
+void DisplayInterface::_freeBuffers() {
+    if (_buf2) {
+        heap_caps_free(_buf2);
+        _buf2 = nullptr;
     }
+    if (_buf1) {
+        heap_caps_free(_buf1);
+        _buf1 = nullptr;
+    }
+    _buffer_bytes = 0;
 }
 
-bool DisplayInterface::takeMutex(TickType_t timeout) {
-    if (!_lvgl_mutex) {
-        return false;
+void DisplayInterface::setFlushBackend(FlushBackend* backend) {
+    if (_owns_flush_backend) {
+        delete _flush_backend;
     }
-    return xSemaphoreTake(_lvgl_mutex, timeout) == pdTRUE;
+    _flush_backend = backend;
+    _owns_flush_backend = false;
 }
 
-void DisplayInterface::giveMutex() {
-    if (_lvgl_mutex) {
-        xSemaphoreGive(_lvgl_mutex);
+Adafruit_ST7789* DisplayInterface::getDisplay() {
+    return _tft;
+}
+
+uint32_t DisplayInterface::handleLVGLTasks() {
+    UI_THREAD_ASSERT();
+#ifdef INPUT_LATENCY_LOG
+    // Logged here, not on flush completion, so the log isn't part of the latency it reports
+    uint32_t input_events = _input_events;
+    if (input_events != _logged_input_events) {
+        _logged_input_events = input_events;
+        Serial.printf("[DisplayInterface] Button-to-pixel %lu ms (worst %lu ms over %lu presses)\n",
+                      (unsigned long)_last_input_latency_ms, (unsigned long)_worst_input_latency_ms,
+                      (unsigned long)input_events);
     }
+#endif
+    _refresh.apply();
+    return lv_timer_handler();
 }
 
-SemaphoreHandle_t* DisplayInterface::getMutexPtr() {
-    return &_lvgl_mutex;
+uint32_t DisplayInterface::_tick_cb() {
+    return (uint32_t)(esp_timer_get_time() / 1000);
 }
 
 void DisplayInterface::_disp_flush(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map) {
-    if (instance && instance->_tft) {
-        uint32_t w = (area->x2 - area->x1 + 1);
-        uint32_t h = (area->y2 - area->y1 + 1);
-        
-        instance->_tft->startWrite();
-        instance->_tft->setAddrWindow(area->x1, area->y1, w, h);
-        instance->_tft->writePixels((uint16_t*)px_map, w * h);
-        instance->_tft->endWrite();
+    if (!instance || !instance->_flush_backend) {
+        lv_display_flush_ready(disp);
+        return;
+    }
+    
+    uint32_t w = (area->x2 - area->x1 + 1);
+    uint32_t h = (area->y2 - area->y1 + 1);
+    
+    // First complete frame since a button press: that press is on screen once
+    // this flush completes. Handed over before the transfer starts, so the
+    // completion side never races markInputEvent().
+    if (instance->_input_pressed_at_ms && lv_display_flush_is_last(disp)) {
+        instance->_flushing_input_ms = instance->_input_pressed_at_ms;
+        instance->_input_pressed_at_ms = 0;
+    }
+    
+    instance->_profiler.flushStarted(w, h, lv_display_flush_is_last(disp));
+    
+    // Returns once the transfer is queued. LVGL doesn't call flush_ready;
+    // it waits in _flush_wait() when it next needs this buffer.
+    const uint16_t* pixels = (const uint16_t*)px_map;
+    uint32_t stride = w;
+    if (instance->_buffer_mode == DisplayBufferMode::DIRECT_SINGLE) {
+        // px_map is the whole screen buffer; the area sits at its screen position
+        stride = instance->_screen_width;
+        pixels += (size_t)area->y1 * stride + area->x1;
+    }
+    instance->_flush_backend->flush(area->x1, area->y1, w, h, pixels, stride);
+}
+
+void DisplayInterface::_flush_wait(lv_display_t* disp) {
+    (void)disp;
+    if (instance && instance->_flush_done) {
+        instance->_profiler.waitStarted();
+        xSemaphoreTake(instance->_flush_done, portMAX_DELAY);
+        instance->_profiler.waitFinished();
     }
+}
+
+void DisplayInterface::_flush_complete(void* context) {
+    DisplayInterface* self = static_cast<DisplayInterface*>(context);
+    self->_profiler.flushCompleted();
     
-    lv_display_flush_ready(disp);
+    if (self->_flushing_input_ms) {
+        uint32_t latency = millis() - self->_flushing_input_ms;
+        if (latency > self->_worst_input_latency_ms) {
+            self->_worst_input_latency_ms = latency;
+        }
+        self->_last_input_latency_ms = latency;
+        self->_input_events = self->_input_events + 1; // After the figures it counts
+        self->_flushing_input_ms = 0;
+    }
+    
+    // Last, so the buffer isn't reused before the bookkeeping above is done
+    xSemaphoreGive(self->_flush_done);
 }
 
 DisplayInterface::~DisplayInterface() {
     // Free resources in reverse order of allocation
-    if (_lvgl_mutex) {
-        vSemaphoreDelete(_lvgl_mutex);
-        _lvgl_mutex = nullptr;
+    if (_owns_flush_backend) {
+        delete _flush_backend;
     }
+    _flush_backend = nullptr;
     
-    if (_buf2) {
-        delete[] _buf2;  // Using delete[] for array allocations
-        _buf2 = nullptr;
+    if (_flush_done) {
+        vSemaphoreDelete(_flush_done);
+        _flush_done = nullptr;
     }
     
-    if (_buf1) {
-        delete[] _buf1;  // Using delete[] for array allocations
-        _buf1 = nullptr;
-    }
+    _freeBuffers();
     
     if (_tft) {
         delete _tft;
@@ -200,4 +301,11 @@ DisplayInterface::~DisplayInterface() {
 void DisplayInterface::setBrightness(uint8_t brightness) {
     // Update the PWM duty cycle on the backlight pin
     ledcWrite(_backlight_pin, brightness);
+}
+
+void DisplayInterface::markInputEvent(uint32_t pressed_at_ms) {
+    // Keep the earliest unflushed press; 0 is reserved for "none pending"
+    if (_input_pressed_at_ms == 0) {
+        _input_pressed_at_ms = pressed_at_ms ? pressed_at_ms : 1;
+    }
 }
\ No newline at end of file
@@ -6,12 +6,28 @@
 #include <lvgl.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
+#include "FlushBackend.h"
+#include "RenderProfiler.h"
+#include "DisplayBufferMode.h"
+#include "AdaptiveRefresh.h"
 
 /**
  * @brief Interface class for TFT display with LVGL integration
  * 
  * This class manages the initialization and operation of an ST7789 TFT display
  * through SPI and integrates it with the LVGL graphics library.
+ *
+ * Flushes go through a FlushBackend. The default one sends pixels from a
+ * task on the other core, so LVGL renders into one buffer while the other is
+ * still being transferred.
+ *
+ * Every refresh is timed by a RenderProfiler, read by the diagnostics card
+ * and the portal.
+ *
+ * Draw buffers are allocated in begin() according to the DisplayBufferMode.
+ *
+ * LVGL reads its tick from esp_timer, so nothing wakes just to count time.
+ * The UI task sleeps for as long as handleLVGLTasks() says LVGL can wait.
  */
 class DisplayInterface {
 public:
@@ -20,7 +36,8 @@ public:
      * 
      * @param screen_width Width of the display in pixels
      * @param screen_height Height of the display in pixels
-     * @param buffer_rows Number of rows to buffer for LVGL rendering
+     * @param buffer_rows Rows per strip in STRIPS_INTERNAL mode; the other
+     *                    modes always buffer the whole screen
      * @param cs_pin Chip select pin
      * @param dc_pin Data/command pin
      * @param rst_pin Reset pin
@@ -47,44 +64,58 @@ public:
     void begin();
     
     /**
-     * @brief Get the underlying TFT display object
-     * 
-     * @return Adafruit_ST7789* Pointer to the display
+     * @brief Use a different flush backend, e.g. an emulated one
+     *
+     * Call before begin(). The caller keeps ownership. Without one, begin()
+     * creates a TftFlushBackend for the panel.
      */
-    Adafruit_ST7789* getDisplay();
+    void setFlushBackend(FlushBackend* backend);
     
     /**
-     * @brief Process LVGL tasks (should be called regularly)
+     * @brief Choose where the draw buffers live and how LVGL renders
+     *
+     * Call before begin(); the build default applies otherwise. If the
+     * buffers can't be allocated, begin() falls back to STRIPS_INTERNAL.
      */
-    void handleLVGLTasks();
+    void setBufferMode(DisplayBufferMode mode);
     
     /**
-     * @brief FreeRTOS task for LVGL tick handling
-     * 
-     * @param arg Task argument (not used)
+     * @brief Buffer mode in use, after any fallback in begin()
      */
-    static void tickTask(void* arg);
+    DisplayBufferMode getBufferMode() const { return _buffer_mode; }
     
     /**
-     * @brief Acquire the LVGL mutex
+     * @brief Total bytes of draw buffer allocated
+     */
+    size_t getBufferBytes() const { return _buffer_bytes; }
+    
+    /**
+     * @brief Get the underlying TFT display object
      * 
-     * @param timeout Timeout in ticks (default: portMAX_DELAY)
-     * @return true if mutex was acquired
-     * @return false if timeout occurred
+     * @return Adafruit_ST7789* Pointer to the display
+     */
+    Adafruit_ST7789* getDisplay();
+    
+    /**
+     * @brief Process LVGL tasks (should be called regularly)
+     *
+     * UI task only. LVGL has no lock; other tasks go through globalUIDispatch.
+     *
+     * @return ms until LVGL next needs to run, LV_NO_TIMER_READY if no timer
+     *         is running. Anything that invalidates the screen or starts an
+     *         animation afterwards needs another call before sleeping.
      */
-    bool takeMutex(TickType_t timeout = portMAX_DELAY);
+    uint32_t handleLVGLTasks();
     
     /**
-     * @brief Release the LVGL mutex
+     * @brief Keep the fast refresh rate while the active card redraws every loop
      */
-    void giveMutex();
+    void setContinuousUpdates(bool continuous) { _refresh.setContinuousUpdates(continuous); }
     
     /**
-     * @brief Get pointer to the mutex
-     * 
-     * @return SemaphoreHandle_t* Pointer to the mutex
+     * @brief Current LVGL refresh timer period
      */
-    SemaphoreHandle_t* getMutexPtr();
+    uint32_t getRefreshPeriodMs() const { return _refresh.getPeriodMs(); }
     
     /**
      * @brief Set display backlight brightness
@@ -93,6 +124,38 @@ public:
      */
     void setBrightness(uint8_t brightness);
 
+    /**
+     * @brief Note a button press so the next flushed frame reports its latency
+     *
+     * The time from the press to the completion of the first frame flushed
+     * after it is recorded along with the worst case seen since boot. Build
+     * with -DINPUT_LATENCY_LOG to also log each one from handleLVGLTasks().
+     * LVGL task only.
+     *
+     * @param pressed_at_ms millis() timestamp of the debounced press
+     */
+    void markInputEvent(uint32_t pressed_at_ms);
+
+    /**
+     * @brief Button-to-pixel latency of the latest press to reach the screen
+     */
+    uint32_t getLastInputLatencyMs() const { return _last_input_latency_ms; }
+
+    /**
+     * @brief Worst button-to-pixel latency since boot
+     */
+    uint32_t getWorstInputLatencyMs() const { return _worst_input_latency_ms; }
+
+    /**
+     * @brief Presses whose latency has been measured since boot
+     */
+    uint32_t getInputLatencyCount() const { return _input_events; }
+
+    /**
+     * @brief Per-frame render, dirty-area and flush statistics
+     */
+    RenderProfiler& getRenderProfiler() { return _profiler; }
+
 private:
     uint16_t _screen_width;
     uint16_t _screen_height;
@@ -105,8 +168,37 @@ private:
     Adafruit_ST7789* _tft;
     lv_display_t* _display;
     lv_color_t* _buf1;
-    lv_color_t* _buf2;
-    SemaphoreHandle_t _lvgl_mutex;
+    lv_color_t* _buf2;   ///< nullptr in DIRECT_SINGLE mode
+    DisplayBufferMode _buffer_mode;
+    size_t _buffer_bytes;
+    
+    // Flushing
+    FlushBackend* _flush_backend;
+    bool _owns_flush_backend;
+    SemaphoreHandle_t _flush_done;  ///< Given by the backend when a transfer completes
+    RenderProfiler _profiler;
+    AdaptiveRefresh _refresh;
+
+    // Button-to-pixel latency tracking
+    uint32_t _input_pressed_at_ms;  ///< Press waiting for a flush, 0 when none (LVGL task)
+    uint32_t _flushing_input_ms;    ///< Press the in-flight last flush will show, 0 when none
+    volatile uint32_t _last_input_latency_ms;  ///< Written on the completion side only
+    volatile uint32_t _worst_input_latency_ms; ///< Written on the completion side only
+    volatile uint32_t _input_events;           ///< Written on the completion side only
+    uint32_t _logged_input_events;  ///< Presses already logged (LVGL task, INPUT_LATENCY_LOG only)
+    
+    /**
+     * @brief Allocate the draw buffers for a mode
+     * @return false if they don't fit, with nothing left allocated
+     */
+    bool _allocateBuffers(DisplayBufferMode mode);
+    
+    void _freeBuffers();
+    
+    /**
+     * @brief LVGL tick source, milliseconds since boot from esp_timer
+     */
+    static uint32_t _tick_cb();
     
     /**
      * @brief LVGL display flush callback
@@ -117,6 +209,19 @@ private:
      */
     static void _disp_flush(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map);
     
+    /**
+     * @brief LVGL flush wait callback, blocks until the backend completes
+     * 
+     * LVGL only waits when it needs the buffer back, so the UI task sleeps
+     * here instead of spinning on the flushing flag.
+     */
+    static void _flush_wait(lv_display_t* disp);
+    
+    /**
+     * @brief FlushBackend completion callback, may run on the flush task
+     */
+    static void _flush_complete(void* context);
+    
     // Prevent copying
     DisplayInterface(const DisplayInterface&) = delete;
     DisplayInterface& operator=(const DisplayInterface&) = delete;
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @class FlushBackend
+ * @brief Moves rendered RGB565 rectangles from an LVGL draw buffer to a panel
+ *
+ * flush() only has to start the transfer. The backend reports completion
+ * through the callback once the buffer may be reused, which can happen on
+ * another task or core. DisplayInterface keeps at most one flush outstanding,
+ * so LVGL renders into its second buffer while the first is on the wire.
+ */
+class FlushBackend {
+public:
+    /**
+     * @brief Called when the last flushed buffer may be reused
+     * @param context Pointer passed to setCompletionCallback()
+     */
+    typedef void (*CompletionCallback)(void* context);
+
+    FlushBackend() : _on_done(nullptr), _on_done_context(nullptr) {}
+    virtual ~FlushBackend() {}
+
+    /**
+     * @brief Set the callback that signals transfer completion
+     *
+     * Must be set before the first flush().
+     */
+    void setCompletionCallback(CompletionCallback callback, void* context) {
+        _on_done = callback;
+        _on_done_context = context;
+    }
+
+    /**
+     * @brief Prepare queues, tasks or threads
+     * @return false if the backend can only flush synchronously
+     *
+     * A backend that failed to start must still accept flush() calls, it
+     * just finishes them before returning.
+     */
+    virtual bool begin() = 0;
+
+    /**
+     * @brief Start sending a rectangle
+     *
+     * @param x Left edge in display coordinates
+     * @param y Top edge in display coordinates
+     * @param w Width in pixels
+     * @param h Height in pixels
+     * @param pixels First RGB565 pixel of the rectangle, left untouched until completion
+     * @param stride Pixels from one row to the next: w for a packed
+     *               rectangle, the screen width for a direct mode buffer
+     */
+    virtual void flush(int32_t x, int32_t y, uint32_t w, uint32_t h, const uint16_t* pixels, uint32_t stride) = 0;
+
+    /**
+     * @brief Short name for logs
+     */
+    virtual const char* name() const = 0;
+
+protected:
+    /**
+     * @brief Report that the buffer handed to flush() has been sent
+     */
+    void _signal_done() {
+        if (_on_done) {
+            _on_done(_on_done_context);
+        }
+    }
+
+private:
+    CompletionCallback _on_done;
+    void* _on_done_context;
+};
@@ -0,0 +1,194 @@
+#include "RenderProfiler.h"
+#include <string.h>
+
+RenderProfiler::RenderProfiler()
+    : _mutex(nullptr),
+      _screen_px(0),
+      _refresh_started_us(0),
+      _wait_started_us(0),
+      _transfer_started_us(0),
+      _transfer_last(false),
+      _closing_ready(false),
+      _last_transfer_done(false),
+      _flush_us(0),
+      _total_frames(0) {
+    memset(&_open, 0, sizeof(_open));
+    memset(&_closing, 0, sizeof(_closing));
+    memset(_frames, 0, sizeof(_frames));
+}
+
+RenderProfiler::~RenderProfiler() {
+    if (_mutex) {
+        vSemaphoreDelete(_mutex);
+        _mutex = nullptr;
+    }
+}
+
+bool RenderProfiler::begin(lv_display_t* display) {
+    if (!display) {
+        return false;
+    }
+
+    _mutex = xSemaphoreCreateMutex();
+    if (!_mutex) {
+        Serial.println("[RenderProfiler] Failed to create mutex");
+        return false;
+    }
+
+    _screen_px = (uint32_t)lv_display_get_horizontal_resolution(display) *
+                 (uint32_t)lv_display_get_vertical_resolution(display);
+
+    lv_display_add_event_cb(display, _event_cb, LV_EVENT_INVALIDATE_AREA, this);
+    lv_display_add_event_cb(display, _event_cb, LV_EVENT_REFR_START, this);
+    lv_display_add_event_cb(display, _event_cb, LV_EVENT_REFR_READY, this);
+    return true;
+}
+
+void RenderProfiler::_event_cb(lv_event_t* e) {
+    RenderProfiler* self = static_cast<RenderProfiler*>(lv_event_get_user_data(e));
+    if (!self || !self->_mutex) return;
+
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_INVALIDATE_AREA: {
+            // Already clipped to the screen; LVGL drops or merges it afterwards
+            const lv_area_t* area = static_cast<const lv_area_t*>(lv_event_get_param(e));
+            if (area) {
+                if (self->_open.invalidated < UINT16_MAX) self->_open.invalidated++;
+                self->_open.invalidated_px += lv_area_get_size(area);
+            }
+            break;
+        }
+        case LV_EVENT_REFR_START:
+            self->_refreshStarted();
+            break;
+        case LV_EVENT_REFR_READY:
+            self->_refreshReady();
+            break;
+        default:
+            break;
+    }
+}
+
+void RenderProfiler::_refreshStarted() {
+    _refresh_started_us = micros();
+    _open.at_ms = millis();
+    _open.flush_wait_us = 0;
+}
+
+void RenderProfiler::_refreshReady() {
+    // Only sent for refreshes that drew something
+    uint32_t elapsed = micros() - _refresh_started_us;
+    _open.render_us = elapsed > _open.flush_wait_us ? elapsed - _open.flush_wait_us : 0;
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    _closing = _open;
+    _closing_ready = true;
+    if (_last_transfer_done) {
+        // Synchronous backend, or the transfer beat LVGL to the end of the refresh
+        _commitClosing();
+    }
+    xSemaphoreGive(_mutex);
+
+    memset(&_open, 0, sizeof(_open));
+}
+
+void RenderProfiler::flushStarted(uint32_t w, uint32_t h, bool last) {
+    if (!_mutex) return;
+    if (_open.flushed_areas < UINT16_MAX) _open.flushed_areas++;
+    _open.bytes_flushed += w * h * sizeof(lv_color_t);
+    _transfer_last = last;
+    _transfer_started_us = micros();
+}
+
+void RenderProfiler::flushCompleted() {
+    if (!_mutex) return;
+    uint32_t elapsed = micros() - _transfer_started_us;
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    _flush_us += elapsed;
+    if (_transfer_last) {
+        _last_transfer_done = true;
+        if (_closing_ready) {
+            _commitClosing();
+        }
+    }
+    xSemaphoreGive(_mutex);
+}
+
+void RenderProfiler::_commitClosing() {
+    _closing.flush_us = _flush_us;
+    _frames[_total_frames % CAPACITY] = _closing;
+    _total_frames++;
+
+    _flush_us = 0;
+    _closing_ready = false;
+    _last_transfer_done = false;
+}
+
+void RenderProfiler::waitStarted() {
+    _wait_started_us = micros();
+}
+
+void RenderProfiler::waitFinished() {
+    _open.flush_wait_us += micros() - _wait_started_us;
+}
+
+void RenderProfiler::recordDispatch(uint32_t us) {
+    _open.dispatch_us += us;
+}
+
+size_t RenderProfiler::getFrames(Frame* out, size_t max_frames) const {
+    if (!_mutex || !out) return 0;
+
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    size_t available = _total_frames < CAPACITY ? _total_frames : CAPACITY;
+    size_t count = available < max_frames ? available : max_frames;
+    // The newest `count` frames, oldest of them first
+    uint32_t first = _total_frames - count;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = _frames[(first + i) % CAPACITY];
+    }
+    xSemaphoreGive(_mutex);
+    return count;
+}
+
+RenderProfiler::Summary RenderProfiler::getSummary() const {
+    Summary summary;
+    memset(&summary, 0, sizeof(summary));
+    if (!_mutex) return summary;
+
+    // Walked in place; a copy of the ring is too big for some callers' stacks
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+    size_t count = _total_frames < CAPACITY ? _total_frames : CAPACITY;
+    uint32_t first = _total_frames - count;
+    uint64_t render = 0, flush = 0, wait = 0, dispatch = 0, dirty = 0, bytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        const Frame& frame = _frames[(first + i) % CAPACITY];
+        render += frame.render_us;
+        flush += frame.flush_us;
+        wait += frame.flush_wait_us;
+        dispatch += frame.dispatch_us;
+        dirty += frame.invalidated_px;
+        bytes += frame.bytes_flushed;
+        if (frame.render_us > summary.max_render_us) summary.max_render_us = frame.render_us;
+        if (frame.flush_us > summary.max_flush_us) summary.max_flush_us = frame.flush_us;
+        if (frame.dispatch_us > summary.max_dispatch_us) summary.max_dispatch_us = frame.dispatch_us;
+    }
+    if (count > 0) {
+        summary.span_ms = _frames[(_total_frames - 1) % CAPACITY].at_ms - _frames[first % CAPACITY].at_ms;
+    }
+    summary.total_frames = _total_frames;
+    xSemaphoreGive(_mutex);
+
+    if (count == 0) {
+        return summary;
+    }
+    summary.frames = count;
+    summary.avg_render_us = render / count;
+    summary.avg_flush_us = flush / count;
+    summary.avg_flush_wait_us = wait / count;
+    summary.avg_dispatch_us = dispatch / count;
+    summary.avg_invalidated_px = dirty / count;
+    summary.avg_bytes_flushed = bytes / count;
+    return summary;
+}
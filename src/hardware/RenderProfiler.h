@@ -0,0 +1,134 @@
+#pragma once
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+/**
+ * @class RenderProfiler
+ * @brief Per-frame timing and dirty-area statistics for one LVGL display
+ *
+ * Splits the cost of each refresh into the pieces that can make a card
+ * janky: UI dispatch work run since the last refresh, LVGL drawing, time
+ * blocked on the flush backend, and the transfer itself. It also records how
+ * much of the screen was invalidated and how many bytes went to the panel.
+ *
+ * The display driver calls the hooks below; LVGL's own display events supply
+ * the refresh boundaries and invalidated areas. The last transfer of a frame
+ * usually completes after LVGL has moved on, so a frame reaches the ring
+ * buffer once that transfer is done.
+ *
+ * Hooks are LVGL task only, except flushCompleted(). Readers on any task get
+ * copies.
+ */
+class RenderProfiler {
+public:
+    struct Frame {
+        uint32_t at_ms;          ///< millis() when the refresh started
+        uint32_t render_us;      ///< Refresh time minus flush waits: layout and drawing
+        uint32_t flush_wait_us;  ///< Time the refresh blocked on the flush backend
+        uint32_t flush_us;       ///< Transfer time of this frame's areas
+        uint32_t dispatch_us;    ///< UI queue work run since the previous refresh
+        uint16_t invalidated;    ///< Areas invalidated, before LVGL merges them
+        uint16_t flushed_areas;  ///< Areas sent to the panel
+        uint32_t invalidated_px; ///< Total size of the invalidated areas
+        uint32_t bytes_flushed;
+    };
+
+    /**
+     * @brief Averages and peaks over the frames in the ring buffer
+     */
+    struct Summary {
+        uint32_t frames;          ///< Frames in the buffer
+        uint32_t total_frames;    ///< Frames recorded since boot
+        uint32_t span_ms;         ///< From the oldest frame to the newest
+        uint32_t avg_render_us;
+        uint32_t max_render_us;
+        uint32_t avg_flush_us;
+        uint32_t max_flush_us;
+        uint32_t avg_flush_wait_us;
+        uint32_t avg_dispatch_us;
+        uint32_t max_dispatch_us;
+        uint32_t avg_invalidated_px;
+        uint32_t avg_bytes_flushed;
+    };
+
+    static constexpr size_t CAPACITY = 64; ///< Frames kept, a few seconds of animation
+
+    RenderProfiler();
+    ~RenderProfiler();
+
+    /**
+     * @brief Register for the display's refresh and invalidation events
+     * @return false if the profiler couldn't be set up; it then records nothing
+     */
+    bool begin(lv_display_t* display);
+
+    /**
+     * @brief A rectangle is about to be handed to the flush backend
+     * @param last Whether it is the frame's last area
+     */
+    void flushStarted(uint32_t w, uint32_t h, bool last);
+
+    /**
+     * @brief The flush backend finished the rectangle; any task
+     */
+    void flushCompleted();
+
+    /**
+     * @brief Bracket a wait for the flush backend
+     */
+    void waitStarted();
+    void waitFinished();
+
+    /**
+     * @brief Time spent running UI dispatch queue work
+     */
+    void recordDispatch(uint32_t us);
+
+    /**
+     * @brief Copy recorded frames, oldest first
+     * @return Number of frames copied
+     */
+    size_t getFrames(Frame* out, size_t max_frames) const;
+
+    Summary getSummary() const;
+
+    /**
+     * @brief Screen size in pixels, for dirty-area percentages
+     */
+    uint32_t getScreenPixels() const { return _screen_px; }
+
+private:
+    SemaphoreHandle_t _mutex;
+    uint32_t _screen_px;
+
+    // LVGL task only
+    Frame _open;                   ///< Frame being accumulated
+    uint32_t _refresh_started_us;
+    uint32_t _wait_started_us;
+    uint32_t _transfer_started_us; ///< Read by flushCompleted(); never two transfers at once
+    bool _transfer_last;
+
+    // Under _mutex
+    Frame _closing;            ///< Rendered frame waiting for its last transfer
+    bool _closing_ready;
+    bool _last_transfer_done;
+    uint32_t _flush_us;        ///< Transfer time not yet attributed to a frame
+    Frame _frames[CAPACITY];
+    uint32_t _total_frames;
+
+    static void _event_cb(lv_event_t* e);
+    void _refreshStarted();
+    void _refreshReady();
+
+    /**
+     * @brief Move the closing frame into the ring; caller holds _mutex
+     */
+    void _commitClosing();
+
+    // Prevent copying
+    RenderProfiler(const RenderProfiler&) = delete;
+    RenderProfiler& operator=(const RenderProfiler&) = delete;
+};
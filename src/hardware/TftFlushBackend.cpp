@@ -0,0 +1,83 @@
+#include "TftFlushBackend.h"
+
+TftFlushBackend::TftFlushBackend(Adafruit_ST7789* tft)
+    : _tft(tft), _queue(nullptr), _task(nullptr) {
+}
+
+TftFlushBackend::~TftFlushBackend() {
+    if (_task) {
+        vTaskDelete(_task);
+        _task = nullptr;
+    }
+    if (_queue) {
+        vQueueDelete(_queue);
+        _queue = nullptr;
+    }
+}
+
+bool TftFlushBackend::begin() {
+    _queue = xQueueCreate(QUEUE_DEPTH, sizeof(Transfer));
+    if (!_queue) {
+        Serial.println("[TftFlushBackend] Failed to create transfer queue, flushing synchronously");
+        return false;
+    }
+
+    // Core 0, away from the LVGL task, so rendering and SPI really overlap.
+    // Above the network tasks there so a frame isn't held up behind a parse.
+    if (xTaskCreatePinnedToCore(_task_function, "flushTask", 3072, this, 3, &_task, 0) != pdPASS) {
+        Serial.println("[TftFlushBackend] Failed to create flush task, flushing synchronously");
+        vQueueDelete(_queue);
+        _queue = nullptr;
+        _task = nullptr;
+        return false;
+    }
+
+    Serial.println("[TftFlushBackend] Queued flush running on core 0");
+    return true;
+}
+
+void TftFlushBackend::flush(int32_t x, int32_t y, uint32_t w, uint32_t h, const uint16_t* pixels, uint32_t stride) {
+    Transfer transfer;
+    transfer.x = x;
+    transfer.y = y;
+    transfer.w = w;
+    transfer.h = h;
+    transfer.pixels = pixels;
+    transfer.stride = stride;
+
+    if (!_queue) {
+        _write(transfer);
+        return;
+    }
+
+    // Never blocks in practice: LVGL waits for each completion before the next flush
+    xQueueSend(_queue, &transfer, portMAX_DELAY);
+}
+
+void TftFlushBackend::_task_function(void* arg) {
+    TftFlushBackend* self = static_cast<TftFlushBackend*>(arg);
+    Transfer transfer;
+
+    while (1) {
+        if (xQueueReceive(self->_queue, &transfer, portMAX_DELAY) == pdTRUE) {
+            self->_write(transfer);
+        }
+    }
+}
+
+void TftFlushBackend::_write(const Transfer& transfer) {
+    if (_tft) {
+        _tft->startWrite();
+        _tft->setAddrWindow(transfer.x, transfer.y, transfer.w, transfer.h);
+        if (transfer.stride == transfer.w) {
+            _tft->writePixels(const_cast<uint16_t*>(transfer.pixels), transfer.w * transfer.h);
+        } else {
+            // Direct mode: the rectangle's rows are spread across the screen buffer
+            for (uint32_t row = 0; row < transfer.h; row++) {
+                _tft->writePixels(const_cast<uint16_t*>(transfer.pixels + row * transfer.stride), transfer.w);
+            }
+        }
+        _tft->endWrite();
+    }
+    _signal_done();
+}
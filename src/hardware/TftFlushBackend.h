@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_ST7789.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "FlushBackend.h"
+
+/**
+ * @class TftFlushBackend
+ * @brief Queued ST7789 flush running on the core LVGL doesn't render on
+ *
+ * flush() queues the rectangle and returns straight away. A flush task pinned
+ * to core 0 sets the address window, pushes the pixels over SPI and signals
+ * completion when the write returns, while the UI task on core 1 carries on
+ * rendering into the other draw buffer.
+ *
+ * Only the flush task touches the panel once begin() has run.
+ */
+class TftFlushBackend : public FlushBackend {
+public:
+    /**
+     * @param tft Initialised panel, owned by the caller
+     */
+    explicit TftFlushBackend(Adafruit_ST7789* tft);
+    ~TftFlushBackend() override;
+
+    bool begin() override;
+    void flush(int32_t x, int32_t y, uint32_t w, uint32_t h, const uint16_t* pixels, uint32_t stride) override;
+    const char* name() const override { return "tft-queued"; }
+
+private:
+    static constexpr UBaseType_t QUEUE_DEPTH = 2; ///< LVGL has one flush outstanding; one spare
+
+    struct Transfer {
+        int32_t x;
+        int32_t y;
+        uint32_t w;
+        uint32_t h;
+        const uint16_t* pixels;
+        uint32_t stride;
+    };
+
+    Adafruit_ST7789* _tft;
+    QueueHandle_t _queue;
+    TaskHandle_t _task;
+
+    static void _task_function(void* arg);
+
+    /**
+     * @brief Blocking write of one rectangle, then signal completion
+     */
+    void _write(const Transfer& transfer);
+};
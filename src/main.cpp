@@ -27,6 +27,7 @@
 #include "ui/CardNavigationStack.h"
 #include "ui/InsightCard.h"
 #include "hardware/Input.h"
+#include "hardware/ButtonInterface.h"
 #include "posthog/PostHogClient.h"
 #include "Style.h"
 #include "esp_heap_caps.h" // For PSRAM management
@@ -42,7 +43,7 @@
 #define SCREEN_HEIGHT 135
 
 // LVGL display buffer size
-#define LVGL_BUFFER_ROWS 135  // Full screen height
+#define LVGL_BUFFER_ROWS 27   // Strip height in STRIPS_INTERNAL mode, a fifth of the screen
 
 // Button configuration
 #define NUM_BUTTONS 3
@@ -57,6 +58,7 @@ Bounce2::Button buttons[NUM_BUTTONS];
 
 // Global objects
 DisplayInterface* displayInterface;
+ButtonInterface* buttonInterface;
 ConfigManager* configManager;
 WiFiInterface* wifiInterface;
 CaptivePortal* captivePortal;
@@ -75,6 +77,11 @@ TaskHandle_t neoPixelTask;
 // WiFi connection timeout in milliseconds
 #define WIFI_TIMEOUT 30000
 
+// Longest the UI task sleeps when LVGL has no timer running
+#define UI_IDLE_MAX_MS 1000
+// UI loop period while the active card updates every loop (games)
+#define UI_CONTINUOUS_MS 5
+
 // WiFi task that handles WiFi operations
 void wifiTaskFunction(void* parameter) {
     while (1) {
@@ -90,6 +97,7 @@ void wifiTaskFunction(void* parameter) {
 void portalTaskFunction(void* parameter) {
     while (1) {
         captivePortal->processAsyncOperations(); // Process pending portal actions
+        configManager->process(); // Write out settings once they've settled
         // Delay to prevent hogging CPU
         vTaskDelay(pdMS_TO_TICKS(100)); // Check for operations every 100ms
     }
@@ -103,71 +111,109 @@ void insightTaskFunction(void* parameter) {
     }
 }
 
-// LVGL handler task that includes button polling - added here to consolidate UI operations
-void lvglHandlerTask(void* parameter) {
-    TickType_t lastButtonCheck = xTaskGetTickCount();
-    const TickType_t buttonCheckInterval = pdMS_TO_TICKS(50); // Check buttons every 50ms
-    
+// Deliver queued button events to the card stack
+// Returns true while the power-off combo is being held, which is timed by polling
+static bool deliverButtonEvents() {
     static unsigned long powerOffPressStartTime = 0;
-    // static bool upPressedState = false; // Unused
-    // static bool downPressedState = false; // Unused
 
-    while (1) {
-        // Handle LVGL tasks
-        displayInterface->handleLVGLTasks();
+    // Polled Bounce2 state for the games that read buttons[] directly;
+    // presses themselves arrive through the interrupt-driven queue
+    Input::update();
 
-        cardController->processUIQueue();
-        
-        // Poll buttons at regular intervals
-        TickType_t currentTime = xTaskGetTickCount();
-        if ((currentTime - lastButtonCheck) >= buttonCheckInterval) {
-            lastButtonCheck = currentTime;
-            
-            // Update all buttons first
-            for (int i = 0; i < NUM_BUTTONS; i++) {
-                buttons[i].update();
-            }
+    bool centerButtonHeld = buttonInterface->isHeld(Input::BUTTON_CENTER);
+    bool downButtonHeld = buttonInterface->isHeld(Input::BUTTON_DOWN);
 
-            // Get current state of UP and DOWN buttons
-            // BUTTON_UP is pressed when HIGH (INPUT_PULLDOWN)
-            // BUTTON_DOWN is pressed when LOW (INPUT_PULLUP)
-            bool centerButtonHeld = (buttons[Input::BUTTON_CENTER].read() == HIGH);
-            bool downButtonHeld = (buttons[Input::BUTTON_DOWN].read() == LOW);
-
-            if (centerButtonHeld && downButtonHeld) {
-                if (powerOffPressStartTime == 0) { // Both pressed, start timer
-                    powerOffPressStartTime = millis();
-                } else {
-                    if (millis() - powerOffPressStartTime >= 2000) { // Held for 2 seconds
-                        Serial.println("Simultaneous CENTER and DOWN hold for 2s detected. Entering deep sleep.");
-                        // Optional: Turn off display backlight or other peripherals before sleep
-                        // displayInterface->setBacklight(0); // Example if such a function exists
-                        esp_deep_sleep_start();
-                    }
-                }
-            } else {
-                // If either button is released or not simultaneously pressed, reset the timer
-                powerOffPressStartTime = 0;
-
-                // Process individual button presses if power-off sequence is not active or completed.
-                // Check .pressed() for single press actions (triggers on state change).
-                // This ensures that navigation still works if the power-off combo isn't fully executed.
-                if (buttons[Input::BUTTON_UP].pressed()) {
-                    // Ensure this doesn't trigger if it was part of the combo that just got released
-                    // However, .pressed() fires on the transition, so if it was held and released, 
-                    // it won't fire again here unless pressed again separately.
-                    cardController->getCardStack()->handleButtonPress(Input::BUTTON_UP);
-                }
-                if (buttons[Input::BUTTON_DOWN].pressed()) {
-                    cardController->getCardStack()->handleButtonPress(Input::BUTTON_DOWN);
-                }
-                if (buttons[Input::BUTTON_CENTER].pressed()) {
-                    cardController->getCardStack()->handleButtonPress(Input::BUTTON_CENTER);
-                }
+    if (centerButtonHeld && downButtonHeld) {
+        if (powerOffPressStartTime == 0) { // Both pressed, start timer
+            powerOffPressStartTime = millis();
+        } else {
+            if (millis() - powerOffPressStartTime >= 2000) { // Held for 2 seconds
+                Serial.println("Simultaneous CENTER and DOWN hold for 2s detected. Entering deep sleep.");
+                // Optional: Turn off display backlight or other peripherals before sleep
+                // displayInterface->setBacklight(0); // Example if such a function exists
+                configManager->flush(); // Settings still waiting for their quiet period
+                esp_deep_sleep_start();
             }
         }
+    } else {
+        // If either button is released or not simultaneously pressed, reset the timer
+        powerOffPressStartTime = 0;
+    }
+
+    ButtonInterface::Event event;
+    while (buttonInterface->receiveEvent(event)) {
+        if (centerButtonHeld && downButtonHeld) {
+            continue; // Part of the power-off combo, not navigation
+        }
+        if (event.type == ButtonInterface::EventType::LONG_PRESS) {
+            cardController->getCardStack()->handleLongPress(event.button);
+        } else {
+            // Timestamped at the first edge, so this covers the whole input path
+            displayInterface->markInputEvent(event.timestamp_ms);
+            cardController->getCardStack()->handleButtonPress(event.button);
+        }
+    }
+    return powerOffPressStartTime != 0;
+}
+
+// LVGL handler task, also delivers button events so all UI work stays on one task
+void lvglHandlerTask(void* parameter) {
+    // From here on only this task touches LVGL; others use globalUIDispatch
+    claimUIThread();
+
+    // Load report: how often this task wakes, what woke it, and how much of
+    // the time it's busy
+    const uint32_t loadReportIntervalMs = 10000;
+    uint32_t loadWindowStartMs = millis();
+    uint32_t loadWakeups = 0;
+    uint32_t loadNotified = 0;
+    uint32_t loadBusyUs = 0;
+
+    while (1) {
+        uint32_t wakeUs = micros();
+
+        // Input first, so a press isn't stuck behind a slice of UI updates
+        bool powerOffHeld = deliverButtonEvents();
+
+        // One time-boxed slice of UI updates; whatever is left waits for the next
+        // iteration so a refresh storm can't hold up input or drawing
+        bool uiWorkPending = cardController->processUIQueue();
+        bool continuous = cardController->isActiveCardContinuous();
+        displayInterface->setContinuousUpdates(continuous);
+
+        // LVGL last, so what input and the queue just changed is drawn now and
+        // the returned deadline covers any animation they started
+        uint32_t lvglIdleMs = displayInterface->handleLVGLTasks();
         
-        vTaskDelay(pdMS_TO_TICKS(5));
+        loadBusyUs += micros() - wakeUs;
+        loadWakeups++;
+        uint32_t loadWindowMs = millis() - loadWindowStartMs;
+        if (loadWindowMs >= loadReportIntervalMs) {
+            Serial.printf("[LVGL] UI task busy %lu.%lu%% over %lu ms, %lu wakeups (%lu.%lu/s, %lu for input or UI updates), refresh %lu ms\n",
+                          (unsigned long)(loadBusyUs / (loadWindowMs * 10)),
+                          (unsigned long)((loadBusyUs / loadWindowMs) % 10),
+                          (unsigned long)loadWindowMs, (unsigned long)loadWakeups,
+                          (unsigned long)(loadWakeups * 1000 / loadWindowMs),
+                          (unsigned long)(loadWakeups * 10000 / loadWindowMs % 10),
+                          (unsigned long)loadNotified,
+                          (unsigned long)displayInterface->getRefreshPeriodMs());
+            loadWindowStartMs = millis();
+            loadWakeups = 0;
+            loadNotified = 0;
+            loadBusyUs = 0;
+        }
+        
+        // Sleep until LVGL's next timer is due; button events and UI updates
+        // notify this task and end the sleep early. Games and the power-off
+        // hold poll, and a backed-up queue only yields.
+        uint32_t sleepMs = lvglIdleMs < UI_IDLE_MAX_MS ? lvglIdleMs : UI_IDLE_MAX_MS;
+        if ((continuous || powerOffHeld) && sleepMs > UI_CONTINUOUS_MS) {
+            sleepMs = UI_CONTINUOUS_MS;
+        }
+        TickType_t sleepTicks = uiWorkPending ? 1 : pdMS_TO_TICKS(sleepMs);
+        if (ulTaskNotifyTake(pdTRUE, sleepTicks > 0 ? sleepTicks : 1) > 0) {
+            loadNotified++;
+        }
     }
 }
 
@@ -259,6 +305,8 @@ void setup() {
         SCREEN_WIDTH, SCREEN_HEIGHT, LVGL_BUFFER_ROWS, 
         TFT_CS, TFT_DC, TFT_RST, TFT_BACKLITE
     );
+    // A mode saved from the portal overrides the build default
+    displayInterface->setBufferMode(configManager->getDisplayBufferMode(defaultDisplayBufferMode()));
     displayInterface->begin();
     
     // Initialize WiFi manager with event queue
@@ -268,12 +316,10 @@ void setup() {
     // Initialize buttons
     Input::configureButtons();
     
-    // Configure GPIO wakeup for buttons to wake from light sleep
-    gpio_wakeup_enable((gpio_num_t)Input::BUTTON_UP, GPIO_INTR_HIGH_LEVEL);
-    gpio_wakeup_enable((gpio_num_t)Input::BUTTON_DOWN, GPIO_INTR_LOW_LEVEL);  
-    gpio_wakeup_enable((gpio_num_t)Input::BUTTON_CENTER, GPIO_INTR_HIGH_LEVEL);
-    esp_sleep_enable_gpio_wakeup();
-    Serial.println("GPIO wakeup configured for buttons");
+    // Button interrupts feed a timestamped event queue and double as the
+    // light sleep wakeup sources
+    buttonInterface = new ButtonInterface();
+    buttonInterface->begin();
     
     // Create and initialize card controller
     cardController = new CardController(
@@ -290,7 +336,7 @@ void setup() {
     cardController->initialize(displayInterface);
     
     // Initialize OtaManager
-    otaManager = new OtaManager(CURRENT_FIRMWARE_VERSION, "PostHog", "DeskHog");
+    otaManager = new OtaManager(*configManager, CURRENT_FIRMWARE_VERSION, "PostHog", "DeskHog");
     
     // Initialize captive portal
     captivePortal = new CaptivePortal(*configManager, *wifiInterface, *eventQueue, *otaManager, *cardController);
@@ -329,18 +375,7 @@ void setup() {
         0
     );
     
-    // Create LVGL tick task
-    xTaskCreatePinnedToCore(
-        DisplayInterface::tickTask,
-        "lv_tick_task",
-        2048,
-        NULL,
-        1,
-        NULL,
-        1
-    );
-    
-    // Create LVGL handler task (now includes button polling)
+    // Create LVGL handler task (also delivers button events)
     xTaskCreatePinnedToCore(
         lvglHandlerTask,
         "lvglTask",
@@ -0,0 +1,112 @@
+#include "InsightModel.h"
+#include <algorithm>
+
+const double* InsightModel::seriesData(size_t series_index) const {
+    size_t offset = 0;
+    for (size_t i = 0; i < series_index; ++i) {
+        offset += series_lengths[i];
+    }
+    return series_values.data() + offset;
+}
+
+bool InsightModel::fromParser(const InsightParser& parser, InsightModel& model) {
+    if (!parser.isValid()) return false;
+
+    model.type = parser.getInsightType();
+
+    char title_buffer[64];
+    if (!parser.getName(title_buffer, sizeof(title_buffer))) {
+        strcpy(title_buffer, "Insight");
+    }
+    model.title = title_buffer;
+
+    switch (model.type) {
+        case InsightParser::InsightType::NUMERIC_CARD: {
+            char prefix_buffer[16] = "";
+            char suffix_buffer[16] = "";
+            parser.getNumericFormattingPrefix(prefix_buffer, sizeof(prefix_buffer));
+            parser.getNumericFormattingSuffix(suffix_buffer, sizeof(suffix_buffer));
+            model.numeric_value = parser.getNumericCardValue();
+            model.prefix = prefix_buffer;
+            model.suffix = suffix_buffer;
+            return true;
+        }
+
+        case InsightParser::InsightType::LINE_GRAPH:
+        case InsightParser::InsightType::AREA_CHART: {
+            model.series_count = std::min(parser.getSeriesCount(), static_cast<size_t>(MAX_SERIES));
+            size_t total = 0;
+            for (size_t s = 0; s < model.series_count; ++s) {
+                model.series_lengths[s] = parser.getSeriesPointCount(s);
+                total += model.series_lengths[s];
+                if (parser.isSeriesPreviousPeriod(s)) {
+                    model.series_previous_mask |= (1 << s);
+                }
+            }
+
+            model.series_values.resize(total);
+            size_t offset = 0;
+            for (size_t s = 0; s < model.series_count; ++s) {
+                if (model.series_lengths[s] > 0 &&
+                    !parser.getSeriesYValues(model.series_values.data() + offset, s)) {
+                    Serial.printf("[InsightModel] Failed to extract series %u\n", (unsigned int)s);
+                    std::fill_n(model.series_values.data() + offset, model.series_lengths[s], 0.0);
+                }
+                offset += model.series_lengths[s];
+            }
+
+            parser.getSeriesRange(&model.series_min, &model.series_max);
+            return true;
+        }
+
+        case InsightParser::InsightType::FUNNEL: {
+            size_t raw_step_count = parser.getFunnelStepCount();
+            size_t raw_breakdown_count = parser.getFunnelBreakdownCount();
+            model.funnel_step_count = std::min(raw_step_count, static_cast<size_t>(MAX_FUNNEL_STEPS));
+            model.funnel_breakdown_count = std::min(raw_breakdown_count, static_cast<size_t>(MAX_BREAKDOWNS));
+            if (model.funnel_step_count == 0) return true;
+
+            // Parser fills one slot per raw step/breakdown, so size for the uncapped counts
+            std::vector<uint32_t> totals(raw_step_count, 0);
+            if (!parser.getFunnelTotalCounts(0, totals.data(), nullptr)) {
+                Serial.println("[InsightModel] Failed to get funnel total counts");
+                return false;
+            }
+
+            std::vector<uint32_t> breakdown_counts(std::max(raw_breakdown_count, static_cast<size_t>(MAX_BREAKDOWNS)), 0);
+            for (size_t i = 0; i < model.funnel_step_count; ++i) {
+                model.funnel_step_totals[i] = totals[i];
+
+                char step_name_buffer[64] = {0};
+                parser.getFunnelStepData(0, i, step_name_buffer, sizeof(step_name_buffer), nullptr, nullptr, nullptr);
+                model.funnel_step_names[i] = step_name_buffer;
+
+                std::fill(breakdown_counts.begin(), breakdown_counts.end(), 0);
+                model.funnel_has_breakdowns[i] = parser.getFunnelBreakdownComparison(i, breakdown_counts.data(), nullptr);
+                for (size_t k = 0; k < model.funnel_breakdown_count; ++k) {
+                    model.funnel_breakdown_counts[i][k] = breakdown_counts[k];
+                }
+            }
+            return true;
+        }
+
+        case InsightParser::InsightType::RETENTION: {
+            // Keep the newest cohorts, which are last in the result
+            size_t raw_cohort_count = parser.getRetentionCohortCount();
+            size_t first_cohort = raw_cohort_count > MAX_RETENTION_COHORTS ? raw_cohort_count - MAX_RETENTION_COHORTS : 0;
+            model.retention_cohort_count = raw_cohort_count - first_cohort;
+
+            for (size_t c = 0; c < model.retention_cohort_count; ++c) {
+                size_t length = parser.getRetentionCounts(first_cohort + c,
+                                                          model.retention_counts + c * MAX_RETENTION_PERIODS,
+                                                          MAX_RETENTION_PERIODS);
+                model.retention_lengths[c] = length;
+                model.retention_period_count = std::max(model.retention_period_count, length);
+            }
+            return true;
+        }
+
+        default:
+            return true;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "parsers/InsightParser.h"
+
+/**
+ * @struct InsightModel
+ * @brief Plain, JSON-free snapshot of an insight's data
+ * 
+ * Extracted once from an InsightParser on the event task, then handed to a
+ * renderer's prepare() step. Renderers never touch the parser directly, so
+ * the JSON document can be released as soon as the model is built.
+ * 
+ * Only the section matching `type` is filled in.
+ */
+struct InsightModel {
+    static constexpr size_t MAX_SERIES = InsightParser::MAX_SERIES;
+    static constexpr size_t MAX_FUNNEL_STEPS = 5;  ///< Steps kept from a funnel
+    static constexpr size_t MAX_BREAKDOWNS = 5;    ///< Breakdowns kept per funnel step
+    static constexpr size_t MAX_RETENTION_COHORTS = 12; ///< Newest cohorts kept from a retention grid
+    static constexpr size_t MAX_RETENTION_PERIODS = 12; ///< Periods kept per cohort
+
+    InsightParser::InsightType type = InsightParser::InsightType::INSIGHT_NOT_SUPPORTED;
+    String title;
+
+    // NUMERIC_CARD
+    double numeric_value = 0.0;
+    String prefix;                      ///< Formatting prefix, e.g. "$"
+    String suffix;                      ///< Formatting suffix, e.g. "%"
+
+    // LINE_GRAPH and AREA_CHART
+    size_t series_count = 0;
+    size_t series_lengths[MAX_SERIES] = {0};
+    std::vector<double> series_values;  ///< All series back to back, series_lengths[i] values each
+    double series_min = 0.0;            ///< Range across every series
+    double series_max = 0.0;
+    uint8_t series_previous_mask = 0;   ///< Bit per series that is a compare-to-previous period
+
+    // FUNNEL
+    size_t funnel_step_count = 0;       ///< Capped at MAX_FUNNEL_STEPS
+    size_t funnel_breakdown_count = 0;  ///< Capped at MAX_BREAKDOWNS
+    String funnel_step_names[MAX_FUNNEL_STEPS];
+    uint32_t funnel_step_totals[MAX_FUNNEL_STEPS] = {0};
+    uint32_t funnel_breakdown_counts[MAX_FUNNEL_STEPS][MAX_BREAKDOWNS] = {{0}};
+    bool funnel_has_breakdowns[MAX_FUNNEL_STEPS] = {false};
+
+    // RETENTION
+    size_t retention_cohort_count = 0;  ///< Rows, capped at MAX_RETENTION_COHORTS
+    size_t retention_period_count = 0;  ///< Columns, the longest cohort capped at MAX_RETENTION_PERIODS
+    size_t retention_lengths[MAX_RETENTION_COHORTS] = {0}; ///< Periods with data per cohort
+    uint32_t retention_counts[MAX_RETENTION_COHORTS * MAX_RETENTION_PERIODS] = {0}; ///< Row-major, cohort x period
+
+    /**
+     * @brief Retained users of a cohort in a period
+     * Period 0 is the cohort's size.
+     */
+    uint32_t retentionCount(size_t cohort, size_t period) const {
+        return retention_counts[cohort * MAX_RETENTION_PERIODS + period];
+    }
+
+    /**
+     * @brief Pointer to the first value of a series
+     * @param series_index Index of the series (< series_count)
+     */
+    const double* seriesData(size_t series_index) const;
+
+    /**
+     * @brief Build a model from parsed insight JSON
+     * 
+     * @param parser Valid parser
+     * @param model Model to fill
+     * @return true if the insight's data was extracted
+     */
+    static bool fromParser(const InsightParser& parser, InsightModel& model);
+};
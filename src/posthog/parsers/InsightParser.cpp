@@ -194,6 +194,12 @@ bool InsightParser::private_hasLineGraphStructure() const {
     JsonObjectConst firstResult = results[0];
     if (firstResult.isNull()) return false;
     
+    // Trends format: one object per series, each with its own "data" array
+    if (private_hasSeriesObjectStructure()) {
+        JsonArrayConst firstSeriesData = firstResult[JSON_KEY_RESULT][0][JSON_KEY_DATA];
+        return firstSeriesData.size() > 1; // Needs at least 2 points for a line graph
+    }
+
     // Check for line graph structure:
     // - results array exists
     // - first result has result array with multiple points
@@ -206,9 +212,9 @@ bool InsightParser::private_hasLineGraphStructure() const {
         return true;
     }
     
-    // Check first data point has expected time series structure [date_string, numeric_value]
+    // Check first data point has expected time series structure [date_string, value1, value2, ...]
     JsonArrayConst firstPoint = timeseriesData[0];
-    if (firstPoint.isNull() || firstPoint.size() != 2) return false;
+    if (firstPoint.isNull() || firstPoint.size() < 2) return false;
     
     // Time series first element should be a date string
     const char* dateStr = firstPoint[0];
@@ -218,6 +224,19 @@ bool InsightParser::private_hasLineGraphStructure() const {
     return firstPoint[1].is<double>();
 }
 
+// Trends results carry one object per series: {"label": ..., "data": [...], "days": [...]}
+bool InsightParser::private_hasSeriesObjectStructure() const {
+    if (!valid) return false;
+
+    JsonArrayConst resultArray = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT];
+    if (resultArray.isNull() || resultArray.size() == 0) return false;
+
+    JsonObjectConst firstSeries = resultArray[0];
+    if (firstSeries.isNull()) return false;
+
+    return firstSeries[JSON_KEY_DATA].is<JsonArrayConst>();
+}
+
 // Renamed and made private. All accessors must now use m_insightDataRoot
 bool InsightParser::private_hasAreaChartStructure() const {
     if (!valid) return false;
@@ -263,6 +282,9 @@ InsightParser::InsightType InsightParser::getInsightType() const {
     // Order of checks: from most specific/unique identifier to more general.
     // Funnel is often uniquely identified by filters.insight="FUNNELS"
     if (private_hasFunnelStructure()) return InsightType::FUNNEL;
+
+    // Retention is identified by filters.insight="RETENTION" or its cohort rows
+    if (private_hasRetentionStructure()) return InsightType::RETENTION;
     
     // Numeric card has a distinct result structure or "BoldNumber" display type
     if (private_hasNumericCardStructure()) return InsightType::NUMERIC_CARD;
@@ -330,6 +352,23 @@ bool InsightParser::private_hasFunnelResultData() const {
     return false;
 }
 
+// Retention results carry one object per cohort: {"label": ..., "date": ..., "values": [{"count": N}, ...]}
+bool InsightParser::private_hasRetentionStructure() const {
+    if (!valid) return false;
+
+    JsonObjectConst firstResult = m_insightDataRoot[JSON_KEY_RESULTS][0];
+    if (firstResult.isNull()) return false;
+
+    const char* insightType = firstResult[JSON_KEY_FILTERS][JSON_KEY_INSIGHT];
+    if (insightType && strcmp(insightType, JSON_VAL_INSIGHT_RETENTION) == 0) {
+        return true;
+    }
+
+    JsonObjectConst firstCohort = firstResult[JSON_KEY_RESULT][0];
+    if (firstCohort.isNull()) return false;
+    return firstCohort[JSON_KEY_VALUES].is<JsonArrayConst>();
+}
+
 // Renamed and made private. All accessors must now use m_insightDataRoot
 bool InsightParser::private_hasFunnelNestedStructure() const {
     if (!valid || !private_hasFunnelStructure() || !private_hasFunnelResultData()) return false;
@@ -346,41 +385,98 @@ bool InsightParser::private_hasFunnelNestedStructure() const {
     return false; // For flat structure, result[0] is typically an object directly.
 }
 
-size_t InsightParser::getSeriesPointCount() const {
+size_t InsightParser::getSeriesCount() const {
     if (!valid || !private_hasLineGraphStructure()) return 0;
     
     // Use m_insightDataRoot
-    JsonArrayConst results = m_insightDataRoot[JSON_KEY_RESULTS];
-    JsonArrayConst timeseriesData = results[0][JSON_KEY_RESULT];
-    return timeseriesData.size();
+    JsonArrayConst resultArray = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT];
+
+    size_t count = 0;
+    if (private_hasSeriesObjectStructure()) {
+        // One object per series
+        count = resultArray.size();
+    } else {
+        // One column per series after the date column
+        JsonArrayConst firstPoint = resultArray[0];
+        count = firstPoint.size() > 1 ? firstPoint.size() - 1 : 0;
+    }
+    return std::min(count, (size_t)MAX_SERIES);
 }
 
-bool InsightParser::getSeriesYValues(double* yValues) const {
-    if (!valid || !private_hasLineGraphStructure() || !yValues) return false;
+size_t InsightParser::getSeriesPointCount(size_t series_index) const {
+    if (series_index >= getSeriesCount()) return 0;
     
     // Use m_insightDataRoot
-    JsonArrayConst results = m_insightDataRoot[JSON_KEY_RESULTS];
-    JsonArrayConst timeseriesData = results[0][JSON_KEY_RESULT];
-    size_t pointCount = timeseriesData.size();
+    JsonArrayConst resultArray = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT];
+    if (private_hasSeriesObjectStructure()) {
+        JsonArrayConst seriesData = resultArray[series_index][JSON_KEY_DATA];
+        return seriesData.size();
+    }
+    return resultArray.size();
+}
+
+bool InsightParser::getSeriesYValues(double* yValues, size_t series_index) const {
+    if (!yValues || series_index >= getSeriesCount()) return false;
     
-    // Extract y-values directly - format is consistent with [date_string, numeric_value]
-    for (size_t i = 0; i < pointCount; i++) {
-        yValues[i] = timeseriesData[i][1].as<double>();
+    // Use m_insightDataRoot
+    JsonArrayConst resultArray = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT];
+
+    // Iterate rather than index: ArduinoJson arrays are linked lists, so
+    // data[i] is O(i) and indexed loops go quadratic on long ranges.
+    size_t i = 0;
+    if (private_hasSeriesObjectStructure()) {
+        JsonArrayConst seriesData = resultArray[series_index][JSON_KEY_DATA];
+        for (JsonVariantConst value : seriesData) {
+            yValues[i++] = value.as<double>();
+        }
+    } else {
+        // Row format is [date_string, value1, value2, ...]
+        for (JsonVariantConst point : resultArray) {
+            yValues[i++] = point[series_index + 1].as<double>();
+        }
     }
     
     return true;
 }
 
+bool InsightParser::getSeriesName(size_t series_index, char* buffer, size_t bufferSize) const {
+    if (!buffer || bufferSize == 0) return false;
+    buffer[0] = '\0';
+    if (series_index >= getSeriesCount() || !private_hasSeriesObjectStructure()) return false;
+
+    // Use m_insightDataRoot
+    const char* label = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT][series_index][JSON_KEY_LABEL];
+    if (!label) return false;
+
+    strncpy(buffer, label, bufferSize - 1);
+    buffer[bufferSize - 1] = '\0';
+    return true;
+}
+
+bool InsightParser::isSeriesPreviousPeriod(size_t series_index) const {
+    if (series_index >= getSeriesCount() || !private_hasSeriesObjectStructure()) return false;
+
+    // Use m_insightDataRoot
+    const char* compareLabel = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT][series_index][JSON_KEY_COMPARE_LABEL];
+    return compareLabel && strcmp(compareLabel, JSON_VAL_COMPARE_PREVIOUS) == 0;
+}
+
 bool InsightParser::getSeriesXLabel(size_t index, char* buffer, size_t bufferSize) const {
     if (!valid || !private_hasLineGraphStructure() || !buffer || bufferSize == 0) return false;
     
     // Use m_insightDataRoot
-    JsonArrayConst results = m_insightDataRoot[JSON_KEY_RESULTS];
-    JsonArrayConst timeseriesData = results[0][JSON_KEY_RESULT];
-    
-    if (index >= timeseriesData.size()) return false;
-    
-    const char* dateStr = timeseriesData[index][0];
+    JsonArrayConst resultArray = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT];
+    
+    const char* dateStr = nullptr;
+    if (private_hasSeriesObjectStructure()) {
+        // All series share the same buckets, so the first series' days are used
+        JsonArrayConst days = resultArray[0][JSON_KEY_DAYS];
+        if (index >= days.size()) return false;
+        dateStr = days[index];
+    } else {
+        if (index >= resultArray.size()) return false;
+        dateStr = resultArray[index][0];
+    }
     if (!dateStr) return false;
     
     // Copy just the year and month (YYYY-MM) to keep labels compact
@@ -395,30 +491,63 @@ bool InsightParser::getSeriesXLabel(size_t index, char* buffer, size_t bufferSiz
 }
 
 void InsightParser::getSeriesRange(double* minValue, double* maxValue) const {
-    if (!valid || !private_hasLineGraphStructure() || !minValue || !maxValue) {
-        if (minValue) *minValue = 0.0;
-        if (maxValue) *maxValue = 0.0;
-        return;
-    }
+    if (!minValue || !maxValue) return;
+    *minValue = 0.0;
+    *maxValue = 0.0;
+
+    size_t seriesCount = getSeriesCount();
+    if (seriesCount == 0) return;
     
     // Use m_insightDataRoot
-    JsonArrayConst results = m_insightDataRoot[JSON_KEY_RESULTS];
-    JsonArrayConst timeseriesData = results[0][JSON_KEY_RESULT];
-    
-    if (timeseriesData.size() == 0) {
-        *minValue = 0.0;
-        *maxValue = 0.0;
-        return;
+    JsonArrayConst resultArray = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT];
+    bool isObjectFormat = private_hasSeriesObjectStructure();
+
+    bool first = true;
+    for (size_t s = 0; s < seriesCount; s++) {
+        JsonArrayConst points = isObjectFormat ? resultArray[s][JSON_KEY_DATA] : resultArray;
+        for (JsonVariantConst point : points) {
+            double value = isObjectFormat ? point.as<double>() : point[s + 1].as<double>();
+            if (first) {
+                *minValue = value;
+                *maxValue = value;
+                first = false;
+            } else {
+                if (value < *minValue) *minValue = value;
+                if (value > *maxValue) *maxValue = value;
+            }
+        }
     }
+}
 
-    *minValue = timeseriesData[0][1].as<double>();
-    *maxValue = *minValue;
-    
-    for (size_t i = 1; i < timeseriesData.size(); i++) {
-        double value = timeseriesData[i][1].as<double>();
-        if (value < *minValue) *minValue = value;
-        if (value > *maxValue) *maxValue = value;
+size_t InsightParser::getRetentionCohortCount() const {
+    if (!valid || !private_hasRetentionStructure()) return 0;
+
+    // Use m_insightDataRoot
+    JsonArrayConst cohorts = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT];
+    return cohorts.size();
+}
+
+size_t InsightParser::getRetentionPeriodCount(size_t cohort_index) const {
+    if (cohort_index >= getRetentionCohortCount()) return 0;
+
+    // Use m_insightDataRoot
+    JsonArrayConst values = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT][cohort_index][JSON_KEY_VALUES];
+    return values.size();
+}
+
+size_t InsightParser::getRetentionCounts(size_t cohort_index, uint32_t* counts, size_t maxPeriods) const {
+    if (!counts || cohort_index >= getRetentionCohortCount()) return 0;
+
+    // Use m_insightDataRoot
+    JsonArrayConst values = m_insightDataRoot[JSON_KEY_RESULTS][0][JSON_KEY_RESULT][cohort_index][JSON_KEY_VALUES];
+
+    // Iterate rather than index, see getSeriesYValues
+    size_t i = 0;
+    for (JsonVariantConst value : values) {
+        if (i >= maxPeriods) break;
+        counts[i++] = value[JSON_KEY_COUNT].as<uint32_t>();
     }
+    return i;
 }
 
 size_t InsightParser::getFunnelBreakdownCount() const {
@@ -18,6 +18,7 @@
  * - Line graphs (time series data)
  * - Area charts (with comparison data)
  * - Funnels (with optional breakdowns and conversion metrics)
+ * - Retention (cohort x period grid)
  * 
  * Features:
  * - Memory-efficient JSON parsing using ArduinoJson (leveraging PSRAM if enabled)
@@ -36,6 +37,7 @@ public:
         LINE_GRAPH,           ///< Time series line graph with date-based X-axis
         AREA_CHART,           ///< Area chart visualization with comparison data
         FUNNEL,               ///< Funnel visualization with steps and conversion metrics
+        RETENTION,            ///< Cohort retention grid
         INSIGHT_NOT_SUPPORTED ///< Unsupported or unrecognized insight type
     };
 
@@ -91,24 +93,65 @@ public:
      */
     bool getNumericFormattingSuffix(char* buffer, size_t bufferSize) const;
     
+    /**
+     * @brief Maximum number of series exposed for multi-series trends
+     * 
+     * Breakdown and multi-event trends can return dozens of series; only the
+     * first MAX_SERIES are exposed so renderers can size their buffers statically.
+     */
+    static constexpr size_t MAX_SERIES = 5;
+
+    /**
+     * @brief Get number of series in a line graph
+     * @return Number of series (capped at MAX_SERIES) or 0 if not a line graph
+     * 
+     * Supports both the row format ([date, value1, value2, ...] per point) and
+     * the trends format (one object with a "data" array per series).
+     */
+    size_t getSeriesCount() const;
+
     /**
      * @brief Get number of data points in line graph series
+     * @param series_index Index of the series (default: first series)
      * @return Number of points or 0 if not a line graph
      * 
      * Returns the number of time series data points for line graphs.
      * Should only be called if getInsightType() returns LINE_GRAPH.
      */
-    size_t getSeriesPointCount() const;
+    size_t getSeriesPointCount(size_t series_index = 0) const;
 
     /**
      * @brief Get Y-values for line graph series
      * @param yValues Array to fill with Y-values (must be pre-allocated)
+     * @param series_index Index of the series (default: first series)
      * @return true if values were retrieved successfully
      * 
      * Populates the provided array with Y-values from the time series.
-     * Array size must match getSeriesPointCount().
+     * Array size must match getSeriesPointCount(series_index).
+     */
+    bool getSeriesYValues(double* yValues, size_t series_index = 0) const;
+
+    /**
+     * @brief Get display name of a series
+     * @param series_index Index of the series
+     * @param buffer Buffer to store name
+     * @param bufferSize Size of buffer
+     * @return true if a name was found
+     * 
+     * Uses the series "label" for the trends format. Row-format series
+     * have no names and return false.
+     */
+    bool getSeriesName(size_t series_index, char* buffer, size_t bufferSize) const;
+
+    /**
+     * @brief Check if a series is the previous period of a comparison
+     * @param series_index Index of the series
+     * @return true if the series has compare_label "previous"
+     * 
+     * Insights with "compare to previous period" enabled return each series
+     * twice in the trends format, once per period.
      */
-    bool getSeriesYValues(double* yValues) const;
+    bool isSeriesPreviousPeriod(size_t series_index) const;
 
     /**
      * @brief Get X-axis label for a data point
@@ -127,7 +170,7 @@ public:
      * @param minValue Pointer to store minimum value
      * @param maxValue Pointer to store maximum value
      * 
-     * Calculates the min/max Y values across all data points.
+     * Calculates the min/max Y values across all data points of all series.
      * Useful for scaling visualizations appropriately.
      */
     void getSeriesRange(double* minValue, double* maxValue) const;
@@ -150,6 +193,34 @@ public:
      */
     InsightType getInsightType() const;
     
+    // Retention-specific public methods
+
+    /**
+     * @brief Get number of cohorts in a retention insight
+     * @return Number of cohorts (rows) or 0 if not a retention insight
+     */
+    size_t getRetentionCohortCount() const;
+
+    /**
+     * @brief Get number of periods in a retention cohort
+     * @param cohort_index Index of the cohort
+     * @return Number of periods with data for that cohort
+     * 
+     * Later cohorts have had less time to return, so they have fewer periods.
+     */
+    size_t getRetentionPeriodCount(size_t cohort_index) const;
+
+    /**
+     * @brief Get the retained user counts of a cohort
+     * @param cohort_index Index of the cohort
+     * @param counts Array to fill, one count per period
+     * @param maxPeriods Size of the counts array
+     * @return Number of counts written
+     * 
+     * Period 0 is the cohort's size.
+     */
+    size_t getRetentionCounts(size_t cohort_index, uint32_t* counts, size_t maxPeriods) const;
+
     // Funnel-specific public methods
     
     /**
@@ -307,8 +378,10 @@ private:
     bool private_hasLineGraphStructure() const;
     bool private_hasAreaChartStructure() const;
     bool private_hasFunnelStructure() const;
+    bool private_hasRetentionStructure() const;
     bool private_hasFunnelResultData() const;
     bool private_hasFunnelNestedStructure() const;
+    bool private_hasSeriesObjectStructure() const;
 
     // Helper function to extract formatting string (prefix or suffix)
     static bool getFormattingString(const JsonObjectConst& query, const char* settingType, char* buffer, size_t bufferSize);
@@ -347,12 +420,19 @@ static const char* JSON_KEY_EVENTS = "events";
 static const char* JSON_KEY_ACTIONS = "actions";
 static const char* JSON_KEY_ID = "id";
 static const char* JSON_KEY_ACTION_ID = "action_id"; 
+static const char* JSON_KEY_DATA = "data";
+static const char* JSON_KEY_LABEL = "label";
+static const char* JSON_KEY_DAYS = "days";
+static const char* JSON_KEY_COMPARE_LABEL = "compare_label";
+static const char* JSON_KEY_VALUES = "values";
 
 // Define common JSON values as constants
 static const char* JSON_VAL_INSIGHT_FUNNELS = "FUNNELS";
+static const char* JSON_VAL_INSIGHT_RETENTION = "RETENTION";
 static const char* JSON_VAL_DISPLAY_BOLD_NUMBER = "BoldNumber";
 static const char* JSON_VAL_DISPLAY_ACTIONS_LINE_GRAPH = "ActionsLineGraph";
 static const char* JSON_VAL_DISPLAY_ACTIONS_AREA_GRAPH = "ActionsAreaGraph"; // Assumed display type for area charts
+static const char* JSON_VAL_COMPARE_PREVIOUS = "previous";
 static const char* JSON_VAL_FUNNEL_UNIT_DAY = "day";
 static const char* JSON_VAL_FUNNEL_UNIT_WEEK = "week";
 static const char* JSON_VAL_FUNNEL_UNIT_MONTH = "month";
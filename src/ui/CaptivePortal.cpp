@@ -8,6 +8,7 @@
 #include <ArduinoJson.h>  // For JSON responses
 #include <pgmspace.h> // For PROGMEM
 #include <vector> // For std::vector (action queue)
+#include <esp_heap_caps.h> // For heap statistics
 
 // Max size for the action queue
 const size_t MAX_ACTION_QUEUE_SIZE = 5; // Define a reasonable limit
@@ -103,6 +104,10 @@ void CaptivePortal::begin() {
                   }
               });
 
+    // Diagnostics
+    _server.on("/api/diagnostics/render", HTTP_GET, std::bind(&CaptivePortal::handleGetRenderStats, this, std::placeholders::_1));
+    _server.on("/api/diagnostics/buffer-mode", HTTP_POST, std::bind(&CaptivePortal::handleSaveBufferMode, this, std::placeholders::_1));
+
     // OTA Update actions
     _server.on("/check-update", HTTP_GET, std::bind(&CaptivePortal::handleCheckUpdate, this, std::placeholders::_1));
     _server.on("/start-update", HTTP_POST, std::bind(&CaptivePortal::handleStartUpdate, this, std::placeholders::_1));
@@ -715,6 +720,104 @@ void CaptivePortal::handleGetConfiguredCards(AsyncWebServerRequest *request) {
     request->send(response);
 }
 
+void CaptivePortal::handleGetRenderStats(AsyncWebServerRequest *request) {
+    RenderProfiler* profiler = _cardController.getRenderProfiler();
+    if (!profiler) {
+        request->send(503, "application/json", "{\"error\":\"No render profiler\"}");
+        return;
+    }
+
+    // Off the web server task's stack
+    RenderProfiler::Frame* frames = new (std::nothrow) RenderProfiler::Frame[RenderProfiler::CAPACITY];
+    if (!frames) {
+        request->send(500, "application/json", "{\"error\":\"Out of memory\"}");
+        return;
+    }
+    size_t count = profiler->getFrames(frames, RenderProfiler::CAPACITY);
+    RenderProfiler::Summary summary = profiler->getSummary();
+
+    // About 160 bytes per frame object, plus the summary
+    DynamicJsonDocument doc(12288);
+
+    JsonObject summaryObj = doc.createNestedObject("summary");
+    summaryObj["frames"] = summary.frames;
+    summaryObj["total_frames"] = summary.total_frames;
+    summaryObj["span_ms"] = summary.span_ms;
+    summaryObj["avg_render_us"] = summary.avg_render_us;
+    summaryObj["max_render_us"] = summary.max_render_us;
+    summaryObj["avg_flush_us"] = summary.avg_flush_us;
+    summaryObj["max_flush_us"] = summary.max_flush_us;
+    summaryObj["avg_flush_wait_us"] = summary.avg_flush_wait_us;
+    summaryObj["avg_dispatch_us"] = summary.avg_dispatch_us;
+    summaryObj["max_dispatch_us"] = summary.max_dispatch_us;
+    summaryObj["avg_invalidated_px"] = summary.avg_invalidated_px;
+    summaryObj["avg_bytes_flushed"] = summary.avg_bytes_flushed;
+    summaryObj["screen_px"] = profiler->getScreenPixels();
+
+    // What the frame times above were paid for in memory
+    JsonObject buffersObj = doc.createNestedObject("buffers");
+    DisplayInterface* display = _cardController.getDisplayInterface();
+    if (display) {
+        buffersObj["mode"] = displayBufferModeToString(display->getBufferMode());
+        buffersObj["bytes"] = display->getBufferBytes();
+    }
+    buffersObj["next_boot_mode"] = displayBufferModeToString(_configManager.getDisplayBufferMode(defaultDisplayBufferMode()));
+    buffersObj["free_internal_heap"] = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+    buffersObj["min_free_internal_heap"] = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+
+    // Button press to the first frame on screen after it
+    if (display) {
+        JsonObject inputObj = doc.createNestedObject("input");
+        inputObj["presses"] = display->getInputLatencyCount();
+        inputObj["last_latency_ms"] = display->getLastInputLatencyMs();
+        inputObj["worst_latency_ms"] = display->getWorstInputLatencyMs();
+    }
+
+    JsonArray framesArray = doc.createNestedArray("frames");
+    for (size_t i = 0; i < count; i++) {
+        const RenderProfiler::Frame& frame = frames[i];
+        JsonObject frameObj = framesArray.createNestedObject();
+        frameObj["at_ms"] = frame.at_ms;
+        frameObj["render_us"] = frame.render_us;
+        frameObj["flush_wait_us"] = frame.flush_wait_us;
+        frameObj["flush_us"] = frame.flush_us;
+        frameObj["dispatch_us"] = frame.dispatch_us;
+        frameObj["invalidated"] = frame.invalidated;
+        frameObj["invalidated_px"] = frame.invalidated_px;
+        frameObj["flushed_areas"] = frame.flushed_areas;
+        frameObj["bytes_flushed"] = frame.bytes_flushed;
+    }
+    delete[] frames;
+
+    String responseJson;
+    serializeJson(doc, responseJson);
+    AsyncWebServerResponse *response = request->beginResponse(200, "application/json", responseJson);
+    response->addHeader("Access-Control-Allow-Origin", "*");
+    request->send(response);
+}
+
+void CaptivePortal::handleSaveBufferMode(AsyncWebServerRequest *request) {
+    DisplayBufferMode mode;
+    if (!request->hasParam("mode", true) ||
+        !stringToDisplayBufferMode(request->getParam("mode", true)->value().c_str(), mode)) {
+        request->send(400, "application/json", "{\"status\":\"error\",\"message\":\"Unknown buffer mode\"}");
+        return;
+    }
+
+    _configManager.setDisplayBufferMode(mode);
+    _configManager.flush(); // A restart is next, don't wait for the quiet period
+
+    DynamicJsonDocument doc(256);
+    doc["status"] = "saved";
+    doc["mode"] = displayBufferModeToString(mode);
+    doc["message"] = "Takes effect after a restart.";
+    String responseJson;
+    serializeJson(doc, responseJson);
+    AsyncWebServerResponse *response = request->beginResponse(200, "application/json", responseJson);
+    response->addHeader("Access-Control-Allow-Origin", "*");
+    request->send(response);
+}
+
 void CaptivePortal::handleSaveConfiguredCards(AsyncWebServerRequest *request) {
     bool success = false;
     String message = "Failed to save card configuration";
@@ -152,6 +152,18 @@ private:
      */
     void handleGetConfiguredCards(AsyncWebServerRequest *request);
 
+    /**
+     * @brief Return render profiler statistics
+     * Returns JSON with a summary and the recent frames, oldest first
+     */
+    void handleGetRenderStats(AsyncWebServerRequest *request);
+
+    /**
+     * @brief Save the display buffer mode for the next boot
+     * Accepts POST with mode=FULL_PSRAM|STRIPS_INTERNAL|DIRECT_SINGLE
+     */
+    void handleSaveBufferMode(AsyncWebServerRequest *request);
+
     /**
      * @brief Handle card configuration updates
      * Accepts JSON array of CardConfig objects
@@ -2,10 +2,33 @@
 #include "ui/PaddleCard.h"
 #include <algorithm>
 
-QueueHandle_t CardController::uiQueue = nullptr;
+// Producers are background tasks, so a full queue makes them wait rather than lose updates
+UIDispatchQueue CardController::uiQueue(UIDispatchQueue::OverflowPolicy::BLOCK);
 
 // Define the global UI dispatch function
-std::function<void(std::function<void()>, bool)> globalUIDispatch;
+UIDispatch globalUIDispatch;
+
+// Task allowed to touch LVGL, nullptr until the UI task starts
+static std::atomic<TaskHandle_t> uiThread(nullptr);
+
+void claimUIThread() {
+    uiThread.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+}
+
+bool isUIThread() {
+    TaskHandle_t owner = uiThread.load(std::memory_order_relaxed);
+    return owner == nullptr || owner == xTaskGetCurrentTaskHandle();
+}
+
+void assertUIThread(const char* file, int line) {
+    if (isUIThread()) {
+        return;
+    }
+    Serial.printf("[UI-ERROR] LVGL used from task '%s' at %s:%d; dispatch it to the UI task instead\n",
+                  pcTaskGetName(nullptr), file, line);
+    Serial.flush();
+    abort();
+}
 
 CardController::CardController(
     lv_obj_t* screen,
@@ -26,6 +49,7 @@ CardController::CardController(
     provisioningCard(nullptr),
     animationCard(nullptr),
     displayInterface(nullptr),
+    renderProfiler(nullptr),
     dynamicCards()
 {
 }
@@ -41,11 +65,6 @@ CardController::~CardController() {
     delete animationCard;
     animationCard = nullptr;
     
-    // Use mutex if available before cleaning up dynamic cards
-    if (displayInterface && displayInterface->getMutexPtr()) {
-        xSemaphoreTake(*(displayInterface->getMutexPtr()), portMAX_DELAY);
-    }
-    
     // Clean up all dynamic cards using unified system
     for (auto& [cardType, cards] : dynamicCards) {
         for (auto& cardInstance : cards) {
@@ -53,11 +72,6 @@ CardController::~CardController() {
         }
     }
     dynamicCards.clear();
-    
-    // Release mutex if we took it
-    if (displayInterface && displayInterface->getMutexPtr()) {
-        xSemaphoreGive(*(displayInterface->getMutexPtr()));
-    }
 }
 
 void CardController::initialize(DisplayInterface* display) {
@@ -121,18 +135,14 @@ void CardController::initialize(DisplayInterface* display) {
 
 void CardController::setDisplayInterface(DisplayInterface* display) {
     displayInterface = display;
-    
-    // Set the mutex for the card stack if we have a display interface
-    if (cardStack && displayInterface) {
-        cardStack->setMutex(displayInterface->getMutexPtr());
+    if (display) {
+        renderProfiler = &display->getRenderProfiler();
     }
 }
 
 // Create an animation card with the walking sprites
 void CardController::createAnimationCard() {
-    if (!displayInterface || !displayInterface->takeMutex(portMAX_DELAY)) {
-        return;
-    }
+    UI_THREAD_ASSERT();
     
     // Create new animation card
     animationCard = new FriendCard(
@@ -144,14 +154,10 @@ void CardController::createAnimationCard() {
     
     // Register the animation card as an input handler
     cardStack->registerInputHandler(animationCard->getCard(), animationCard);
-    
-    displayInterface->giveMutex();
 }
 
 void CardController::createHelloWorldCard() {
-    if (!displayInterface || !displayInterface->takeMutex(portMAX_DELAY)) {
-        return;
-    }
+    UI_THREAD_ASSERT();
     
     // Create new hello world card
     HelloWorldCard* helloCard = new HelloWorldCard(screen);
@@ -163,18 +169,13 @@ void CardController::createHelloWorldCard() {
         // Register as an input handler
         cardStack->registerInputHandler(helloCard->getCard(), helloCard);
     }
-    
-    displayInterface->giveMutex();
 }
 
 
 
-// Handle WiFi events
+// Handle WiFi events. Runs on the event task; the provisioning card
+// dispatches its own LVGL work to the UI task.
 void CardController::handleWiFiEvent(const Event& event) {
-    if (!displayInterface || !displayInterface->takeMutex(portMAX_DELAY)) {
-        return;
-    }
-    
     switch (event.type) {
         case EventType::WIFI_CONNECTING:
             provisioningCard->updateConnectionStatus("Connecting to WiFi...");
@@ -196,8 +197,6 @@ void CardController::handleWiFiEvent(const Event& event) {
         default:
             break;
     }
-    
-    displayInterface->giveMutex();
 }
 
 std::vector<CardDefinition> CardController::getCardDefinitions() const {
@@ -230,7 +229,7 @@ void CardController::initializeCardTypes() {
         
         if (newCard && newCard->getCard()) {
             // Add to unified tracking system
-            CardInstance instance{newCard, newCard->getCard()};
+            CardInstance instance{newCard, newCard->getCard(), configValue};
             dynamicCards[CardType::INSIGHT].push_back(instance);
             
             // Register as input handler
@@ -262,7 +261,7 @@ void CardController::initializeCardTypes() {
         
         if (newCard && newCard->getCard()) {
             // Add to unified tracking system
-            CardInstance instance{newCard, newCard->getCard()};
+            CardInstance instance{newCard, newCard->getCard(), configValue};
             dynamicCards[CardType::FRIEND].push_back(instance);
             
             // Keep legacy pointer for backwards compatibility
@@ -291,7 +290,7 @@ void CardController::initializeCardTypes() {
         
         if (newCard && newCard->getCard()) {
             // Add to unified tracking system
-            CardInstance instance{newCard, newCard->getCard()};
+            CardInstance instance{newCard, newCard->getCard(), configValue};
             dynamicCards[CardType::HELLO_WORLD].push_back(instance);
             
             // Register as input handler
@@ -317,7 +316,7 @@ void CardController::initializeCardTypes() {
         
         if (newCard && newCard->getCard()) {
             // Add to unified tracking system
-            CardInstance instance{newCard, newCard->getCard()};
+            CardInstance instance{newCard, newCard->getCard(), configValue};
             dynamicCards[CardType::FLAPPY_HOG].push_back(instance);
             
             // Register as input handler
@@ -343,7 +342,7 @@ void CardController::initializeCardTypes() {
         
         if (newCard && newCard->getCard()) {
             // Add to unified tracking system
-            CardInstance instance{newCard, newCard->getCard()};
+            CardInstance instance{newCard, newCard->getCard(), configValue};
             dynamicCards[CardType::QUESTION].push_back(instance);
             
             // Register as input handler
@@ -369,7 +368,7 @@ void CardController::initializeCardTypes() {
         
         if (newCard && newCard->getCard()) {
             // Add to unified tracking system
-            CardInstance instance{newCard, newCard->getCard()};
+            CardInstance instance{newCard, newCard->getCard(), configValue};
             dynamicCards[CardType::PADDLE].push_back(instance);
             
             // Register as input handler
@@ -381,6 +380,32 @@ void CardController::initializeCardTypes() {
         return nullptr;
     };
     registerCardType(paddleDef);
+    
+    // Register DIAGNOSTICS card type
+    CardDefinition diagnosticsDef;
+    diagnosticsDef.type = CardType::DIAGNOSTICS;
+    diagnosticsDef.name = "Render diagnostics";
+    diagnosticsDef.allowMultiple = false;
+    diagnosticsDef.needsConfigInput = false;
+    diagnosticsDef.configInputLabel = "";
+    diagnosticsDef.uiDescription = "Frame times and screen updates, for tracking down jank";
+    diagnosticsDef.factory = [this](const String& configValue) -> lv_obj_t* {
+        DiagnosticsCard* newCard = new DiagnosticsCard(screen, renderProfiler);
+        
+        if (newCard && newCard->getCard()) {
+            // Add to unified tracking system
+            CardInstance instance{newCard, newCard->getCard(), configValue};
+            dynamicCards[CardType::DIAGNOSTICS].push_back(instance);
+            
+            // Register as input handler
+            cardStack->registerInputHandler(newCard->getCard(), newCard);
+            return newCard->getCard();
+        }
+        
+        delete newCard;
+        return nullptr;
+    };
+    registerCardType(diagnosticsDef);
 }
 
 void CardController::handleCardConfigChanged() {
@@ -394,35 +419,68 @@ void CardController::handleCardConfigChanged() {
 }
 
 void CardController::reconcileCards(const std::vector<CardConfig>& newConfigs) {
-    if (reconcileInProgress) {
-        return;
+    // Claim the reconcile, or if one is already queued or running with older
+    // configs, mark it stale so it runs again when done
+    ReconcileState state = reconcileState.load();
+    for (;;) {
+        if (state == ReconcileState::RUNNING_STALE) {
+            return;
+        }
+        ReconcileState next = (state == ReconcileState::IDLE) ? ReconcileState::RUNNING
+                                                              : ReconcileState::RUNNING_STALE;
+        if (reconcileState.compare_exchange_weak(state, next)) {
+            if (next == ReconcileState::RUNNING_STALE) {
+                return;
+            }
+            break;
+        }
     }
     
-    
     // Track the number of cards before reconciliation
     size_t oldCardCount = 0;
     for (const auto& [cardType, cards] : dynamicCards) {
         oldCardCount += cards.size();
     }
     
-    reconcileInProgress = true;
-    
     // Dispatch the entire reconciliation to the LVGL task to ensure thread safety
     dispatchToLVGLTask([this, newConfigs, oldCardCount]() {
-        if (!displayInterface || !displayInterface->takeMutex(portMAX_DELAY)) {
-            reconcileInProgress = false;  // Clear flag on failure
-            return;
-        }
-        
-        // Save current card index to restore after reconciliation
+        uint32_t reconcileStartMs = millis();
+
+        // Remember which card is on screen so it stays there if it survives
+        lv_obj_t* savedCard = cardStack ? cardStack->getCardAt(cardStack->getCurrentIndex()) : nullptr;
         uint8_t savedCardIndex = cardStack ? cardStack->getCurrentIndex() : 0;
         
-        // Simple approach: Clear everything and rebuild from scratch
-        // This avoids complex diffing logic that can cause sync issues
+        std::vector<CardConfig> sortedConfigs = newConfigs;
+        std::sort(sortedConfigs.begin(), sortedConfigs.end(), 
+                  [](const CardConfig& a, const CardConfig& b) {
+                      return a.order < b.order;
+                  });
+        
+        // Cards are keyed by (type, config). Match each wanted card to an existing
+        // one with the same key, in order, so duplicates pair up one to one.
+        std::unordered_map<CardType, std::vector<CardInstance>> previousCards;
+        previousCards.swap(dynamicCards);
+        std::vector<lv_obj_t*> keptCards(sortedConfigs.size(), nullptr);
+        
+        for (size_t i = 0; i < sortedConfigs.size(); i++) {
+            auto found = previousCards.find(sortedConfigs[i].type);
+            if (found == previousCards.end()) continue;
+            for (CardInstance& instance : found->second) {
+                if (instance.handler && instance.config == sortedConfigs[i].config) {
+                    // Keep it: it moves back into the live set untouched
+                    dynamicCards[sortedConfigs[i].type].push_back(instance);
+                    keptCards[i] = instance.lvglCard;
+                    instance.handler = nullptr;
+                    break;
+                }
+            }
+        }
         
-        // Remove all existing dynamic cards using unified system
-        for (auto& [cardType, cards] : dynamicCards) {
+        // Whatever wasn't matched is no longer configured
+        size_t cardsRemoved = 0;
+        for (auto& [cardType, cards] : previousCards) {
             for (auto& cardInstance : cards) {
+                if (!cardInstance.handler) continue;
                 if (cardInstance.lvglCard) {
                     // Notify the card that its LVGL object will be managed externally
                     cardInstance.handler->prepareForRemoval();
@@ -430,141 +488,133 @@ void CardController::reconcileCards(const std::vector<CardConfig>& newConfigs) {
                     cardStack->removeCard(cardInstance.lvglCard);
                 }
                 delete cardInstance.handler;
+                cardsRemoved++;
             }
         }
-        dynamicCards.clear();
+        previousCards.clear();
         
-        // Clear legacy pointer
-        animationCard = nullptr;
-        
-        // Force LVGL to process all pending operations
-        lv_refr_now(NULL);
-        
-        // Now recreate cards based on new configuration
-        std::vector<CardConfig> sortedConfigs = newConfigs;
-        std::sort(sortedConfigs.begin(), sortedConfigs.end(), 
-                  [](const CardConfig& a, const CardConfig& b) {
-                      return a.order < b.order;
-                  });
-        
-        // Track how many cards we've created
+        // Create the new cards, then move every card into its configured slot.
+        // Slot 0 is the provisioning card.
+        size_t cardsKept = 0;
         size_t cardsCreated = 0;
-        
-        // Check if we have a new card (more configs than before)
-        bool hasNewCard = (sortedConfigs.size() > oldCardCount);
-        size_t newCardPosition = 0;
+        size_t cardsMoved = 0;
+        uint32_t nextSlot = 1;
+        lv_obj_t* lastCreatedCard = nullptr;
         
         for (size_t i = 0; i < sortedConfigs.size(); i++) {
             const CardConfig& config = sortedConfigs[i];
-            // Find the registered card type
-            auto it = std::find_if(registeredCardTypes.begin(), registeredCardTypes.end(),
-                                  [&config](const CardDefinition& def) {
-                                      return def.type == config.type;
-                                  });
+            lv_obj_t* cardObj = nullptr;
             
-            if (it != registeredCardTypes.end() && it->factory) {
-                // Create the card using the factory function
-                lv_obj_t* cardObj = it->factory(config.config);
-                if (cardObj) {
-                    cardStack->addCard(cardObj);
-                    
-                    // Track position of new card if this is likely the new one
-                    if (hasNewCard && i == sortedConfigs.size() - 1) {
-                        newCardPosition = cardsCreated + 1; // +1 for provisioning card
+            if (keptCards[i]) {
+                cardObj = keptCards[i];
+                cardsKept++;
+            } else {
+                // Find the registered card type
+                auto it = std::find_if(registeredCardTypes.begin(), registeredCardTypes.end(),
+                                      [&config](const CardDefinition& def) {
+                                          return def.type == config.type;
+                                      });
+                
+                if (it != registeredCardTypes.end() && it->factory) {
+                    // Create the card using the factory function
+                    cardObj = it->factory(config.config);
+                    if (cardObj) {
+                        cardStack->addCard(cardObj);
+                        lastCreatedCard = cardObj;
+                        cardsCreated++;
+                    } else {
+                        Serial.printf("Failed to create card of type %s\n", 
+                                     cardTypeToString(config.type).c_str());
                     }
-                    
-                    cardsCreated++;
                 } else {
-                    Serial.printf("Failed to create card of type %s\n", 
+                    Serial.printf("No factory found for card type %s\n", 
                                  cardTypeToString(config.type).c_str());
                 }
-            } else {
-                Serial.printf("No factory found for card type %s\n", 
-                             cardTypeToString(config.type).c_str());
             }
+            
+            if (!cardObj) continue;
+            if (cardStack->getCardIndex(cardObj) != (int32_t)nextSlot) {
+                cardStack->moveCard(cardObj, nextSlot);
+                cardsMoved++;
+            }
+            nextSlot++;
+        }
+        
+        // Legacy pointer follows whichever friend card survived
+        animationCard = nullptr;
+        auto friends = dynamicCards.find(CardType::FRIEND);
+        if (friends != dynamicCards.end() && !friends->second.empty()) {
+            animationCard = static_cast<FriendCard*>(friends->second.front().handler);
         }
         
-        // Force another LVGL refresh to ensure everything is properly laid out
-        lv_refr_now(NULL);
+        // Lay out the cards so navigation below can scroll to them.
+        // No forced redraw: the next lv_timer_handler() pass draws the result.
+        lv_obj_update_layout(screen);
         
         // Force the card stack to update its pip indicators
         // This ensures the indicators are correct after bulk card operations
         cardStack->forceUpdateIndicators();
         
         // Navigate to appropriate card
-        if (hasNewCard && newCardPosition > 0) {
+        size_t cardCount = cardsKept + cardsCreated;
+        int32_t savedCardNewIndex = savedCard ? cardStack->getCardIndex(savedCard) : -1;
+        if (lastCreatedCard && cardCount > oldCardCount) {
             // Navigate to the newly added card
-            cardStack->goToCard(newCardPosition);
-        } else if (savedCardIndex > 0 && cardsCreated > 0) {
-            // Restore previous position if no new card was added
-            // Adjust for the provisioning card (always at index 0)
-            uint8_t maxIndex = cardsCreated; // provisioning + created cards - 1
+            cardStack->goToCard(cardStack->getCardIndex(lastCreatedCard));
+        } else if (savedCardIndex > 0 && savedCardNewIndex >= 0) {
+            // The card on screen survived, stay on it wherever it moved to
+            cardStack->goToCard(savedCardNewIndex);
+        } else if (savedCardIndex > 0 && cardCount > 0) {
+            // It was removed; stay at the same position, clamped to the stack
+            uint8_t maxIndex = cardCount; // provisioning + cards - 1
             uint8_t targetIndex = (savedCardIndex <= maxIndex) ? savedCardIndex : maxIndex;
             cardStack->goToCard(targetIndex);
         }
         
-        // Clear the in-progress flag
-        reconcileInProgress = false;
-        
-        displayInterface->giveMutex();
+        // Time the LVGL task was blocked, i.e. the frame stall this reconcile caused.
+        // Only created insight cards request data, so `created` is also the fetch count.
+        Serial.printf("[CardController] Reconciled %u cards (kept %u, created %u, removed %u, moved %u) in %lu ms\n",
+                      (unsigned int)cardCount, (unsigned int)cardsKept, (unsigned int)cardsCreated,
+                      (unsigned int)cardsRemoved, (unsigned int)cardsMoved,
+                      (unsigned long)(millis() - reconcileStartMs));
+
+        // Done, unless the config changed while this was queued. Then have the
+        // event task load it again, as for any other change
+        ReconcileState finished = ReconcileState::RUNNING;
+        if (!reconcileState.compare_exchange_strong(finished, ReconcileState::IDLE)) {
+            reconcileState = ReconcileState::IDLE;
+            eventQueue.publishEvent(EventType::CARD_CONFIG_CHANGED, "");
+        }
     }, true); // Use to_front=true for immediate processing
 }
 
 void CardController::initUIQueue() {
-    if (uiQueue == nullptr) {
-        uiQueue = xQueueCreate(20, sizeof(UICallback*));
-        if (uiQueue == nullptr) {
-            Serial.println("[UI-CRITICAL] Failed to create UI task queue!");
-        } else {
-            // Set the global dispatch function to point to our method
-            globalUIDispatch = [this](std::function<void()> func, bool to_front) {
-                this->dispatchToLVGLTask(std::move(func), to_front);
-            };
-        }
-    }
+    // The queue is statically allocated; just point the global dispatch at it
+    globalUIDispatch.queue = &uiQueue;
 }
 
-void CardController::processUIQueue() {
-    if (uiQueue == nullptr) return;
+bool CardController::processUIQueue(uint32_t budget_us) {
+    uint32_t startUs = micros();
+    size_t processed = uiQueue.process(budget_us);
+    if (processed > 0 && renderProfiler) {
+        renderProfiler->recordDispatch(micros() - startUs);
+    }
 
-    UICallback* callback_ptr = nullptr;
-    while (xQueueReceive(uiQueue, &callback_ptr, 0) == pdTRUE) {
-        if (callback_ptr) {
-            callback_ptr->execute();
-            delete callback_ptr;
-        }
+    // Report queue pressure whenever it reaches a new peak or drops an update
+    UIDispatchQueue::Stats stats = uiQueue.getStats();
+    if (stats.high_water > lastReportedHighWater || stats.dropped > lastReportedDrops) {
+        Serial.printf("[CardController] UI queue high-water %lu/%lu, %lu dropped, %lu superseded, %lu spilled of %lu\n",
+                      (unsigned long)stats.high_water, (unsigned long)stats.capacity,
+                      (unsigned long)stats.dropped, (unsigned long)stats.superseded,
+                      (unsigned long)stats.spilled, (unsigned long)stats.pushed);
+        lastReportedHighWater = stats.high_water;
+        lastReportedDrops = stats.dropped;
     }
     
     // Update active card (for games and other interactive cards)
-    if (cardStack) {
-        cardStack->updateActiveCard();
-    }
-}
-
-void CardController::dispatchToLVGLTask(std::function<void()> update_func, bool to_front) {
-    if (uiQueue == nullptr) {
-        Serial.println("[UI-ERROR] UI Queue not initialized, cannot dispatch UI update.");
-        return;
-    }
+    activeCardContinuous = cardStack && cardStack->updateActiveCard();
 
-    UICallback* callback = new UICallback(std::move(update_func));
-    if (!callback) {
-        Serial.println("[UI-CRITICAL] Failed to allocate UICallback for dispatch!");
-        return;
-    }
-
-    BaseType_t queue_send_result;
-    if (to_front) {
-        queue_send_result = xQueueSendToFront(uiQueue, &callback, (TickType_t)0); 
-    } else {
-        queue_send_result = xQueueSend(uiQueue, &callback, (TickType_t)0);
-    }
-
-    if (queue_send_result != pdTRUE) {
-        Serial.printf("[UI-WARN] UI queue full/error (send_to_front: %d), update discarded. Core: %d\n", 
-                      to_front, xPortGetCoreID());
-        delete callback;
-    }
+    return uiQueue.hasPending();
 }
 
 void CardController::handleCardTitleUpdated(const Event& event) {
@@ -575,8 +625,8 @@ void CardController::handleCardTitleUpdated(const Event& event) {
             if (cardConfig.name != event.title) {
                 cardConfig.name = event.title;
                 
-                // Save the updated configuration to persistent storage
-                configManager.saveCardConfigs(currentCardConfigs);
+                // Names are cosmetic: persisted lazily, and the card stack isn't touched
+                configManager.updateCardName(CardType::INSIGHT, event.insightId, event.title);
                 
                 Serial.printf("Updated card title for insight %s to: %s\n", 
                              event.insightId.c_str(), event.title.c_str());
@@ -4,6 +4,7 @@
 #include <lvgl.h>
 #include <vector>
 #include <unordered_map>
+#include <atomic>
 
 #include "ConfigManager.h"
 #include "hardware/WifiInterface.h"
@@ -19,6 +20,7 @@
 #include "config/CardConfig.h"
 #include "UICallback.h"
 #include "ui/QuestionCard.h"
+#include "ui/DiagnosticsCard.h"
 
 /**
  * @class CardController
@@ -67,6 +69,14 @@ public:
      * @param display Pointer to display interface
      */
     void setDisplayInterface(DisplayInterface* display);
+
+    /**
+     * @brief Use a render profiler not owned by a DisplayInterface
+     *
+     * setDisplayInterface() already picks up the display's own profiler; this
+     * is for hosts without one, like the simulator. Call before initialize().
+     */
+    void setRenderProfiler(RenderProfiler* profiler) { renderProfiler = profiler; }
     
     
     /**
@@ -109,6 +119,12 @@ public:
      */
     DisplayInterface* getDisplayInterface() { return displayInterface; }
 
+    /**
+     * @brief Get the display's render profiler
+     * @return Pointer to the profiler, nullptr without a display
+     */
+    RenderProfiler* getRenderProfiler() { return renderProfiler; }
+
     /**
      * @brief Get available card definitions for the web UI
      * @return Vector of CardDefinition objects representing available card types
@@ -130,7 +146,7 @@ public:
     /**
      * @brief Initialize the UI update queue
      * 
-     * Creates a FreeRTOS queue for handling UI updates across threads.
+     * Points globalUIDispatch at the statically allocated UI queue.
      * Must be called once during CardController initialization.
      */
     void initUIQueue();
@@ -138,21 +154,37 @@ public:
     /**
      * @brief Process pending UI updates
      * 
-     * Processes all queued UI updates in the LVGL task context.
+     * Runs queued UI updates in the LVGL task context for at most budget_us,
+     * leaving the rest for the next call so input polling and rendering are
+     * never stuck behind a burst of updates.
      * Should be called regularly from the LVGL handler task.
+     *
+     * @param budget_us Time slice in microseconds, 0 to drain the queue
+     * @return true if updates are still pending
      */
-    void processUIQueue();
+    bool processUIQueue(uint32_t budget_us = UI_QUEUE_BUDGET_US);
+    
+    /**
+     * @brief Whether the active card asked to be updated every loop, e.g. a game
+     *
+     * As of the last processUIQueue(). The UI task uses it to keep looping
+     * instead of sleeping until LVGL or input needs it.
+     */
+    bool isActiveCardContinuous() const { return activeCardContinuous; }
     
     /**
      * @brief Thread-safe method to dispatch UI updates to the LVGL task
      * 
      * @param update_func Lambda function containing UI operations
-     * @param to_front If true, tries to add the callback to the front of the queue
+     * @param to_front If true, runs the callback ahead of normal updates
      * 
-     * Queues UI operations to be executed on the LVGL thread.
-     * Handles queue overflow by discarding updates if queue is full.
+     * Queues UI operations to be executed on the LVGL thread without
+     * allocating. A full queue blocks the caller briefly, then drops.
      */
-    void dispatchToLVGLTask(std::function<void()> update_func, bool to_front = false);
+    template <typename F>
+    void dispatchToLVGLTask(F&& update_func, bool to_front = false) {
+        uiQueue.push(std::forward<F>(update_func), to_front);
+    }
 
 private:
     // Screen reference
@@ -174,6 +206,7 @@ private:
     struct CardInstance {
         InputHandler* handler;  ///< The card as an InputHandler
         lv_obj_t* lvglCard;    ///< The LVGL card object
+        String config;         ///< Config value it was created from; with the type, its reconcile key
     };
     std::unordered_map<CardType, std::vector<CardInstance>> dynamicCards; ///< All dynamic cards by type
     
@@ -182,14 +215,27 @@ private:
     
     // Display interface for thread safety
     DisplayInterface* displayInterface;  ///< Thread-safe display interface
+    RenderProfiler* renderProfiler;      ///< Frame statistics, also fed UI queue time
     
     // UI Threading
-    static QueueHandle_t uiQueue;  ///< Queue for thread-safe UI updates
+    static constexpr uint32_t UI_QUEUE_BUDGET_US = 8000; ///< Per-loop slice before input and rendering get a turn
+    static UIDispatchQueue uiQueue;  ///< Queue for thread-safe UI updates
+    uint32_t lastReportedHighWater = 0; ///< Queue stats already logged by processUIQueue
+    uint32_t lastReportedDrops = 0;
+    bool activeCardContinuous = false;  ///< Last result of the active card's update()
     
     // Card registration and management
     std::vector<CardDefinition> registeredCardTypes; ///< Available card types with factory functions
     std::vector<CardConfig> currentCardConfigs;      ///< Current card configuration from storage
-    bool reconcileInProgress = false;                ///< Flag to prevent concurrent reconciliations
+    
+    // One reconcile runs at a time. A config change that arrives meanwhile marks it
+    // stale, and it runs again with the latest config once it finishes
+    enum class ReconcileState : uint8_t {
+        IDLE,
+        RUNNING,
+        RUNNING_STALE
+    };
+    std::atomic<ReconcileState> reconcileState{ReconcileState::IDLE}; ///< Claimed on the event task, released on the LVGL task
     
     /**
      * @brief Create and initialize the animation card
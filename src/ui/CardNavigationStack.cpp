@@ -1,5 +1,7 @@
 #include "CardNavigationStack.h"
 #include "hardware/Input.h"
+#include "ui/UICallback.h"
+#include <esp_heap_caps.h>
 
 // External button objects - defined in main.cpp
 extern Bounce2::Button buttons[];
@@ -8,7 +10,10 @@ extern Bounce2::Button buttons[];
 #define NUM_BUTTONS 3
 
 CardNavigationStack::CardNavigationStack(lv_obj_t* parent, uint16_t width, uint16_t height)
-    : _parent(parent), _width(width), _height(height), _current_card(0), _mutex_ptr(nullptr) {
+    : _parent(parent), _width(width), _height(height), _current_card(0), _shown_card(nullptr), _window_dirty(false),
+      _transition_layer(nullptr), _transition_out(nullptr), _transition_in(nullptr),
+      _snapshot_data{nullptr, nullptr}, _snapshots_unavailable(false), _transition_active(false),
+      _transition_dir(1), _pip_count(0), _active_pip(-1) {
     
     // Create main container
     _main_container = lv_obj_create(_parent);
@@ -28,74 +33,102 @@ CardNavigationStack::CardNavigationStack(lv_obj_t* parent, uint16_t width, uint1
     lv_obj_set_scroll_snap_y(_main_container, LV_SCROLL_SNAP_CENTER);
     lv_obj_set_scrollbar_mode(_main_container, LV_SCROLLBAR_MODE_OFF);
 
-    // Create scroll indicator container
+    // Scroll indicator: one object that draws every pip itself, so the card
+    // count only changes a number instead of creating or deleting widgets
     _scroll_indicator = lv_obj_create(_parent);
-    lv_obj_set_size(_scroll_indicator, 2, _height);  // 2px wide container
+    lv_obj_remove_style_all(_scroll_indicator);
+    lv_obj_set_size(_scroll_indicator, 2, _height);  // 2px wide strip
     lv_obj_align(_scroll_indicator, LV_ALIGN_RIGHT_MID, 0, 0);  // Keep flush with right edge
-    lv_obj_set_style_bg_color(_scroll_indicator, lv_color_black(), 0);
-    lv_obj_set_style_bg_opa(_scroll_indicator, LV_OPA_TRANSP, 0);  // Make container transparent
-    lv_obj_set_style_border_width(_scroll_indicator, 0, 0);
-    lv_obj_set_style_pad_all(_scroll_indicator, 0, 0);
-    lv_obj_set_style_pad_row(_scroll_indicator, 5, 0);  // 5px gap between pips
-    lv_obj_set_flex_flow(_scroll_indicator, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_flex_align(_scroll_indicator, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
     lv_obj_clear_flag(_scroll_indicator, LV_OBJ_FLAG_SCROLLABLE);     // Disable scrolling
+    lv_obj_clear_flag(_scroll_indicator, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(_scroll_indicator, _indicator_draw_cb, LV_EVENT_DRAW_MAIN, this);
 }
 
-void CardNavigationStack::_update_pip_count() {
-    uint32_t card_count = lv_obj_get_child_cnt(_main_container);
-    uint32_t pip_count = lv_obj_get_child_cnt(_scroll_indicator);
-    
-    // Ensure we have at least 1 card for calculations
-    if (card_count == 0) {
-        // Remove all pips if no cards
-        while (pip_count > 0) {
-            lv_obj_t* pip = lv_obj_get_child(_scroll_indicator, 0);
-            if (pip) {
-                lv_obj_del(pip);
-            }
-            pip_count--;
-        }
-        return;
+bool CardNavigationStack::_pip_area(uint32_t index, lv_area_t* area) const {
+    if (_pip_count == 0 || index >= _pip_count) {
+        return false;
     }
     
-    // Calculate pip height based on card count
-    // Height = (container height - (gaps between pips)) / number of pips
-    int32_t total_gaps = (card_count > 1) ? ((card_count - 1) * 5) : 0;
-    int32_t pip_height = (_height - total_gaps) / card_count;
-    
-    // Ensure minimum pip height
-    if (pip_height < 2) pip_height = 2;
+    lv_area_t coords;
+    lv_obj_get_coords(_scroll_indicator, &coords);
+    int32_t height = lv_area_get_height(&coords);
+    
+    // Each pip owns an equal slice of the strip, less the gap; the gap
+    // shrinks when there are too many cards for it to fit
+    int32_t slice = height / (int32_t)_pip_count;
+    int32_t gap = (slice >= PIP_GAP + 2) ? PIP_GAP : (slice >= 3 ? 1 : 0);
+    int32_t top = (int32_t)index * height / (int32_t)_pip_count;
+    int32_t bottom = (int32_t)(index + 1) * height / (int32_t)_pip_count;
+    
+    area->x1 = coords.x1;
+    area->x2 = coords.x2;
+    area->y1 = coords.y1 + top + gap / 2;
+    area->y2 = coords.y1 + bottom - (gap - gap / 2) - 1;
+    if (area->y2 < area->y1) {
+        area->y2 = area->y1; // Never thinner than a pixel
+    }
+    return true;
+}
+
+void CardNavigationStack::_invalidate_pip(uint32_t index) {
+    lv_area_t area;
+    if (_pip_area(index, &area)) {
+        lv_obj_invalidate_area(_scroll_indicator, &area);
+    }
+}
+
+void CardNavigationStack::_indicator_draw_cb(lv_event_t* e) {
+    CardNavigationStack* stack = static_cast<CardNavigationStack*>(lv_event_get_user_data(e));
+    lv_layer_t* layer = lv_event_get_layer(e);
+    if (!stack || !layer || stack->_pip_count == 0) {
+        return;
+    }
     
-    // Remove all existing pips and recreate to ensure consistency
-    while (pip_count > 0) {
-        lv_obj_t* pip = lv_obj_get_child(_scroll_indicator, 0);
-        if (pip) {
-            lv_obj_del(pip);
-        }
-        pip_count--;
+    // Only the pips overlapping the area being redrawn, so a navigation
+    // step costs two rectangles however many cards there are
+    lv_area_t coords;
+    lv_obj_get_coords(stack->_scroll_indicator, &coords);
+    int32_t height = lv_area_get_height(&coords);
+    if (height <= 0) {
+        return;
+    }
+    const lv_area_t& clip = layer->_clip_area;
+    int32_t first = (clip.y1 - coords.y1) * (int32_t)stack->_pip_count / height - 1;
+    int32_t last = (clip.y2 - coords.y1) * (int32_t)stack->_pip_count / height + 1;
+    if (first < 0) first = 0;
+    if (last >= (int32_t)stack->_pip_count) last = (int32_t)stack->_pip_count - 1;
+    
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.radius = 0;  // Rectangle shape
+    dsc.bg_opa = LV_OPA_COVER;
+    dsc.border_width = 0;
+    
+    for (int32_t i = first; i <= last; i++) {
+        lv_area_t area;
+        if (!stack->_pip_area((uint32_t)i, &area)) continue;
+        dsc.bg_color = (i == stack->_active_pip) ? lv_color_white() : lv_color_hex(0x808080);
+        lv_draw_rect(layer, &dsc, &area);
+    }
+}
+
+void CardNavigationStack::_update_pip_count() {
+    uint32_t card_count = lv_obj_get_child_cnt(_main_container);
+    if (card_count == _pip_count) {
+        return;
     }
     
-    // Create new pips
-    for (uint32_t i = 0; i < card_count; i++) {
-        lv_obj_t* pip = lv_obj_create(_scroll_indicator);
-        lv_obj_set_size(pip, 2, pip_height);  // 2px wide
-        lv_obj_set_style_radius(pip, 0, 0);  // Rectangle shape
-        lv_obj_set_style_bg_color(pip, lv_color_hex(0x808080), 0);  // Gray by default
-        lv_obj_set_style_border_width(pip, 0, 0);
-        lv_obj_clear_flag(pip, LV_OBJ_FLAG_SCROLLABLE);
-    }
-    
-    // Make the first pip active if we just created pips
-    if (_current_card < card_count) {
-        lv_obj_t* active_pip = lv_obj_get_child(_scroll_indicator, _current_card);
-        if (active_pip) {
-            lv_obj_set_style_bg_color(active_pip, lv_color_white(), 0);
-        }
+    // Every pip's height depends on the count, so the strip repaints once
+    _pip_count = card_count;
+    if (_active_pip >= (int32_t)_pip_count) {
+        _active_pip = -1;
     }
+    lv_obj_invalidate(_scroll_indicator);
 }
 
 void CardNavigationStack::addCard(lv_obj_t* card) {
+    UI_THREAD_ASSERT();
+    
     // First, make the card a child of our container
     lv_obj_set_parent(card, _main_container);
     
@@ -112,7 +145,24 @@ void CardNavigationStack::addCard(lv_obj_t* card) {
     if (lv_obj_get_child_cnt(_main_container) == 1) {
         _current_card = 0;
         _update_scroll_indicator(_current_card);
+        _update_visibility();
+    } else {
+        // Off-screen from the start, so it shouldn't animate
+        InputHandler* handler = _find_handler(card);
+        if (handler) {
+            handler->onHidden();
+        }
+        
+        // Out of reach of the current card it shrinks to a placeholder straight
+        // away, so adding many cards never has them all built at once
+        uint32_t card_count = lv_obj_get_child_cnt(_main_container);
+        if (handler && !_in_reach(card_count - 1, card_count) && handler->releaseContent()) {
+            lv_obj_add_flag(card, RELEASED_FLAG);
+        }
     }
+    
+    // Wrap-around reach of the other cards may have changed
+    _window_dirty = true;
 }
 
 void CardNavigationStack::nextCard() {
@@ -132,9 +182,17 @@ void CardNavigationStack::prevCard() {
 }
 
 void CardNavigationStack::goToCard(uint8_t index) {
+    UI_THREAD_ASSERT();
+    
     uint32_t card_count = lv_obj_get_child_cnt(_main_container);
     if (index >= card_count) return;
     
+    // A slide still running jumps to its end before the next one starts
+    _finish_transition();
+    
+    uint8_t previous = _current_card;
+    lv_obj_t* outgoing_card = lv_obj_get_child(_main_container, previous);
+    
     _current_card = index;
     lv_obj_t* target_card = lv_obj_get_child(_main_container, _current_card);
     if (!target_card) {
@@ -142,23 +200,134 @@ void CardNavigationStack::goToCard(uint8_t index) {
         return;
     }
     
+    // Build the target and its neighbours before the scroll reaches them
+    _update_virtual_window();
+    _update_visibility();
+    
     // Get the actual position of the target card
     lv_coord_t target_y = lv_obj_get_y(target_card);
     
-    // Create a custom animation
+    if (outgoing_card && outgoing_card != target_card &&
+        _start_snapshot_transition(outgoing_card, target_card, index > previous ? 1 : -1)) {
+        // The live cards are hidden under the slide, so jump straight there
+        lv_anim_delete(_main_container, nullptr);
+        lv_obj_scroll_to_y(_main_container, target_y, LV_ANIM_OFF);
+    } else {
+        // Create a custom animation
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, _main_container);
+        lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)lv_obj_scroll_to_y);
+        lv_anim_set_values(&a, lv_obj_get_scroll_y(_main_container), target_y);
+        lv_anim_set_time(&a, TRANSITION_MS);
+        lv_anim_set_path_cb(&a, lv_anim_path_ease_in_out);
+        lv_anim_start(&a);
+    }
+    
+    _update_scroll_indicator(_current_card);
+}
+
+bool CardNavigationStack::_ensure_snapshot_buffers() {
+    if (_snapshot_data[0] && _snapshot_data[1]) {
+        return true;
+    }
+    if (_snapshots_unavailable) {
+        return false;
+    }
+    
+    uint32_t width = _width - 7;
+    uint32_t stride = lv_draw_buf_width_to_stride(width, LV_COLOR_FORMAT_RGB565);
+    uint32_t size = stride * _height;
+    
+    for (int i = 0; i < 2; i++) {
+        _snapshot_data[i] = static_cast<uint8_t*>(heap_caps_malloc(size, MALLOC_CAP_SPIRAM));
+        if (!_snapshot_data[i]) {
+            Serial.printf("[CardNavigationStack] No PSRAM for %lu byte card snapshots, using scrolled transitions\n",
+                          (unsigned long)size * 2);
+            heap_caps_free(_snapshot_data[0]);
+            _snapshot_data[0] = nullptr;
+            _snapshots_unavailable = true;
+            return false;
+        }
+        lv_draw_buf_init(&_snapshot_bufs[i], width, _height, LV_COLOR_FORMAT_RGB565, stride, _snapshot_data[i], size);
+    }
+    return true;
+}
+
+bool CardNavigationStack::_start_snapshot_transition(lv_obj_t* from, lv_obj_t* to, int direction) {
+    if (!_ensure_snapshot_buffers()) {
+        return false;
+    }
+    
+    // Both cards rendered once; a card drawing outside its own bounds
+    // (shadow, outline) won't fit the buffer and falls back to scrolling
+    lv_obj_update_layout(_main_container);
+    if (lv_snapshot_take_to_draw_buf(from, LV_COLOR_FORMAT_RGB565, &_snapshot_bufs[0]) != LV_RESULT_OK ||
+        lv_snapshot_take_to_draw_buf(to, LV_COLOR_FORMAT_RGB565, &_snapshot_bufs[1]) != LV_RESULT_OK) {
+        return false;
+    }
+    lv_image_cache_drop(&_snapshot_bufs[0]);
+    lv_image_cache_drop(&_snapshot_bufs[1]);
+    
+    if (!_transition_layer) {
+        _transition_layer = lv_obj_create(_parent);
+        lv_obj_remove_style_all(_transition_layer);
+        lv_obj_set_size(_transition_layer, _width - 7, _height);
+        lv_obj_align(_transition_layer, LV_ALIGN_LEFT_MID, 0, 0);
+        lv_obj_set_style_bg_color(_transition_layer, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(_transition_layer, LV_OPA_COVER, 0);
+        lv_obj_clear_flag(_transition_layer, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_clear_flag(_transition_layer, LV_OBJ_FLAG_CLICKABLE);
+        
+        _transition_out = lv_image_create(_transition_layer);
+        _transition_in = lv_image_create(_transition_layer);
+    }
+    
+    lv_image_set_src(_transition_out, &_snapshot_bufs[0]);
+    lv_image_set_src(_transition_in, &_snapshot_bufs[1]);
+    _transition_dir = direction;
+    _transition_anim_cb(this, 0);
+    
+    lv_obj_clear_flag(_transition_layer, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_move_foreground(_transition_layer);
+    lv_obj_add_flag(_main_container, LV_OBJ_FLAG_HIDDEN);
+    _transition_active = true;
+    
     lv_anim_t a;
     lv_anim_init(&a);
-    lv_anim_set_var(&a, _main_container);
-    lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)lv_obj_scroll_to_y);
-    lv_anim_set_values(&a, lv_obj_get_scroll_y(_main_container), target_y);
-    lv_anim_set_time(&a, 200);
+    lv_anim_set_var(&a, this);
+    lv_anim_set_user_data(&a, this);
+    lv_anim_set_exec_cb(&a, _transition_anim_cb);
+    lv_anim_set_values(&a, 0, _height);
+    lv_anim_set_time(&a, TRANSITION_MS);
     lv_anim_set_path_cb(&a, lv_anim_path_ease_in_out);
+    lv_anim_set_completed_cb(&a, _transition_completed_cb);
     lv_anim_start(&a);
+    return true;
+}
+
+void CardNavigationStack::_transition_anim_cb(void* var, int32_t offset) {
+    CardNavigationStack* stack = static_cast<CardNavigationStack*>(var);
+    lv_obj_set_y(stack->_transition_out, -stack->_transition_dir * offset);
+    lv_obj_set_y(stack->_transition_in, stack->_transition_dir * (stack->_height - offset));
+}
+
+void CardNavigationStack::_transition_completed_cb(lv_anim_t* anim) {
+    CardNavigationStack* stack = static_cast<CardNavigationStack*>(lv_anim_get_user_data(anim));
+    if (stack) {
+        stack->_finish_transition();
+    }
+}
+
+void CardNavigationStack::_finish_transition() {
+    if (!_transition_active) {
+        return;
+    }
+    _transition_active = false;
     
-    // Short delay after animation
-    vTaskDelay(pdMS_TO_TICKS(1));
-    
-    _update_scroll_indicator(_current_card);
+    lv_anim_delete(this, _transition_anim_cb);
+    lv_obj_clear_flag(_main_container, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(_transition_layer, LV_OBJ_FLAG_HIDDEN);
 }
 
 uint8_t CardNavigationStack::getCurrentIndex() const {
@@ -169,52 +338,160 @@ uint32_t CardNavigationStack::getCardCount() const {
     return lv_obj_get_child_cnt(_main_container);
 }
 
-void CardNavigationStack::setMutex(SemaphoreHandle_t* mutex_ptr) {
-    _mutex_ptr = mutex_ptr;
+lv_obj_t* CardNavigationStack::getCardAt(uint32_t index) const {
+    return lv_obj_get_child(_main_container, index);
 }
 
-void CardNavigationStack::handleButtonPress(uint8_t button_index) {
-    // Only handle button press if we have a mutex and can acquire it
-    if (_mutex_ptr) {
-        if (xSemaphoreTake(*_mutex_ptr, pdMS_TO_TICKS(10)) != pdTRUE) {
-            return; // Could not acquire mutex, skip this button press
-        }
+int32_t CardNavigationStack::getCardIndex(lv_obj_t* card) const {
+    if (!card) {
+        return -1;
     }
+    lv_obj_t* parent = lv_obj_get_parent(card);
+    if (parent != _main_container) {
+        return -1;
+    }
+    return lv_obj_get_index(card);
+}
+
+bool CardNavigationStack::moveCard(lv_obj_t* card, uint32_t index) {
+    UI_THREAD_ASSERT();
     
-    // Try to delegate button press to active card's input handler first
-    lv_obj_t* current_card = lv_obj_get_child(_main_container, _current_card);
-    bool handled = false;
+    int32_t old_index = getCardIndex(card);
+    if (old_index < 0) {
+        return false;
+    }
+    
+    uint32_t card_count = lv_obj_get_child_cnt(_main_container);
+    if (index >= card_count) {
+        index = card_count - 1;
+    }
+    if ((uint32_t)old_index == index) {
+        return true;
+    }
+    
+    // Keep the selection on the same card, not the same slot
+    lv_obj_t* current = lv_obj_get_child(_main_container, _current_card);
+    lv_obj_move_to_index(card, index);
+    if (current) {
+        _current_card = lv_obj_get_index(current);
+    }
+    
+    _window_dirty = true;
+    return true;
+}
+
+void CardNavigationStack::_update_visibility() {
+    lv_obj_t* current = lv_obj_get_child(_main_container, _current_card);
+    if (current == _shown_card) {
+        return;
+    }
+    
+    if (_shown_card) {
+        InputHandler* handler = _find_handler(_shown_card);
+        if (handler) {
+            handler->onHidden();
+        }
+    }
     
+    _shown_card = current;
+    if (current) {
+        InputHandler* handler = _find_handler(current);
+        if (handler) {
+            handler->onShown();
+        }
+    }
+}
+
+InputHandler* CardNavigationStack::_find_handler(lv_obj_t* card) const {
     for (const auto& handler_pair : _input_handlers) {
-        if (handler_pair.first == current_card) {
-            // Found a handler for the current card
-            if (handler_pair.second) {
-                handled = handler_pair.second->handleButtonPress(button_index);
-                if (handled) {
-                    // Handler processed the button press, don't do default behavior
-                    if (_mutex_ptr) {
-                        xSemaphoreGive(*_mutex_ptr);
-                    }
-                    return;
+        if (handler_pair.first == card) {
+            return handler_pair.second;
+        }
+    }
+    return nullptr;
+}
+
+bool CardNavigationStack::_in_reach(uint32_t index, uint32_t card_count) const {
+    // Distance from the current card, either way round
+    uint32_t ahead = (index + card_count - _current_card) % card_count;
+    uint32_t distance = (ahead < card_count - ahead) ? ahead : card_count - ahead;
+    return distance <= BUILT_NEIGHBOURS;
+}
+
+void CardNavigationStack::_update_virtual_window() {
+    _window_dirty = false;
+    uint32_t card_count = lv_obj_get_child_cnt(_main_container);
+    uint32_t changed = 0;
+    
+    for (uint32_t i = 0; i < card_count; i++) {
+        lv_obj_t* card = lv_obj_get_child(_main_container, i);
+        if (!card) continue;
+        
+        bool released = lv_obj_has_flag(card, RELEASED_FLAG);
+        if (_in_reach(i, card_count)) {
+            if (released) {
+                InputHandler* handler = _find_handler(card);
+                if (handler) {
+                    handler->restoreContent();
                 }
+                lv_obj_clear_flag(card, RELEASED_FLAG);
+                changed++;
+            }
+        } else if (!released) {
+            InputHandler* handler = _find_handler(card);
+            if (handler && handler->releaseContent()) {
+                lv_obj_add_flag(card, RELEASED_FLAG);
+                changed++;
             }
-            break;
         }
     }
     
-    // If not handled by the card, do default navigation behavior
-    if (!handled) {
-        if (button_index == Input::BUTTON_DOWN) {
-            nextCard();
-        }
-        else if (button_index == Input::BUTTON_UP) {
-            prevCard();
+#ifdef VIRTUAL_WINDOW_LOG
+    if (changed > 0) {
+        uint32_t built = 0;
+        for (uint32_t i = 0; i < card_count; i++) {
+            lv_obj_t* card = lv_obj_get_child(_main_container, i);
+            if (card && !lv_obj_has_flag(card, RELEASED_FLAG)) {
+                built++;
+            }
         }
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        Serial.printf("[CardNavigationStack] %lu of %lu cards built, LVGL heap used %u%% (%lu bytes free)\n",
+                      (unsigned long)built, (unsigned long)card_count,
+                      (unsigned int)mon.used_pct, (unsigned long)mon.free_size);
+    }
+#else
+    (void)changed;
+#endif
+}
+
+void CardNavigationStack::handleButtonPress(uint8_t button_index) {
+    UI_THREAD_ASSERT();
+    
+    // Try to delegate button press to active card's input handler first
+    lv_obj_t* current_card = lv_obj_get_child(_main_container, _current_card);
+    InputHandler* handler = _find_handler(current_card);
+    if (handler && handler->handleButtonPress(button_index)) {
+        // Handler processed the button press, don't do default behavior
+        return;
+    }
+    
+    // If not handled by the card, do default navigation behavior
+    if (button_index == Input::BUTTON_DOWN) {
+        nextCard();
     }
+    else if (button_index == Input::BUTTON_UP) {
+        prevCard();
+    }
+}
+
+void CardNavigationStack::handleLongPress(uint8_t button_index) {
+    UI_THREAD_ASSERT();
     
-    // Release mutex if we acquired it
-    if (_mutex_ptr) {
-        xSemaphoreGive(*_mutex_ptr);
+    InputHandler* handler = _find_handler(lv_obj_get_child(_main_container, _current_card));
+    if (handler) {
+        handler->handleLongPress(button_index);
     }
 }
 
@@ -242,23 +519,28 @@ void CardNavigationStack::forceUpdateIndicators() {
     // Force update active indicator
     _update_scroll_indicator(_current_card);
     
-    // Force LVGL to redraw the indicator container
+    // Force LVGL to redraw the whole strip
     lv_obj_invalidate(_scroll_indicator);
 }
 
-void CardNavigationStack::updateActiveCard() {
+bool CardNavigationStack::updateActiveCard() {
+    // Once per loop however many cards a reconcile added, moved or removed
+    if (_window_dirty) {
+        _update_virtual_window();
+    }
+    
     // Get the current card
     lv_obj_t* currentCard = lv_obj_get_child(_main_container, _current_card);
-    if (!currentCard) return;
+    if (!currentCard) return false;
     
     // Find the input handler for this card
     for (const auto& handler_pair : _input_handlers) {
         if (handler_pair.first == currentCard) {
             // Call update on the handler
-            handler_pair.second->update();
-            break;
+            return handler_pair.second->update();
         }
     }
+    return false;
 }
 
 void CardNavigationStack::_scroll_event_cb(lv_event_t* e) {
@@ -278,56 +560,38 @@ void CardNavigationStack::_scroll_event_cb(lv_event_t* e) {
 
 void CardNavigationStack::_update_scroll_indicator(int active_index) {
     uint32_t card_count = lv_obj_get_child_cnt(_main_container);
-    uint32_t pip_count = lv_obj_get_child_cnt(_scroll_indicator);
     
     // Safety check - if we have no cards, don't update anything
-    if (card_count == 0 || pip_count == 0) return;
+    if (card_count == 0) return;
     
     // Ensure active_index is valid
-    if (active_index >= card_count) {
+    if (active_index >= (int)card_count) {
         active_index = card_count - 1;
         _current_card = active_index; // Update the current card too
     }
     
     // Safety check for pip count
-    if (pip_count != card_count) {
-        // Force re-sync pips with cards
+    if (_pip_count != card_count) {
         _update_pip_count();
-        pip_count = lv_obj_get_child_cnt(_scroll_indicator);
     }
     
-    // Keep track of previous active index with a static variable
-    static int previous_index = 0;
-    
-    // Only update if we're changing to a different pip
-    if (previous_index != active_index) {
-        // Bounds checking for previous pip
-        if (previous_index < pip_count) {
-            // Get previous pip with bounds check
-            lv_obj_t* prev_pip = lv_obj_get_child(_scroll_indicator, previous_index);
-            if (prev_pip) {
-                // Change color of inactive pip
-                lv_obj_set_style_bg_color(prev_pip, lv_color_hex(0x808080), 0);
-            }
+    // Only repaint the two pips whose colour changes
+    if (_active_pip != active_index) {
+        if (_active_pip >= 0) {
+            _invalidate_pip(_active_pip);
         }
-
-        // Bounds checking for new pip
-        if (active_index < pip_count) {
-            // Get new pip with bounds check
-            lv_obj_t* new_pip = lv_obj_get_child(_scroll_indicator, active_index);
-            if (new_pip) {
-                // Change color of active pip
-                lv_obj_set_style_bg_color(new_pip, lv_color_white(), 0);
-            }
-        }
-
-        // Update previous index for next time
-        previous_index = active_index;
+        _active_pip = active_index;
+        _invalidate_pip(_active_pip);
     }
 }
 
 // Remove a card from the stack
 bool CardNavigationStack::removeCard(lv_obj_t* card) {
+    UI_THREAD_ASSERT();
+    
+    // Show the live stack again before it changes under the slide
+    _finish_transition();
+    
     // Check if the card is a child of our container
     lv_obj_t* parent = lv_obj_get_parent(card);
     if (parent != _main_container) {
@@ -374,6 +638,11 @@ bool CardNavigationStack::removeCard(lv_obj_t* card) {
         new_selection = _current_card - 1;
     }
     
+    // A deleted card can't be hidden later
+    if (_shown_card == card) {
+        _shown_card = nullptr;
+    }
+    
     // Remove input handler for this card if it exists
     for (auto it = _input_handlers.begin(); it != _input_handlers.end(); ++it) {
         if (it->first == card) {
@@ -385,10 +654,11 @@ bool CardNavigationStack::removeCard(lv_obj_t* card) {
     // Delete the card from LVGL
     lv_obj_del(card);
     
-    // Force LVGL to process the deletion
-    lv_refr_now(NULL);
+    // Recompute child positions so the scroll below targets the right card;
+    // a layout pass only, drawing happens on the next timer cycle
+    lv_obj_update_layout(_main_container);
     
-    // Update the scroll indicator (this will recreate all pips)
+    // Update the scroll indicator for the new count
     _update_pip_count();
     
     // Set the new selection - if there are any cards left
@@ -405,6 +675,10 @@ bool CardNavigationStack::removeCard(lv_obj_t* card) {
         
         // Update scroll indicator after scrolling
         _update_scroll_indicator(_current_card);
+        
+        // A neighbour may have moved into reach
+        _window_dirty = true;
+        _update_visibility();
     } else {
         // No cards left, reset current card index
         _current_card = 0;
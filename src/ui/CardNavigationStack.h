@@ -18,7 +18,13 @@ class DisplayInterface;
  * - Visual scroll indicators (pips) showing current position
  * - Button-based navigation
  * - Support for card-specific input handling
- * - Thread-safe button handling via mutex
+ * - UI task only: every method must run on the task that owns LVGL
+ * - Virtualisation: only the current card and its neighbours keep their
+ *   widgets; cards further away are asked to shrink to bare placeholders
+ *   (InputHandler::releaseContent) and rebuild when they come back into reach
+ * - Snapshot transitions: navigation renders the outgoing and incoming cards
+ *   once into PSRAM image buffers and slides those, so the animation costs
+ *   the same however complex the cards are
  */
 class CardNavigationStack {
 public:
@@ -49,6 +55,17 @@ public:
      */
     bool removeCard(lv_obj_t* card);
     
+    /**
+     * @brief Move a card to a new position in the stack
+     * @param card LVGL object already in the stack
+     * @param index Zero-based target position, clamped to the stack
+     * @return true if card is in the stack
+     * 
+     * The currently selected card stays selected wherever it ends up.
+     * Doesn't scroll; follow with goToCard() once moves are done.
+     */
+    bool moveCard(lv_obj_t* card, uint32_t index);
+    
     /**
      * @brief Navigate to next card with animation
      * 
@@ -84,10 +101,18 @@ public:
     uint32_t getCardCount() const;
     
     /**
-     * @brief Set mutex for thread-safe button handling
-     * @param mutex_ptr Pointer to FreeRTOS semaphore
+     * @brief Get the card at a position
+     * @param index Zero-based position
+     * @return LVGL object, or nullptr if out of range
+     */
+    lv_obj_t* getCardAt(uint32_t index) const;
+    
+    /**
+     * @brief Get the position of a card
+     * @param card LVGL object to look for
+     * @return Zero-based position, or -1 if not in the stack
      */
-    void setMutex(SemaphoreHandle_t* mutex_ptr);
+    int32_t getCardIndex(lv_obj_t* card) const;
     
     /**
      * @brief Process button press events
@@ -98,6 +123,14 @@ public:
      */
     void handleButtonPress(uint8_t button_index);
     
+    /**
+     * @brief Deliver a long press to the current card's input handler
+     * @param button_index Index of button being held
+     * 
+     * There is no default action for a long press.
+     */
+    void handleLongPress(uint8_t button_index);
+    
     /**
      * @brief Register an input handler for a specific card
      * @param card LVGL object to handle input for
@@ -117,11 +150,81 @@ public:
      * @brief Update the active card if it needs updates
      * 
      * Calls the update() method on the currently active card's InputHandler.
-     * Should be called regularly from the main LVGL task.
+     * Should be called regularly from the main LVGL task. Also brings the
+     * virtual window up to date after cards were added, moved or removed.
+     *
+     * @return true if the card wants to be updated again on the next loop
      */
-    void updateActiveCard();
+    bool updateActiveCard();
     
 private:
+    static constexpr uint32_t BUILT_NEIGHBOURS = 1; ///< Cards either side of the current one kept fully built
+    static constexpr lv_obj_flag_t RELEASED_FLAG = LV_OBJ_FLAG_USER_1; ///< Marks a card whose content is released
+    static constexpr int32_t PIP_GAP = 5; ///< Gap between pips in pixels, when there's room for it
+    static constexpr uint32_t TRANSITION_MS = 200; ///< Card transition duration
+
+    /**
+     * @brief Release cards that moved out of reach and restore those that came into it
+     * 
+     * Reach wraps around, like navigation does. Cards whose handler can't
+     * release its content simply stay built. Scans the whole stack, so
+     * adding, moving and removing cards only mark it stale; it runs once
+     * per goToCard() or UI loop. Build with -DVIRTUAL_WINDOW_LOG to log
+     * the LVGL heap whenever it changes something.
+     */
+    void _update_virtual_window();
+
+    /**
+     * @brief Whether the card at index is within BUILT_NEIGHBOURS of the current one
+     */
+    bool _in_reach(uint32_t index, uint32_t card_count) const;
+
+    /**
+     * @brief Tell the previously shown card it's hidden and the current one it's shown
+     * No-op if the current card hasn't changed.
+     */
+    void _update_visibility();
+
+    /**
+     * @brief Slide from one card to another using snapshots of both
+     * @param from Card currently on screen
+     * @param to Card being navigated to
+     * @param direction 1 if the new card comes up from below, -1 from above
+     * @return false if a snapshot couldn't be taken, so the caller scrolls instead
+     * 
+     * The live container is hidden while the images move and comes back
+     * in _finish_transition().
+     */
+    bool _start_snapshot_transition(lv_obj_t* from, lv_obj_t* to, int direction);
+
+    /**
+     * @brief End a running transition now, showing the live cards again
+     * No-op if none is running.
+     */
+    void _finish_transition();
+
+    /**
+     * @brief Allocate the two card-sized snapshot buffers in PSRAM
+     * @return false if PSRAM couldn't hold them; not retried after that
+     */
+    bool _ensure_snapshot_buffers();
+
+    /**
+     * @brief Animation callback moving both snapshots
+     */
+    static void _transition_anim_cb(void* var, int32_t offset);
+
+    /**
+     * @brief Animation callback run when the slide completes
+     */
+    static void _transition_completed_cb(lv_anim_t* anim);
+
+    /**
+     * @brief Find the input handler registered for a card
+     * @return Handler, or nullptr if none
+     */
+    InputHandler* _find_handler(lv_obj_t* card) const;
+    
     /**
      * @brief LVGL scroll event callback
      * Updates scroll indicators when scrolling occurs
@@ -131,8 +234,8 @@ private:
     /**
      * @brief Update number of scroll indicator pips
      * 
-     * Adds or removes pips to match card count.
-     * Adjusts pip height to fill container evenly.
+     * Pips are drawn by the indicator itself, so this only records the new
+     * count and invalidates the strip; no objects are created or deleted.
      */
     void _update_pip_count();
 
@@ -140,14 +243,31 @@ private:
      * @brief Update active scroll indicator
      * @param active_index Index of currently active card
      * 
-     * Highlights the pip corresponding to active card.
+     * Highlights the pip corresponding to active card, invalidating only
+     * the previously active pip and the new one.
      */
     void _update_scroll_indicator(int active_index);
+
+    /**
+     * @brief Screen area of a pip
+     * @return false if index has no pip
+     */
+    bool _pip_area(uint32_t index, lv_area_t* area) const;
+
+    /**
+     * @brief Invalidate a single pip so only it is redrawn
+     */
+    void _invalidate_pip(uint32_t index);
+
+    /**
+     * @brief LVGL draw callback that paints the pips overlapping the redrawn area
+     */
+    static void _indicator_draw_cb(lv_event_t* e);
     
     // UI elements
     lv_obj_t* _parent;              ///< Parent LVGL object
     lv_obj_t* _main_container;      ///< Container for cards
-    lv_obj_t* _scroll_indicator;    ///< Container for indicator pips
+    lv_obj_t* _scroll_indicator;    ///< Strip the indicator pips are drawn on
     
     // Dimensions
     uint16_t _width;                ///< Width of card stack
@@ -155,9 +275,22 @@ private:
     
     // Navigation state
     uint8_t _current_card;          ///< Index of currently visible card
+    lv_obj_t* _shown_card;          ///< Card last told onShown(), nullptr if none
+    bool _window_dirty;             ///< Cards changed since _update_virtual_window() last ran
+    
+    // Snapshot transition
+    lv_obj_t* _transition_layer;    ///< Overlay the snapshots slide in, hidden when idle
+    lv_obj_t* _transition_out;      ///< Image of the outgoing card
+    lv_obj_t* _transition_in;       ///< Image of the incoming card
+    lv_draw_buf_t _snapshot_bufs[2]; ///< Outgoing and incoming card snapshots
+    uint8_t* _snapshot_data[2];     ///< PSRAM pixel storage behind _snapshot_bufs
+    bool _snapshots_unavailable;    ///< PSRAM allocation failed, always scroll
+    bool _transition_active;        ///< A slide is running
+    int8_t _transition_dir;         ///< 1 sliding up, -1 sliding down
     
-    // Thread safety
-    SemaphoreHandle_t* _mutex_ptr;  ///< Optional mutex for thread-safe updates
+    // Scroll indicator state
+    uint32_t _pip_count;            ///< Pips the indicator currently draws
+    int32_t _active_pip;            ///< Highlighted pip, -1 if none
     
     // Input handling
     std::vector<std::pair<lv_obj_t*, InputHandler*>> _input_handlers;  ///< Card-specific input handlers
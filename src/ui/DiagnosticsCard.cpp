@@ -0,0 +1,117 @@
+#include "ui/DiagnosticsCard.h"
+#include "ui/UICallback.h"
+#include "Style.h"
+
+DiagnosticsCard::DiagnosticsCard(lv_obj_t* parent, RenderProfiler* profiler)
+    : _profiler(profiler), _card(nullptr), _title(nullptr), _stats(nullptr), _timer(nullptr) {
+    _card = lv_obj_create(parent);
+    if (!_card) return;
+
+    lv_obj_set_size(_card, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_bg_color(_card, Style::backgroundColor(), 0);
+    lv_obj_set_style_border_width(_card, 0, 0);
+    lv_obj_set_style_radius(_card, 0, 0);
+    lv_obj_set_style_pad_all(_card, 5, 0);
+    lv_obj_clear_flag(_card, LV_OBJ_FLAG_SCROLLABLE);
+
+    _title = lv_label_create(_card);
+    lv_label_set_text(_title, "RENDER");
+    lv_obj_set_style_text_font(_title, Style::labelFont(), 0);
+    lv_obj_set_style_text_color(_title, Style::accentColor(), 0);
+    lv_obj_align(_title, LV_ALIGN_TOP_LEFT, 0, 0);
+
+    _stats = lv_label_create(_card);
+    lv_obj_set_style_text_font(_stats, Style::labelFont(), 0);
+    lv_obj_set_style_text_color(_stats, Style::valueColor(), 0);
+    lv_obj_align_to(_stats, _title, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 4);
+
+    // Runs only while the card is on screen
+    _timer = lv_timer_create(_timer_cb, REFRESH_MS, this);
+    if (_timer) {
+        lv_timer_pause(_timer);
+    }
+
+    refresh();
+}
+
+DiagnosticsCard::~DiagnosticsCard() {
+    if (_timer) {
+        lv_timer_delete(_timer);
+        _timer = nullptr;
+    }
+    if (_card) {
+        lv_obj_del_async(_card);
+        _card = nullptr;
+    }
+}
+
+void DiagnosticsCard::prepareForRemoval() {
+    // The stack deletes the widgets; stop the timer before it touches them
+    if (_timer) {
+        lv_timer_delete(_timer);
+        _timer = nullptr;
+    }
+    _card = nullptr;
+    _title = nullptr;
+    _stats = nullptr;
+}
+
+void DiagnosticsCard::onShown() {
+    refresh();
+    if (_timer) {
+        lv_timer_resume(_timer);
+    }
+}
+
+void DiagnosticsCard::onHidden() {
+    if (_timer) {
+        lv_timer_pause(_timer);
+    }
+}
+
+void DiagnosticsCard::_timer_cb(lv_timer_t* timer) {
+    DiagnosticsCard* self = static_cast<DiagnosticsCard*>(lv_timer_get_user_data(timer));
+    if (self) {
+        self->refresh();
+    }
+}
+
+void DiagnosticsCard::refresh() {
+    UI_THREAD_ASSERT();
+    if (!_stats) return;
+
+    if (!_profiler) {
+        lv_label_set_text(_stats, "No display profiler");
+        return;
+    }
+
+    RenderProfiler::Summary summary = _profiler->getSummary();
+    if (summary.frames == 0) {
+        lv_label_set_text(_stats, "No frames yet");
+        return;
+    }
+
+    // Frames are only recorded when something was drawn, so this is the
+    // drawing rate over the window, not the panel's refresh rate
+    uint32_t fps_x10 = summary.span_ms > 0 ? (uint32_t)((uint64_t)(summary.frames - 1) * 10000 / summary.span_ms) : 0;
+    // Invalidations are counted before LVGL merges overlaps, so this can pass 100%
+    uint32_t screen_px = _profiler->getScreenPixels();
+    uint32_t dirty_pct = screen_px > 0 ? (uint32_t)((uint64_t)summary.avg_invalidated_px * 100 / screen_px) : 0;
+
+    lv_label_set_text_fmt(_stats,
+        "%lu.%lu fps, %lu frames\n"
+        "Draw   %lu.%lu ms, max %lu.%lu\n"
+        "SPI    %lu.%lu ms, max %lu.%lu\n"
+        "Wait   %lu.%lu ms\n"
+        "Queue  %lu.%lu ms, max %lu.%lu\n"
+        "Dirty  %lu%%, %lu KB out",
+        (unsigned long)(fps_x10 / 10), (unsigned long)(fps_x10 % 10), (unsigned long)summary.total_frames,
+        (unsigned long)(summary.avg_render_us / 1000), (unsigned long)(summary.avg_render_us / 100 % 10),
+        (unsigned long)(summary.max_render_us / 1000), (unsigned long)(summary.max_render_us / 100 % 10),
+        (unsigned long)(summary.avg_flush_us / 1000), (unsigned long)(summary.avg_flush_us / 100 % 10),
+        (unsigned long)(summary.max_flush_us / 1000), (unsigned long)(summary.max_flush_us / 100 % 10),
+        (unsigned long)(summary.avg_flush_wait_us / 1000), (unsigned long)(summary.avg_flush_wait_us / 100 % 10),
+        (unsigned long)(summary.avg_dispatch_us / 1000), (unsigned long)(summary.avg_dispatch_us / 100 % 10),
+        (unsigned long)(summary.max_dispatch_us / 1000), (unsigned long)(summary.max_dispatch_us / 100 % 10),
+        (unsigned long)dirty_pct, (unsigned long)((summary.avg_bytes_flushed + 512) / 1024));
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <lvgl.h>
+#include <Arduino.h>
+#include "ui/InputHandler.h"
+#include "hardware/RenderProfiler.h"
+
+/**
+ * @class DiagnosticsCard
+ * @brief Live render profiler statistics on the device itself
+ *
+ * Shows where frames over the profiler's window spent their time: UI queue
+ * work, drawing, waiting on the panel and the transfer, plus how much of the
+ * screen each frame invalidated. Refreshes once a second while on screen, so
+ * its own updates add about one small frame per second to the numbers.
+ */
+class DiagnosticsCard : public InputHandler {
+public:
+    /**
+     * @param parent LVGL parent object
+     * @param profiler Statistics to show, nullptr if there is no display profiler
+     */
+    DiagnosticsCard(lv_obj_t* parent, RenderProfiler* profiler);
+    ~DiagnosticsCard();
+
+    lv_obj_t* getCard() const { return _card; }
+
+    bool handleButtonPress(uint8_t button_index) override { return false; }
+    void prepareForRemoval() override;
+    void onShown() override;
+    void onHidden() override;
+
+private:
+    static constexpr uint32_t REFRESH_MS = 1000;
+
+    RenderProfiler* _profiler;
+    lv_obj_t* _card;
+    lv_obj_t* _title;
+    lv_obj_t* _stats;
+    lv_timer_t* _timer;
+
+    static void _timer_cb(lv_timer_t* timer);
+
+    /**
+     * @brief Redraw the statistics from the profiler's current summary
+     */
+    void refresh();
+};
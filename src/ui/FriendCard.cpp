@@ -131,8 +131,10 @@ void FriendCard::stopAnimation() {
     // Do nothing if animation is not running
     if (!_animation_running) return;
     
-    // We could pause the animation here if lv_animimg had a pause function
-    // For now, just mark it as not running
+    // lv_animimg animates with the object as the variable, so this removes just its animation
+    if (isValidObject(_anim_img)) {
+        lv_anim_delete(_anim_img, nullptr);
+    }
     _animation_running = false;
 }
 
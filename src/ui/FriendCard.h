@@ -52,7 +52,7 @@ public:
     /**
      * @brief Stop the sprite animation
      * 
-     * Currently only marks animation as stopped (no pause functionality).
+     * Deletes the running animation; startAnimation() begins it again.
      */
     void stopAnimation();
     
@@ -91,6 +91,16 @@ public:
     bool handleButtonPress(uint8_t button_index) override;
     void prepareForRemoval() override { _card = nullptr; }
     
+    /**
+     * @brief Resume walking when the card comes on screen
+     */
+    void onShown() override { startAnimation(); }
+    
+    /**
+     * @brief Stop walking off-screen, so the sprite stops invalidating the display
+     */
+    void onHidden() override { stopAnimation(); }
+    
 private:
     // Animation timing
     static constexpr int ANIMATION_DURATION_MS = 1000; ///< Duration of one animation cycle
@@ -18,6 +18,17 @@ public:
      */
     virtual bool handleButtonPress(uint8_t button_index) = 0;
     
+    /**
+     * @brief Handle a button held down past the long-press threshold
+     * 
+     * Sent once per press, after the press itself was delivered to
+     * handleButtonPress().
+     * 
+     * @param button_index The index of the button being held
+     * @return true if the event was handled
+     */
+    virtual bool handleLongPress(uint8_t button_index) { return false; }
+    
     /**
      * @brief Called when the card's LVGL object is being managed externally
      * 
@@ -36,4 +47,40 @@ public:
      * @return true if the card needs continuous updates, false to stop updates
      */
     virtual bool update() { return false; }
+    
+    /**
+     * @brief Tear down the card's widgets while it is far from the viewport
+     * 
+     * Called on the LVGL task by CardNavigationStack. The card's root object
+     * must stay behind as a bare placeholder of the same size; everything
+     * inside it may be deleted. Cards that can't rebuild themselves keep the
+     * default and stay fully built.
+     * 
+     * @return true if the widgets were released and restoreContent() is needed
+     */
+    virtual bool releaseContent() { return false; }
+    
+    /**
+     * @brief Rebuild the widgets released by releaseContent()
+     * 
+     * Called on the LVGL task when the card comes back near the viewport.
+     */
+    virtual void restoreContent() {}
+    
+    /**
+     * @brief Called when the card becomes the current card
+     * 
+     * Called on the LVGL task by CardNavigationStack. Resume animations and
+     * timers paused in onHidden(), and catch up on deferred updates.
+     */
+    virtual void onShown() {}
+    
+    /**
+     * @brief Called when the card stops being the current card
+     * 
+     * Cards should pause animations and timers here so off-screen cards
+     * don't keep the CPU and the display busy. Also called when a card is
+     * added to the stack anywhere but the current position.
+     */
+    virtual void onHidden() {}
 }; 
\ No newline at end of file
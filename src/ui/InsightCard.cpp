@@ -4,7 +4,9 @@
 #include <algorithm>
 #include "renderers/NumericCardRenderer.h"
 #include "renderers/LineGraphRenderer.h"
+#include "renderers/AreaChartRenderer.h"
 #include "renderers/FunnelRenderer.h"
+#include "renderers/RetentionRenderer.h"
 #include "hardware/Input.h"
 
 
@@ -12,11 +14,15 @@ InsightCard::InsightCard(lv_obj_t* parent, ConfigManager& config, EventQueue& ev
                         const String& insightId, uint16_t width, uint16_t height)
     : _config(config)
     , _event_queue(eventQueue)
+    , _subscription(0)
+    , _alive(std::make_shared<bool>(true))
     , _insight_id(insightId)
     , _current_title("")
     , _card(nullptr)
     , _title_label(nullptr)
     , _content_container(nullptr)
+    , _content_width(0)
+    , _content_height(0)
     , _active_renderer(nullptr)
     , _current_type(InsightParser::InsightType::INSIGHT_NOT_SUPPORTED) {
     
@@ -28,15 +34,53 @@ InsightCard::InsightCard(lv_obj_t* parent, ConfigManager& config, EventQueue& ev
         return;
     }
     lv_obj_set_size(_card, width, height);
+    styleCard();
+    _widget_pool = std::make_shared<WidgetPool>(_card);
+
+    if (!buildContent()) {
+        return;
+    }
+
+    // Renderers size their view-models off the UI thread, so estimate the content
+    // area from the layout above until LVGL reports the real size
+    _content_width = width - 2 * 5;
+    _content_height = height - 2 * 5 - 5 - lv_font_get_line_height(Style::labelFont());
+
+    _subscription = _event_queue.subscribe([this, alive = std::weak_ptr<bool>(_alive)](const Event& event) {
+        // Held until the callback returns; the destructor waits it out
+        std::shared_ptr<bool> hold = alive.lock();
+        if (!hold) {
+            return; // Card deleted; the event task drops this subscription next
+        }
+        if (event.insightId != _insight_id) {
+            return;
+        }
+        if (event.type == EventType::INSIGHT_DATA_RECEIVED) {
+            this->onEvent(event);
+        } else if (event.type == EventType::INSIGHT_REDRAW_REQUESTED) {
+            // Only the card that asked; others may share the insight ID.
+            // Fresh widgets need a new renderer, a deferred refresh doesn't.
+            bool rebuild = _rebuild_requested.exchange(false);
+            bool redraw = _redraw_requested.exchange(false);
+            if ((rebuild || redraw) && _last_model) {
+                renderModel(*_last_model, rebuild);
+            }
+        }
+    });
+}
+
+void InsightCard::styleCard() {
     lv_obj_set_style_bg_color(_card, Style::backgroundColor(), 0);
     lv_obj_set_style_pad_all(_card, 0, 0);
     lv_obj_set_style_border_width(_card, 0, 0);
     lv_obj_set_style_radius(_card, 0, 0);
+}
 
+bool InsightCard::buildContent() {
     lv_obj_t* flex_col = lv_obj_create(_card);
     if (!flex_col) { 
         Serial.printf("[InsightCard-%s] CRITICAL: Failed to create flex_col!\n", _insight_id.c_str());
-        return; 
+        return false; 
     }
     lv_obj_set_size(flex_col, lv_pct(100), lv_pct(100));
     lv_obj_set_style_pad_all(flex_col, 5, 0);
@@ -50,7 +94,7 @@ InsightCard::InsightCard(lv_obj_t* parent, ConfigManager& config, EventQueue& ev
     _title_label = lv_label_create(flex_col);
     if (!_title_label) { 
         Serial.printf("[InsightCard-%s] CRITICAL: Failed to create _title_label!\n", _insight_id.c_str());
-        return; 
+        return false; 
     }
     lv_obj_set_width(_title_label, lv_pct(100)); 
     lv_obj_set_style_text_color(_title_label, Style::labelColor(), 0);
@@ -61,33 +105,107 @@ InsightCard::InsightCard(lv_obj_t* parent, ConfigManager& config, EventQueue& ev
     _content_container = lv_obj_create(flex_col);
     if (!_content_container) { 
         Serial.printf("[InsightCard-%s] CRITICAL: Failed to create _content_container!\n", _insight_id.c_str());
-        return; 
+        return false; 
     }
     lv_obj_set_width(_content_container, lv_pct(100));
     lv_obj_set_flex_grow(_content_container, 1);
     lv_obj_set_style_bg_opa(_content_container, LV_OPA_0, 0);
-    lv_obj_set_style_border_width(_content_container, 0, 0);
     lv_obj_set_style_pad_all(_content_container, 0, 0);
+    lv_obj_add_event_cb(_content_container, contentSizeChangedCb, LV_EVENT_SIZE_CHANGED, this);
+    return true;
+}
 
-    _event_queue.subscribe([this](const Event& event) {
-        if (event.type == EventType::INSIGHT_DATA_RECEIVED && event.insightId == _insight_id) {
-            this->onEvent(event);
-        }
-    });
+bool InsightCard::releaseContent() {
+    if (!isValidObject(_card)) {
+        return false;
+    }
+
+    // Stops event-task renders reaching the UI; new data is only cached until restore
+    _content_released = true;
+    _content_generation.fetch_add(1);
+
+    // Hand the renderer's widgets back through the pool and drop its queued
+    // applies, so nothing keeps pointers into what lv_obj_clean() deletes
+    if (_displayed_renderer) {
+        _displayed_renderer->releaseElements();
+        _displayed_renderer.reset();
+    }
+
+    // The pool's parked widgets live under the card and are about to go
+    if (_widget_pool) {
+        _widget_pool->reset();
+    }
+    lv_obj_clean(_card);
+    _title_label = nullptr;
+    _content_container = nullptr;
+
+    // Leave a bare placeholder, only as big as the slot it holds in the stack
+    lv_coord_t width = lv_obj_get_style_width(_card, LV_PART_MAIN);
+    lv_coord_t height = lv_obj_get_style_height(_card, LV_PART_MAIN);
+    lv_obj_remove_style_all(_card);
+    lv_obj_set_size(_card, width, height);
+    return true;
+}
+
+void InsightCard::restoreContent() {
+    if (!isValidObject(_card)) {
+        return;
+    }
+
+    lv_coord_t width = lv_obj_get_style_width(_card, LV_PART_MAIN);
+    lv_coord_t height = lv_obj_get_style_height(_card, LV_PART_MAIN);
+    lv_theme_apply(_card);
+    lv_obj_set_size(_card, width, height);
+    styleCard();
+    buildContent();
+
+    // Ask the event task to draw the last data it saw into the new widgets
+    _content_released = false;
+    _render_deferred = false;
+    _rebuild_requested = true;
+    _event_queue.publishEvent(EventType::INSIGHT_REDRAW_REQUESTED, _insight_id);
+}
+
+void InsightCard::onShown() {
+    _visible = true;
+    if (_render_deferred.exchange(false)) {
+        _redraw_requested = true;
+        _event_queue.publishEvent(EventType::INSIGHT_REDRAW_REQUESTED, _insight_id);
+    }
+}
+
+void InsightCard::onHidden() {
+    _visible = false;
 }
 
+
 InsightCard::~InsightCard() {
     Serial.printf("[InsightCard-%s] DESTRUCTOR called\n", _insight_id.c_str());
+    // Removed later by the event task; until then the callback sees _alive expired
+    _event_queue.unsubscribe(_subscription);
+    std::weak_ptr<bool> in_use = _alive;
+    _alive.reset();
+    // Only a callback for this card already past its check can hold the token, and
+    // UI pushes from it are bounded, so this wait can't deadlock
+    while (!in_use.expired()) {
+        vTaskDelay(1);
+    }
+    // Skip queued updates for this card; unkeyed ones check _alive
+    globalUIDispatch.forgetOwner(this);
     std::shared_ptr<InsightRendererBase> renderer_for_lambda = std::move(_active_renderer);
     if (globalUIDispatch) {
-        globalUIDispatch([card_obj = _card, renderer = renderer_for_lambda]() mutable {
+        globalUIDispatch([card_obj = _card, renderer = renderer_for_lambda,
+                          displayed = std::move(_displayed_renderer)]() mutable {
             if (renderer) {
                 renderer->clearElements();
             }
+            if (displayed) {
+                displayed->clearElements(); // A rebuild was still queued
+            }
             if (card_obj && lv_obj_is_valid(card_obj)) {
                 lv_obj_del_async(card_obj);
             }
-        }, true);
+        }, false); // Runs after whatever is queued for the card, all of it skipped or checking _alive
     }
 }
 
@@ -106,106 +224,164 @@ void InsightCard::onEvent(const Event& event) {
 }
 
 void InsightCard::handleParsedData(std::shared_ptr<InsightParser> parser) {
+    // Runs on the event task. Renderer ownership and data extraction live here so
+    // data extraction and renderer prepare() stay off the LVGL thread; only element
+    // creation and apply() are dispatched. All renderer work is queued FIFO so
+    // element (re)creation always lands before the view-model is applied.
     if (!parser || !parser->isValid()) {
         Serial.printf("[InsightCard-%s] Invalid data or parse error.\n", _insight_id.c_str());
+        std::shared_ptr<InsightRendererBase> old_renderer = std::move(_active_renderer);
+        _current_type = InsightParser::InsightType::INSIGHT_NOT_SUPPORTED;
         if (globalUIDispatch) {
-            globalUIDispatch([this]() {
+            globalUIDispatch([this, alive = std::weak_ptr<bool>(_alive), old_renderer]() {
+                if (alive.expired()) return; // Card deleted while this was queued
                 if(isValidObject(_title_label)) lv_label_set_text(_title_label, "Data Error");
-                if (_active_renderer) {
-                    _active_renderer->clearElements();
-                    _active_renderer.reset();
+                if (old_renderer) {
+                    old_renderer->clearElements();
+                    if (_displayed_renderer == old_renderer) {
+                        _displayed_renderer.reset();
+                    }
                 }
-                _current_type = InsightParser::InsightType::INSIGHT_NOT_SUPPORTED;
-            }, true);
+            }, false);
         }
         return;
     }
 
-    InsightParser::InsightType new_insight_type = parser->getInsightType();
-    char title_buffer[64];
-    if (!parser->getName(title_buffer, sizeof(title_buffer))) {
-        strcpy(title_buffer, "Insight");
+    // Pull everything the renderers need out of the JSON once, here on the event task
+    std::shared_ptr<InsightModel> model = std::make_shared<InsightModel>();
+    if (!InsightModel::fromParser(*parser, *model)) {
+        Serial.printf("[InsightCard-%s] Failed to extract insight data.\n", _insight_id.c_str());
     }
-    String new_title(title_buffer);
 
     // Only dispatch title update event if the title has actually changed
-    if (_current_title != new_title) {
-        _current_title = new_title;
-        _event_queue.publishEvent(Event::createTitleUpdateEvent(_insight_id, new_title));
-        Serial.printf("[InsightCard-%s] Title updated to: %s\n", _insight_id.c_str(), new_title.c_str());
+    if (_current_title != model->title) {
+        _current_title = model->title;
+        _event_queue.publishEvent(Event::createTitleUpdateEvent(_insight_id, model->title));
+        Serial.printf("[InsightCard-%s] Title updated to: %s\n", _insight_id.c_str(), model->title.c_str());
     }
 
-    if (globalUIDispatch) {
-        globalUIDispatch([this, new_insight_type, new_title, parser, id = _insight_id]() mutable {
-        if (isValidObject(_title_label)) {
+    // Kept for restoreContent(); while the widgets are released that's all we do
+    _last_model = model;
+    if (_content_released) {
+        return;
+    }
+    // A refresh of an off-screen card can wait until it's shown; a first render can't
+    if (!_visible && _active_renderer) {
+        _render_deferred = true;
+        return;
+    }
+    renderModel(*model, false);
+}
+
+void InsightCard::renderModel(const InsightModel& model, bool force_rebuild) {
+    InsightParser::InsightType new_insight_type = model.type;
+    String new_title = model.title;
+
+    bool needs_rebuild = (force_rebuild || new_insight_type != _current_type || !_active_renderer);
+    std::shared_ptr<InsightRendererBase> old_renderer;
+    if (needs_rebuild) {
+        Serial.printf("[InsightCard-%s] Rebuilding renderer. Old type: %d, New type: %d\n",
+            _insight_id.c_str(), (int)_current_type, (int)new_insight_type);
+        old_renderer = std::move(_active_renderer);
+        _active_renderer = createRenderer(new_insight_type);
+        _current_type = new_insight_type;
+    }
+
+    std::shared_ptr<InsightRendererBase> renderer = _active_renderer;
+    if (!renderer) {
+        Serial.printf("[InsightCard-%s] CRITICAL: Failed to create a renderer!\n", _insight_id.c_str());
+        return;
+    }
+
+    if (!globalUIDispatch) {
+        return;
+    }
+
+    // Latest-wins, so a burst of refreshes only sets the final title
+    globalUIDispatch([this, alive = std::weak_ptr<bool>(_alive), new_title]() {
+        if (!alive.expired() && isValidObject(_title_label)) {
             lv_label_set_text(_title_label, new_title.c_str());
         }
+    }, false, this, UIUpdateKind::TITLE);
 
-        bool needs_rebuild = false;
-        if (new_insight_type != _current_type || !_active_renderer) {
-            needs_rebuild = true;
-        } else if (_active_renderer && !_active_renderer->areElementsValid()) {
+    uint32_t generation = _content_generation.load();
+    globalUIDispatch([this, alive = std::weak_ptr<bool>(_alive), old_renderer, renderer, needs_rebuild,
+                      generation, pool = _widget_pool, id = _insight_id]() {
+        if (alive.expired()) {
+            return; // Card deleted; its teardown clears the renderers
+        }
+        if (_content_generation.load() != generation) {
+            return; // Content released since; restoreContent() rebuilds with the latest data
+        }
+        bool rebuild = needs_rebuild;
+        if (!rebuild && !renderer->areElementsValid()) {
             Serial.printf("[InsightCard-%s] Active renderer elements are invalid. Rebuilding.\n", id.c_str());
-            needs_rebuild = true;
+            renderer->clearElements();
+            rebuild = true;
         }
 
-        if (needs_rebuild) {
-            Serial.printf("[InsightCard-%s] Rebuilding renderer START. Old type: %d, New type: %d. Core: %d, Card: %p, Container: %p\n", 
-                id.c_str(), (int)_current_type, (int)new_insight_type, xPortGetCoreID(), _card, _content_container);
+        if (rebuild) {
+            if (!isValidObject(_content_container)) {
+                return; // Released meanwhile; restoreContent() rebuilds with the latest data
+            }
+            Serial.printf("[InsightCard-%s] Rebuilding renderer elements. Core: %d, Card: %p, Container: %p\n",
+                id.c_str(), xPortGetCoreID(), _card, _content_container);
 
-            if (_active_renderer) {
-                _active_renderer->clearElements();
-                _active_renderer.reset();
+            if (old_renderer) {
+                old_renderer->clearElements();
             }
-            clearContentContainer();
-            _current_type = new_insight_type;
-
-            switch (new_insight_type) {
-                case InsightParser::InsightType::NUMERIC_CARD:
-                    _active_renderer = std::make_unique<NumericCardRenderer>();
-                    break;
-                case InsightParser::InsightType::LINE_GRAPH:
-                    _active_renderer = std::make_unique<LineGraphRenderer>();
-                    break;
-                case InsightParser::InsightType::FUNNEL:
-                    _active_renderer = std::make_unique<FunnelRenderer>();
-                    break;
-                default:
-                    Serial.printf("[InsightCard-%s] Unsupported insight type %d. Using Numeric as fallback.\n", 
-                        id.c_str(), (int)new_insight_type);
-                    _active_renderer = std::make_unique<NumericCardRenderer>(); 
-                    break;
+            // Whatever is on screen goes back through the pool before the container is cleaned
+            if (_displayed_renderer && _displayed_renderer != renderer) {
+                _displayed_renderer->releaseElements();
             }
+            _displayed_renderer.reset();
+            clearContentContainer();
 
-            if (_active_renderer) {
-                _active_renderer->createElements(_content_container);
-                if (isValidObject(_content_container)) {
-                    lv_obj_invalidate(_content_container);
-                }
-                lv_display_t* disp = lv_display_get_default();
-                if (disp) {
-                    lv_refr_now(disp);
-                }
-            } else {
-                Serial.printf("[InsightCard-%s] CRITICAL: Failed to create a renderer!\n", id.c_str());
+            // Layout-only pass so a freshly created card has real content
+            // dimensions before the renderer sizes its elements; the new
+            // elements are drawn by the next regular refresh
+            if (isValidObject(_content_container)) {
+                lv_obj_update_layout(_content_container);
+            }
+            renderer->createElements(_content_container);
+            _displayed_renderer = renderer;
+            if (pool) {
+                pool->logStats(id.c_str());
             }
         }
+    }, false);
 
-        if (_active_renderer) {
-            char prefix_buffer[16] = "";
-            char suffix_buffer[16] = "";
+    InsightRendererBase::Geometry geometry;
+    geometry.width = _content_width;
+    geometry.height = _content_height;
+    renderer->update(model, geometry, this);
+}
 
-            if (new_insight_type == InsightParser::InsightType::NUMERIC_CARD && parser) {
-                parser->getNumericFormattingPrefix(prefix_buffer, sizeof(prefix_buffer));
-                parser->getNumericFormattingSuffix(suffix_buffer, sizeof(suffix_buffer));
-            }
-            _active_renderer->updateDisplay(*parser, new_title, prefix_buffer, suffix_buffer);
-        } else if (!needs_rebuild) {
-            Serial.printf("[InsightCard-%s] No active renderer to update and no rebuild was triggered. Type: %d\n",
-                id.c_str(), (int)_current_type);
-        }
+void InsightCard::contentSizeChangedCb(lv_event_t* e) {
+    InsightCard* card = static_cast<InsightCard*>(lv_event_get_user_data(e));
+    lv_obj_t* container = static_cast<lv_obj_t*>(lv_event_get_target(e));
+    if (card && container) {
+        card->_content_width = lv_obj_get_content_width(container);
+        card->_content_height = lv_obj_get_content_height(container);
+    }
+}
 
-        }, true);
+std::shared_ptr<InsightRendererBase> InsightCard::createRenderer(InsightParser::InsightType type) const {
+    switch (type) {
+        case InsightParser::InsightType::NUMERIC_CARD:
+            return std::make_shared<NumericCardRenderer>(_widget_pool);
+        case InsightParser::InsightType::LINE_GRAPH:
+            return std::make_shared<LineGraphRenderer>(_widget_pool);
+        case InsightParser::InsightType::AREA_CHART:
+            return std::make_shared<AreaChartRenderer>(_widget_pool);
+        case InsightParser::InsightType::FUNNEL:
+            return std::make_shared<FunnelRenderer>(_widget_pool);
+        case InsightParser::InsightType::RETENTION:
+            return std::make_shared<RetentionRenderer>(_widget_pool);
+        default:
+            Serial.printf("[InsightCard-%s] Unsupported insight type %d. Using Numeric as fallback.\n",
+                _insight_id.c_str(), (int)type);
+            return std::make_shared<NumericCardRenderer>(_widget_pool);
     }
 }
 
@@ -230,11 +406,11 @@ bool InsightCard::handleButtonPress(uint8_t button_index) {
         
         // Update UI to show we're refreshing
         if (globalUIDispatch) {
-            globalUIDispatch([this]() {
-                if (isValidObject(_title_label)) {
+            globalUIDispatch([this, alive = std::weak_ptr<bool>(_alive)]() {
+                if (!alive.expired() && isValidObject(_title_label)) {
                     lv_label_set_text(_title_label, "Refreshing...");
                 }
-            }, true);
+            }, true, this, UIUpdateKind::TITLE);
         }
         
         Serial.printf("[InsightCard-%s] Force refresh requested\n", _insight_id.c_str());
@@ -7,6 +7,9 @@
 #include "ConfigManager.h"
 #include "EventQueue.h"
 #include "posthog/parsers/InsightParser.h"
+#include "posthog/InsightModel.h"
+#include "ui/renderers/WidgetPool.h"
+#include <atomic>
 #include "UICallback.h"
 #include "ui/InputHandler.h"
 
@@ -20,7 +23,9 @@ class InsightRendererBase;
  * Provides a flexible card-based UI component that can display various PostHog insights:
  * - Numeric displays (single value with formatted numbers)
  * - Line graphs (time series with auto-scaling)
+ * - Area charts (with compare-to-previous period overlay)
  * - Funnel visualizations (with multi-breakdown support)
+ * - Retention heatmaps (cohort x period grid)
  * 
  * Features:
  * - Thread-safe UI updates via queue system
@@ -81,6 +86,28 @@ public:
     bool handleButtonPress(uint8_t button_index) override;
     void prepareForRemoval() override { _card = nullptr; }
 
+    /**
+     * @brief Delete the title, content and renderer widgets, leaving a bare placeholder
+     * 
+     * Data that arrives while released is only kept, not rendered.
+     */
+    bool releaseContent() override;
+
+    /**
+     * @brief Rebuild the widgets and redraw the last data received
+     */
+    void restoreContent() override;
+
+    /**
+     * @brief Draw any refresh deferred while the card was hidden
+     */
+    void onShown() override;
+
+    /**
+     * @brief Defer further refreshes until the card is shown again
+     */
+    void onHidden() override;
+
 private:
     // Constants for UI layout and limits
     static constexpr int MAX_FUNNEL_STEPS = 5;     ///< Maximum number of steps in a funnel
@@ -112,6 +139,35 @@ private:
      * Handles type changes by recreating UI elements as needed.
      */
     void handleParsedData(std::shared_ptr<InsightParser> parser);
+
+    /**
+     * @brief Render extracted insight data on the event task
+     * 
+     * @param model Data to show
+     * @param force_rebuild Create a new renderer and elements even if the type is unchanged
+     */
+    void renderModel(const InsightModel& model, bool force_rebuild);
+
+    /**
+     * @brief Apply the card's own styles to its root object
+     */
+    void styleCard();
+
+    /**
+     * @brief Create the title label and content container inside the card
+     * @return false if an object couldn't be created
+     */
+    bool buildContent();
+
+    /**
+     * @brief Create the renderer for an insight type
+     * 
+     * @param type Insight type reported by the parser
+     * @return Renderer instance, Numeric for unsupported types
+     * 
+     * Only constructs the renderer; its elements are created on the UI thread.
+     */
+    std::shared_ptr<InsightRendererBase> createRenderer(InsightParser::InsightType type) const;
     
     /**
      * @brief Clear the content container
@@ -131,10 +187,19 @@ private:
      * before performing operations.
      */
     bool isValidObject(lv_obj_t* obj) const;
+
+    /**
+     * @brief LV_EVENT_SIZE_CHANGED handler for the content container
+     * 
+     * Caches the laid-out content size for renderers to prepare against.
+     */
+    static void contentSizeChangedCb(lv_event_t* e);
     
     // Configuration and state
     ConfigManager& _config;              ///< Configuration manager reference
     EventQueue& _event_queue;            ///< Event queue reference
+    EventSubscription _subscription;     ///< Removed in the destructor
+    std::shared_ptr<bool> _alive;        ///< Expires in the destructor; UI lambdas and the event callback hold a weak_ptr
     String _insight_id;                  ///< Unique insight identifier
     String _current_title;               ///< Current card title
     InsightParser::InsightType _current_type; ///< Current visualization type
@@ -143,7 +208,22 @@ private:
     lv_obj_t* _card;                    ///< Main card container
     lv_obj_t* _title_label;             ///< Title text label
     lv_obj_t* _content_container;       ///< Container for visualization
+    std::atomic<int32_t> _content_width;  ///< Content area size, written on the UI thread, read by the event task
+    std::atomic<int32_t> _content_height;
     
     // Renderer related members
-    std::unique_ptr<InsightRendererBase> _active_renderer; // Smart pointer to the current renderer
+    std::shared_ptr<InsightRendererBase> _active_renderer; // Current renderer, owned by the event task; UI lambdas hold their own reference
+    std::shared_ptr<WidgetPool> _widget_pool; // Widgets shared by successive renderers, UI thread only
+    std::shared_ptr<InsightRendererBase> _displayed_renderer; // Renderer whose elements are in the content container, UI thread only
+
+    // Virtualisation: widgets are released while the card is far from the viewport
+    std::shared_ptr<InsightModel> _last_model;   ///< Latest data, event task only; redrawn on restore
+    std::atomic<bool> _content_released{false};  ///< Set on the UI thread, read by the event task
+    std::atomic<uint32_t> _content_generation{0}; ///< Bumped on release; queued rebuilds for older content are skipped
+    std::atomic<bool> _rebuild_requested{false}; ///< This card (not another with the same ID) rebuilt its widgets
+
+    // Visibility: refreshes that arrive while off-screen are drawn when shown
+    std::atomic<bool> _visible{false};           ///< Set on the UI thread, read by the event task
+    std::atomic<bool> _render_deferred{false};   ///< A refresh was skipped while hidden
+    std::atomic<bool> _redraw_requested{false};  ///< Draw the deferred refresh
 };
\ No newline at end of file
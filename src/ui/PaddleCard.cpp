@@ -251,6 +251,16 @@ bool PaddleCard::handleButtonPress(uint8_t button_index) {
     return false; // Other buttons or unhandled cases
 }
 
+void PaddleCard::onHidden() {
+    // update() only ticks the visible card, so freeze a running game properly;
+    // the player resumes it with the center button like any other pause
+    if (_paddle_game_instance.getState() == PaddleGame::GameState::Playing) {
+        _paddle_game_instance.setState(PaddleGame::GameState::Paused);
+        _paddle_game_instance.movePlayerPaddle(true, false); // Stop player paddle
+        _paddle_game_instance.movePlayerPaddle(false, false);
+    }
+}
+
 lv_obj_t* PaddleCard::getCard() const {
     return _card_root_obj;
 }
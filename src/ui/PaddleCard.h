@@ -15,6 +15,7 @@ public:
     bool handleButtonPress(uint8_t button_index) override;
     lv_obj_t* getCard() const; // Matches main's architecture
     void prepareForRemoval() override { markedForRemoval = true; } // Prevent double deletion
+    void onHidden() override; // Pauses a game in progress
 
 private:
     void createUi(lv_obj_t* parent);
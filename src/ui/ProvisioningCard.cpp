@@ -1,6 +1,7 @@
 #include "ProvisioningCard.h"
 #include "Style.h"
 #include "SystemController.h"
+#include "UICallback.h"
 
 ProvisioningCard::ProvisioningCard(lv_obj_t* parent, WiFiInterface& wifiInterface, uint16_t width, uint16_t height)
     : _parent(parent), _wifiInterface(wifiInterface), _width(width), _height(height),
@@ -79,45 +80,31 @@ void ProvisioningCard::showQRCode() {
     const String& ssid = _wifiInterface.getSSID();
     const String qrData = generateQRCodeData(ssid, "");
     
-    // Create struct for callback data
-    struct QRUpdateData {
-        lv_obj_t* show_screen;
-        lv_obj_t* hide_screen;
-        lv_obj_t* qr_code;
-        String qr_data;
-        lv_obj_t* ssid_label;
-        String ssid_text;
-        
-        QRUpdateData(lv_obj_t* s, lv_obj_t* h, lv_obj_t* q, const String& d, lv_obj_t* sl, const String& st) 
-            : show_screen(s), hide_screen(h), qr_code(q), qr_data(d), ssid_label(sl), ssid_text(st) {}
-    };
-    
-    auto* data = new QRUpdateData(_qrScreen, _statusScreen, _qrCode, qrData, _ssidLabel, "SSID: " + ssid);
+    if (!globalUIDispatch) {
+        return;
+    }
     
-    lv_timer_t* timer = lv_timer_create([](lv_timer_t* timer) {
-        auto* params = static_cast<QRUpdateData*>(lv_timer_get_user_data(timer));
-        if (params) {
-            // Update screen visibility
-            if (params->show_screen && lv_obj_is_valid(params->show_screen)) {
-                lv_obj_clear_flag(params->show_screen, LV_OBJ_FLAG_HIDDEN);
-            }
-            if (params->hide_screen && lv_obj_is_valid(params->hide_screen)) {
-                lv_obj_add_flag(params->hide_screen, LV_OBJ_FLAG_HIDDEN);
-            }
-            
-            // Update QR code
-            if (params->qr_code && lv_obj_is_valid(params->qr_code)) {
-                lv_qrcode_update(params->qr_code, params->qr_data.c_str(), params->qr_data.length());
-            }
+    // Called from the WiFi and event tasks, so the widgets change on the UI task
+    globalUIDispatch([show_screen = _qrScreen, hide_screen = _statusScreen, qr_code = _qrCode, qrData,
+                      ssid_label = _ssidLabel, ssid_text = "SSID: " + ssid]() {
+        // Update screen visibility
+        if (show_screen && lv_obj_is_valid(show_screen)) {
+            lv_obj_clear_flag(show_screen, LV_OBJ_FLAG_HIDDEN);
+        }
+        if (hide_screen && lv_obj_is_valid(hide_screen)) {
+            lv_obj_add_flag(hide_screen, LV_OBJ_FLAG_HIDDEN);
+        }
+        
+        // Update QR code
+        if (qr_code && lv_obj_is_valid(qr_code)) {
+            lv_qrcode_update(qr_code, qrData.c_str(), qrData.length());
+        }
 
-            // Update SSID label
-            if (params->ssid_label && lv_obj_is_valid(params->ssid_label)) {
-                lv_label_set_text(params->ssid_label, params->ssid_text.c_str());
-            }
+        // Update SSID label
+        if (ssid_label && lv_obj_is_valid(ssid_label)) {
+            lv_label_set_text(ssid_label, ssid_text.c_str());
         }
-        delete params;
-        lv_timer_del(timer);
-    }, 0, data);
+    });
 }
 
 void ProvisioningCard::showWiFiStatus() {
@@ -258,35 +245,30 @@ String ProvisioningCard::escapeString(const String& input) {
 }
 
 void ProvisioningCard::safeUpdateLabel(lv_obj_t* label, const String& text) {
-    // Make a copy of the string for the callback
-    auto* callback = new std::pair<lv_obj_t*, String>(label, text);
+    if (!globalUIDispatch) {
+        return;
+    }
     
-    lv_timer_t* timer = lv_timer_create([](lv_timer_t* timer) {
-        auto* params = static_cast<std::pair<lv_obj_t*, String>*>(lv_timer_get_user_data(timer));
-        if (params && params->first && lv_obj_is_valid(params->first)) {
-            lv_label_set_text(params->first, params->second.c_str());
+    globalUIDispatch([label, text]() {
+        if (label && lv_obj_is_valid(label)) {
+            lv_label_set_text(label, text.c_str());
         }
-        delete params;
-        lv_timer_del(timer);
-    }, 0, callback);
+    });
 }
 
 void ProvisioningCard::toggleScreens(lv_obj_t* showScreen, lv_obj_t* hideScreen) {
-    auto* screens = new std::pair<lv_obj_t*, lv_obj_t*>(showScreen, hideScreen);
+    if (!globalUIDispatch) {
+        return;
+    }
     
-    lv_timer_t* timer = lv_timer_create([](lv_timer_t* timer) {
-        auto* params = static_cast<std::pair<lv_obj_t*, lv_obj_t*>*>(lv_timer_get_user_data(timer));
-        if (params) {
-            if (params->first && lv_obj_is_valid(params->first)) {
-                lv_obj_clear_flag(params->first, LV_OBJ_FLAG_HIDDEN);
-            }
-            if (params->second && lv_obj_is_valid(params->second)) {
-                lv_obj_add_flag(params->second, LV_OBJ_FLAG_HIDDEN);
-            }
+    globalUIDispatch([showScreen, hideScreen]() {
+        if (showScreen && lv_obj_is_valid(showScreen)) {
+            lv_obj_clear_flag(showScreen, LV_OBJ_FLAG_HIDDEN);
+        }
+        if (hideScreen && lv_obj_is_valid(hideScreen)) {
+            lv_obj_add_flag(hideScreen, LV_OBJ_FLAG_HIDDEN);
         }
-        delete params;
-        lv_timer_del(timer);
-    }, 0, screens);
+    });
 }
 
 lv_obj_t* ProvisioningCard::getCard() const {
@@ -295,13 +277,14 @@ lv_obj_t* ProvisioningCard::getCard() const {
 
 // Implementation for SystemController integration
 void ProvisioningCard::handleSystemStateChange(const ControllerState& newState) {
+    // May run on any task; the label checks happen on the UI task
     // Update API Status label
-    if (_apiStatusLabel && lv_obj_is_valid(_apiStatusLabel)) {
+    if (_apiStatusLabel) {
         safeUpdateLabel(_apiStatusLabel, apiStateToString(newState.api_state));
     }
 
     // Update WiFi Status label (SSID if connected, otherwise relies on updateConnectionStatus)
-    if (_statusLabel && lv_obj_is_valid(_statusLabel)) {
+    if (_statusLabel) {
         if (newState.wifi_state == WifiState::CONNECTED) {
             safeUpdateLabel(_statusLabel, _wifiInterface.getSSID());
         }
@@ -2,7 +2,7 @@
 
 #include <lvgl.h>  // LVGL core library
 #include <string>  // For String class (or could be Arduino's String)
-#include "hardware/WiFiInterface.h"  // Custom WiFi interface class
+#include "hardware/WifiInterface.h"  // Custom WiFi interface class
 #include "SystemController.h" // Added for ApiState, ControllerState
 
 /**
@@ -150,7 +150,7 @@ private:
      * @param label Label to update
      * @param text New text content
      * 
-     * Uses LVGL timer to ensure thread-safe update.
+     * Dispatched to the UI task, which owns LVGL.
      */
     void safeUpdateLabel(lv_obj_t* label, const String& text);
     
@@ -160,7 +160,7 @@ private:
      * @param showScreen Screen to show
      * @param hideScreen Screen to hide
      * 
-     * Uses LVGL timer to ensure thread-safe transition.
+     * Dispatched to the UI task, which owns LVGL.
      */
     void toggleScreens(lv_obj_t* showScreen, lv_obj_t* hideScreen);
     
@@ -168,6 +168,13 @@ void QuestionCard::startScrolling()
     lv_coord_t pad_bottom = lv_obj_get_style_pad_bottom(_cont, 0);
 
     lv_coord_t distance = label_h + pad_top + pad_bottom - cont_h;
+
+    /* replace any animation from the previous question, and reset to top */
+    stopScrolling();
+    lv_obj_scroll_to_y(_cont, 0, LV_ANIM_OFF);
+    if (_shadow_cont)
+        lv_obj_scroll_to_y(_shadow_cont, 0, LV_ANIM_OFF);
+
     if (distance <= 0) return;           // no scrolling needed
 
     /* --- constant speed calculation --------------------------- */
@@ -175,11 +182,6 @@ void QuestionCard::startScrolling()
     uint32_t duration_ms = static_cast<uint32_t>(
         (distance * 1000) / kPixelsPerSecond);
 
-    /* reset to top */
-    lv_obj_scroll_to_y(_cont, 0, LV_ANIM_OFF);
-    if (_shadow_cont)
-        lv_obj_scroll_to_y(_shadow_cont, 0, LV_ANIM_OFF);
-
     /* template animation */
     lv_anim_t base;
     lv_anim_init(&base);
@@ -204,6 +206,13 @@ void QuestionCard::startScrolling()
     }
 }
 
+/*--------------------------------------------------------------*/
+void QuestionCard::stopScrolling()
+{
+    if (_cont)        lv_anim_delete(_cont, scroll_y_anim_cb);
+    if (_shadow_cont) lv_anim_delete(_shadow_cont, scroll_y_anim_cb);
+}
+
 /*--------------------------------------------------------------*/
 bool QuestionCard::isValidObject(lv_obj_t* obj) const
 {
@@ -65,6 +65,21 @@ public:
      */
     void startScrolling();
     
+    /**
+     * @brief Stop the scrolling animation
+     */
+    void stopScrolling();
+    
+    /**
+     * @brief Restart scrolling when the card comes on screen
+     */
+    void onShown() override { startScrolling(); }
+    
+    /**
+     * @brief Stop scrolling while off-screen
+     */
+    void onHidden() override { stopScrolling(); }
+    
 private:
     /**
      * @brief Create a text label with consistent styling
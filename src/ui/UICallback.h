@@ -1,32 +1,60 @@
 #ifndef UI_CALLBACK_H
 #define UI_CALLBACK_H
 
-#include <functional>
-
-// Helper class for memory-safe UI callbacks, typically for LVGL operations
-class UICallback {
-public:
-    UICallback(std::function<void()> func) : _func(std::move(func)) {}
-    
-    void execute() {
-        if (_func) {
-            _func();
-        }
-    }
-    
-private:
-    std::function<void()> _func;
-};
+#include "UIDispatchQueue.h"
 
 /**
  * @brief Global UI dispatch function
- * 
+ *
  * This function allows any component to dispatch UI updates to the LVGL thread safely.
  * It should be set by CardController during initialization.
- * 
- * @param func The function to execute on the UI thread
- * @param to_front Whether to add to front of queue (higher priority)
+ *
+ * Call as `globalUIDispatch(func, to_front)`:
+ * @param func The callable to execute on the UI thread; stored inline, no heap allocation
+ * @param to_front Whether to run ahead of normal updates (higher priority)
+ * @return false if the update was dropped
  */
-extern std::function<void(std::function<void()>, bool)> globalUIDispatch;
+extern UIDispatch globalUIDispatch;
 
-#endif // UI_CALLBACK_H 
\ No newline at end of file
+/**
+ * @brief Single-owner UI thread
+ *
+ * LVGL is not thread-safe and there is no lock around it: only the UI task
+ * may call into it. Every other task hands its LVGL work to that task through
+ * globalUIDispatch. The UI task claims ownership once when it starts; until
+ * then (during setup) any task may build the UI.
+ *
+ * Builds with UI_THREAD_CHECKS set abort on LVGL use from another task at
+ * each UI_THREAD_ASSERT(). It defaults on with debug-level core logging.
+ */
+#ifndef UI_THREAD_CHECKS
+#if defined(CORE_DEBUG_LEVEL) && CORE_DEBUG_LEVEL >= 4
+#define UI_THREAD_CHECKS 1
+#else
+#define UI_THREAD_CHECKS 0
+#endif
+#endif
+
+/**
+ * @brief Make the calling task the only one allowed to touch LVGL
+ */
+void claimUIThread();
+
+/**
+ * @brief Whether the calling task may touch LVGL
+ * @return true on the UI task, or on any task before it has claimed ownership
+ */
+bool isUIThread();
+
+/**
+ * @brief Log the offending task and abort if not on the UI thread
+ */
+void assertUIThread(const char* file, int line);
+
+#if UI_THREAD_CHECKS
+#define UI_THREAD_ASSERT() assertUIThread(__FILE__, __LINE__)
+#else
+#define UI_THREAD_ASSERT() ((void)0)
+#endif
+
+#endif // UI_CALLBACK_H
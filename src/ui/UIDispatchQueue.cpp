@@ -0,0 +1,286 @@
+#include "UIDispatchQueue.h"
+
+UIDispatchQueue::Ring::Ring(Slot* storage, uint32_t size)
+    : slots(storage), mask(size - 1), write_pos(0), read_pos(0), overflow_count(0) {
+    for (uint32_t i = 0; i < size; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+UIDispatchQueue::Slot* UIDispatchQueue::Ring::claimWrite(uint32_t& pos) {
+    pos = write_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[pos & mask];
+        uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+        int32_t diff = (int32_t)(sequence - pos);
+        if (diff == 0) {
+            if (write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return &slot;
+            }
+        } else if (diff < 0) {
+            return nullptr; // Full: the slot still holds an update from the previous lap
+        } else {
+            pos = write_pos.load(std::memory_order_relaxed); // Another producer got here first
+        }
+    }
+}
+
+void UIDispatchQueue::Ring::publishWrite(Slot& slot, uint32_t pos) {
+    slot.sequence.store(pos + 1, std::memory_order_release);
+}
+
+UIDispatchQueue::Slot* UIDispatchQueue::Ring::claimRead(uint32_t& pos) {
+    pos = read_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[pos & mask];
+        uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+        int32_t diff = (int32_t)(sequence - (pos + 1));
+        if (diff == 0) {
+            if (read_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return &slot;
+            }
+        } else if (diff < 0) {
+            return nullptr; // Empty, or the next update is still being written
+        } else {
+            pos = read_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void UIDispatchQueue::Ring::releaseRead(Slot& slot, uint32_t pos) {
+    slot.sequence.store(pos + mask + 1, std::memory_order_release);
+}
+
+uint32_t UIDispatchQueue::Ring::pending() const {
+    return write_pos.load(std::memory_order_relaxed) - read_pos.load(std::memory_order_relaxed);
+}
+
+UIDispatchQueue::UIDispatchQueue(OverflowPolicy policy, uint32_t block_timeout_ms)
+    : _normal(_normal_slots, NORMAL_SLOTS)
+    , _urgent(_urgent_slots, URGENT_SLOTS)
+    , _overflow_mutex(xSemaphoreCreateMutex())
+    , _policy(policy)
+    , _block_timeout_ms(block_timeout_ms)
+    , _consumer_task(nullptr)
+    , _discard_requests(0)
+    , _pushed(0)
+    , _dropped(0)
+    , _high_water(0)
+    , _superseded(0)
+    , _spilled(0) {
+    for (KeyEntry& entry : _keys) {
+        entry.owner.store(nullptr, std::memory_order_relaxed);
+        for (std::atomic<uint32_t>& generation : entry.generation) {
+            generation.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+UIDispatchQueue::~UIDispatchQueue() {
+    vSemaphoreDelete(_overflow_mutex);
+}
+
+// Marks a forgotten entry. Unlike nullptr it doesn't end a probe, so owners
+// stored further along are still found
+static const char forgottenOwner = 0;
+static const void* const FORGOTTEN = &forgottenOwner;
+
+UIDispatchQueue::KeyEntry* UIDispatchQueue::findKey(const void* owner) {
+    // Open addressing: probe until the owner or an empty entry, remembering
+    // the first forgotten entry so it can be reused
+    uint32_t start = ((uintptr_t)owner >> 2) * 2654435761u;
+    for (;;) {
+        KeyEntry* reusable = nullptr;
+        KeyEntry* empty = nullptr;
+        for (uint32_t i = 0; i < KEY_SLOTS; ++i) {
+            KeyEntry& entry = _keys[(start + i) % KEY_SLOTS];
+            const void* current = entry.owner.load(std::memory_order_acquire);
+            if (current == owner) return &entry;
+            if (current == FORGOTTEN) {
+                if (!reusable) reusable = &entry;
+            } else if (current == nullptr) {
+                empty = &entry;
+                break;
+            }
+        }
+
+        KeyEntry* claim = reusable ? reusable : empty;
+        if (!claim) return nullptr; // Table full of live owners, the update goes unkeyed
+
+        const void* expected = (claim == reusable) ? FORGOTTEN : nullptr;
+        if (claim->owner.compare_exchange_strong(expected, owner, std::memory_order_acq_rel)) {
+            return claim;
+        }
+        if (expected == owner) return claim; // Another producer claimed it for the same owner
+        // Someone else took the entry, probe again
+    }
+}
+
+void UIDispatchQueue::forgetOwner(const void* owner) {
+    if (!owner) return;
+    // Check every entry: two producers racing on an owner's first push can each claim one
+    for (KeyEntry& entry : _keys) {
+        if (entry.owner.load(std::memory_order_acquire) != owner) continue;
+        // Supersede everything already queued under this entry before letting it go
+        for (std::atomic<uint32_t>& generation : entry.generation) {
+            generation.fetch_add(1, std::memory_order_relaxed);
+        }
+        const void* expected = owner;
+        entry.owner.compare_exchange_strong(expected, FORGOTTEN, std::memory_order_acq_rel);
+    }
+}
+
+size_t UIDispatchQueue::process(uint32_t budget_us) {
+    _consumer_task.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+
+    uint32_t start_us = micros();
+    size_t run = 0;
+    for (;;) {
+        if (budget_us && run > 0 && (uint32_t)(micros() - start_us) >= budget_us) {
+            break; // Out of time, carry the rest over to the next loop
+        }
+
+        if (!runNext(_urgent) && !runNext(_normal)) {
+            break;
+        }
+        run++;
+    }
+    return run;
+}
+
+bool UIDispatchQueue::runNext(Ring& ring) {
+    // Once a ring spills, pushes queue behind the spill, so the ring holds the older updates
+    uint32_t pos;
+    Slot* slot = ring.claimRead(pos);
+    if (!slot) {
+        return runSpilled(ring);
+    }
+    runSlot(*slot, &ring);
+    ring.releaseRead(*slot, pos);
+    return true;
+}
+
+void UIDispatchQueue::runSlot(Slot& slot, const Ring* ring) {
+    // Latest-wins: a newer update with the same key is still queued, run that one instead
+    if (slot.key && slot.key->generation[slot.kind].load(std::memory_order_relaxed) != slot.generation) {
+        _superseded.fetch_add(1, std::memory_order_relaxed);
+    } else if (ring && slot.key && ring->pending() >= ring->mask && takeDiscardRequest()) {
+        // The ring was full and a DROP_OLDEST producer is waiting; this is the oldest keyed update
+        countDrop("oldest update discarded");
+    } else {
+        slot.task.run();
+    }
+    slot.task.reset();
+}
+
+bool UIDispatchQueue::runSpilled(Ring& ring) {
+    if (ring.overflow_count.load(std::memory_order_acquire) == 0) return false;
+
+    // Unlink under the lock but run outside it, since the task may push again
+    std::list<Slot> next;
+    xSemaphoreTake(_overflow_mutex, portMAX_DELAY);
+    next.splice(next.begin(), ring.overflow, ring.overflow.begin());
+    ring.overflow_count.fetch_sub(1, std::memory_order_release);
+    xSemaphoreGive(_overflow_mutex);
+
+    runSlot(next.front(), nullptr);
+    return true;
+}
+
+bool UIDispatchQueue::hasPending() const {
+    return _urgent.pending() > 0 || _normal.pending() > 0 ||
+           _urgent.overflow_count.load(std::memory_order_relaxed) > 0 ||
+           _normal.overflow_count.load(std::memory_order_relaxed) > 0;
+}
+
+bool UIDispatchQueue::canSpill() const {
+    TaskHandle_t consumer = _consumer_task.load(std::memory_order_relaxed);
+    return consumer == nullptr || consumer == xTaskGetCurrentTaskHandle();
+}
+
+void UIDispatchQueue::stamp(Slot& slot, const void* owner, UIUpdateKind kind) {
+    slot.key = owner ? findKey(owner) : nullptr;
+    slot.kind = (uint8_t)kind;
+    if (slot.key) {
+        slot.generation = slot.key->generation[slot.kind].fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+}
+
+void UIDispatchQueue::accepted(const Ring& ring) {
+    _pushed.fetch_add(1, std::memory_order_relaxed);
+    recordHighWater(ring);
+    wakeConsumer();
+}
+
+bool UIDispatchQueue::waitForRoom(bool keyed, bool& discard_requested, uint32_t& waited_ms) {
+    if (keyed) {
+        switch (_policy) {
+            case OverflowPolicy::DROP_NEWEST:
+                countDrop("update discarded");
+                return false;
+
+            case OverflowPolicy::DROP_OLDEST:
+                // The LVGL task discards it, so nothing is destroyed on this task
+                if (!discard_requested) {
+                    _discard_requests.fetch_add(1, std::memory_order_relaxed);
+                    discard_requested = true;
+                }
+                break;
+
+            case OverflowPolicy::BLOCK:
+                if (waited_ms >= _block_timeout_ms) {
+                    countDrop("update discarded");
+                    return false;
+                }
+                break;
+        }
+    }
+
+    // Unkeyed updates wait until push() spills them
+    wakeConsumer();
+    vTaskDelay(1);
+    waited_ms += portTICK_PERIOD_MS;
+    return true;
+}
+
+bool UIDispatchQueue::takeDiscardRequest() {
+    uint32_t requests = _discard_requests.load(std::memory_order_relaxed);
+    while (requests > 0) {
+        if (_discard_requests.compare_exchange_weak(requests, requests - 1, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void UIDispatchQueue::countDrop(const char* what) {
+    uint32_t dropped = _dropped.fetch_add(1, std::memory_order_relaxed) + 1;
+    Serial.printf("[UI-WARN] UI queue full, %s (%lu dropped). Core: %d\n",
+                  what, (unsigned long)dropped, xPortGetCoreID());
+}
+
+void UIDispatchQueue::recordHighWater(const Ring& ring) {
+    uint32_t pending = ring.pending();
+    uint32_t high_water = _high_water.load(std::memory_order_relaxed);
+    while (pending > high_water &&
+           !_high_water.compare_exchange_weak(high_water, pending, std::memory_order_relaxed)) {
+    }
+}
+
+UIDispatchQueue::Stats UIDispatchQueue::getStats() const {
+    Stats stats;
+    stats.pushed = _pushed.load(std::memory_order_relaxed);
+    stats.dropped = _dropped.load(std::memory_order_relaxed);
+    stats.high_water = _high_water.load(std::memory_order_relaxed);
+    stats.superseded = _superseded.load(std::memory_order_relaxed);
+    stats.spilled = _spilled.load(std::memory_order_relaxed);
+    stats.capacity = NORMAL_SLOTS;
+    return stats;
+}
+
+void UIDispatchQueue::wakeConsumer() {
+    TaskHandle_t consumer = _consumer_task.load(std::memory_order_relaxed);
+    if (consumer && consumer != xTaskGetCurrentTaskHandle()) {
+        xTaskNotifyGive(consumer);
+    }
+}
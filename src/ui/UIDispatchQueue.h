@@ -0,0 +1,373 @@
+#ifndef UI_DISPATCH_QUEUE_H
+#define UI_DISPATCH_QUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <list>
+#include <utility>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+/**
+ * @class UITask
+ * @brief Fixed-size, type-erased callable stored inline
+ *
+ * Replaces std::function for UI dispatch: the lambda is constructed directly
+ * in a queue slot and never touches the heap. Captures larger than CAPACITY
+ * fail to compile; capture a pointer or shared_ptr instead of big values.
+ */
+class UITask {
+public:
+    static constexpr size_t CAPACITY = 24 * sizeof(void*); ///< Inline capture space, ~a dozen shared_ptrs
+
+    UITask() = default;
+    UITask(const UITask&) = delete;
+    UITask& operator=(const UITask&) = delete;
+    ~UITask() { reset(); }
+
+    template <typename F>
+    void emplace(F&& func) {
+        using Fn = typename std::decay<F>::type;
+        static_assert(sizeof(Fn) <= CAPACITY, "UI callback captures too much, capture a pointer instead");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "UI callback is over-aligned");
+        reset();
+        new (_storage) Fn(std::forward<F>(func));
+        _invoke = [](void* storage) { (*static_cast<Fn*>(storage))(); };
+        _destroy = [](void* storage) { static_cast<Fn*>(storage)->~Fn(); };
+    }
+
+    void run() {
+        if (_invoke) _invoke(_storage);
+    }
+
+    void reset() {
+        if (_destroy) _destroy(_storage);
+        _invoke = nullptr;
+        _destroy = nullptr;
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char _storage[CAPACITY];
+    void (*_invoke)(void*) = nullptr;
+    void (*_destroy)(void*) = nullptr;
+};
+
+/**
+ * @brief What a keyed update replaces, combined with the owner it belongs to
+ */
+enum class UIUpdateKind : uint8_t {
+    RENDER, ///< Renderer view-model apply
+    TITLE,  ///< Card title text
+    COUNT
+};
+
+/**
+ * @class UIDispatchQueue
+ * @brief Bounded, allocation-free queue of UITasks for the LVGL thread
+ *
+ * Any task may push; only the LVGL task runs process(). A push from another
+ * task notifies the LVGL task, so it can sleep while the queue is empty. Each ring is a
+ * fixed array of slots with per-slot sequence numbers, so producers and the
+ * consumer coordinate with atomics only, without a lock or a heap allocation.
+ *
+ * Urgent pushes (to_front) go to a small separate ring that process() always
+ * drains first. When a ring is full the queue's OverflowPolicy decides which
+ * keyed update gives way, and every drop is counted. Unkeyed updates can
+ * carry structural work such as card teardown, so they are never dropped.
+ * They are parked in the ring's overflow list, which process() drains right
+ * after that ring: at once on the LVGL task, which can't wait on itself, and
+ * after the block timeout on other tasks. That wait is bounded because the
+ * LVGL task may itself be blocked on something the pushing task holds.
+ * Once a ring has spilled, later pushes to it queue behind the spill, so each
+ * task's updates still run in the order it pushed them.
+ *
+ * Updates pushed with a key (owner + UIUpdateKind) are latest-wins: each push
+ * bumps the key's generation, and process() skips any pending update whose
+ * generation has since been superseded, so only the newest state is drawn.
+ */
+class UIDispatchQueue {
+public:
+    enum class OverflowPolicy : uint8_t {
+        DROP_NEWEST, ///< Reject the keyed update being pushed
+        DROP_OLDEST, ///< Have process() discard the oldest pending keyed update, then wait for room
+        BLOCK        ///< Wait for room; a keyed update gives up after the block timeout
+    };
+
+    struct Stats {
+        uint32_t pushed;     ///< Updates accepted
+        uint32_t dropped;    ///< Keyed updates discarded by the overflow policy
+        uint32_t high_water; ///< Most updates pending at once
+        uint32_t superseded; ///< Keyed updates skipped because a newer one was queued
+        uint32_t spilled;    ///< Updates parked in an overflow list because a ring was full
+        uint32_t capacity;   ///< Slots in the normal ring
+    };
+
+    /**
+     * @param policy What to do when a ring is full
+     * @param block_timeout_ms Longest a keyed BLOCK push waits before dropping, and an
+     *                         unkeyed push from another task waits before spilling
+     */
+    explicit UIDispatchQueue(OverflowPolicy policy = OverflowPolicy::BLOCK, uint32_t block_timeout_ms = 500);
+    ~UIDispatchQueue();
+
+    /**
+     * @brief Queue a callable to run on the LVGL task
+     *
+     * @param func Callable taking no arguments, moved into a slot
+     * @param to_front Use the urgent ring, which runs before normal updates
+     * @return true if queued; unkeyed updates always are
+     */
+    template <typename F>
+    bool push(F&& func, bool to_front = false) {
+        return push(std::forward<F>(func), to_front, nullptr, UIUpdateKind::COUNT);
+    }
+
+    /**
+     * @brief Queue a keyed update, replacing any pending one with the same key
+     *
+     * @param owner Object the update is for, usually the card
+     * @param kind Which of the owner's updates this is
+     */
+    template <typename F>
+    bool push(F&& func, bool to_front, const void* owner, UIUpdateKind kind) {
+        Ring& ring = to_front ? _urgent : _normal;
+        bool spill = canSpill();
+        bool discard_requested = false;
+        uint32_t waited_ms = 0;
+        for (;;) {
+            uint32_t pos;
+            // Once this ring has spilled, queue behind it to keep each task's updates in order
+            bool behind_spill = ring.overflow_count.load(std::memory_order_acquire) > 0;
+            Slot* slot = behind_spill ? nullptr : ring.claimWrite(pos);
+            if (slot) {
+                if (discard_requested) {
+                    takeDiscardRequest();
+                }
+                stamp(*slot, owner, kind);
+                slot->task.emplace(std::forward<F>(func));
+                ring.publishWrite(*slot, pos);
+                accepted(ring);
+                return true;
+            }
+
+            if (spill || behind_spill) {
+                if (discard_requested) {
+                    takeDiscardRequest();
+                }
+                xSemaphoreTake(_overflow_mutex, portMAX_DELAY);
+                ring.overflow.emplace_back();
+                Slot& spilled = ring.overflow.back();
+                stamp(spilled, owner, kind);
+                spilled.task.emplace(std::forward<F>(func));
+                ring.overflow_count.fetch_add(1, std::memory_order_release);
+                xSemaphoreGive(_overflow_mutex);
+                _spilled.fetch_add(1, std::memory_order_relaxed);
+                accepted(ring);
+                return true;
+            }
+
+            if (!waitForRoom(owner != nullptr, discard_requested, waited_ms)) {
+                return false;
+            }
+            // Unkeyed updates can't be dropped, so after the block timeout they spill
+            spill = !owner && waited_ms >= _block_timeout_ms;
+        }
+    }
+
+    /**
+     * @brief Run pending updates, urgent ones first
+     *
+     * LVGL task only. With a budget, stops once that much time has been spent
+     * and leaves the rest queued for the next call, so the caller can poll
+     * input and let LVGL draw in between. At least one update always runs.
+     *
+     * @param budget_us Time slice in microseconds, 0 to drain the queue
+     * @return Number of updates taken off the queue, run or superseded
+     */
+    size_t process(uint32_t budget_us = 0);
+
+    /**
+     * @brief Free an owner's key entry once it's gone, so the entry can be reused
+     *
+     * Any task. Keyed updates the owner still has queued are skipped as
+     * superseded. Unkeyed ones still run, so they must not reach the owner
+     * directly; capture something that outlives it.
+     */
+    void forgetOwner(const void* owner);
+
+    /**
+     * @brief Whether any update is still waiting to run, overflow included
+     */
+    bool hasPending() const;
+
+    Stats getStats() const;
+
+private:
+    static constexpr uint32_t NORMAL_SLOTS = 32; ///< Power of two
+    static constexpr uint32_t URGENT_SLOTS = 8;  ///< Power of two
+    static constexpr uint32_t KEY_SLOTS = 64;    ///< Live owners tracked at once
+
+    // Latest generation pushed for each kind of an owner's updates. Generations
+    // carry on when an entry is reused, so a forgotten owner's slots can't match.
+    struct KeyEntry {
+        std::atomic<const void*> owner;
+        std::atomic<uint32_t> generation[(size_t)UIUpdateKind::COUNT];
+    };
+
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        KeyEntry* key;       ///< nullptr for unkeyed updates
+        uint8_t kind;
+        uint32_t generation; ///< Key generation this update was pushed as
+        UITask task;
+    };
+
+    // Bounded ring with per-slot sequence numbers. A slot is writable when its
+    // sequence equals the write position and readable when it equals
+    // position + 1; positions are claimed with compare-and-swap. Only the
+    // consumer reads, so updates are only ever run or discarded on the LVGL task.
+    struct Ring {
+        Slot* slots;
+        uint32_t mask;
+        std::atomic<uint32_t> write_pos;
+        std::atomic<uint32_t> read_pos;
+
+        // Pushes that found this ring full, guarded by _overflow_mutex.
+        // Heap-allocated, but only touched when a burst outruns the ring, e.g.
+        // many cards torn down at once
+        std::list<Slot> overflow;
+        std::atomic<uint32_t> overflow_count; ///< Lets process() skip the lock while nothing has spilled
+
+        Ring(Slot* storage, uint32_t size);
+        Slot* claimWrite(uint32_t& pos);
+        void publishWrite(Slot& slot, uint32_t pos);
+        Slot* claimRead(uint32_t& pos);
+        void releaseRead(Slot& slot, uint32_t pos);
+        uint32_t pending() const;
+    };
+
+    Slot _normal_slots[NORMAL_SLOTS];
+    Slot _urgent_slots[URGENT_SLOTS];
+    Ring _normal;
+    Ring _urgent;
+    KeyEntry _keys[KEY_SLOTS];
+
+    SemaphoreHandle_t _overflow_mutex; ///< Guards both rings' overflow lists
+
+    const OverflowPolicy _policy;
+    const uint32_t _block_timeout_ms;
+    std::atomic<TaskHandle_t> _consumer_task; ///< Task seen running process(), never blocked on itself
+    std::atomic<uint32_t> _discard_requests;  ///< Outstanding DROP_OLDEST requests for process() to discard an update
+
+    std::atomic<uint32_t> _pushed;
+    std::atomic<uint32_t> _dropped;
+    std::atomic<uint32_t> _high_water;
+    std::atomic<uint32_t> _superseded;
+    std::atomic<uint32_t> _spilled;
+
+    /**
+     * @brief Find or claim the key table entry for an owner
+     * @return nullptr if the table is full, in which case the update is unkeyed
+     */
+    KeyEntry* findKey(const void* owner);
+
+    /**
+     * @brief Whether this task must spill at once rather than wait for room
+     *
+     * True on the LVGL task, and on any task before process() first runs,
+     * since nothing would drain the ring while it waited.
+     */
+    bool canSpill() const;
+
+    /**
+     * @brief Key a slot and take the next generation for it
+     * Call only once the update is sure to be queued.
+     */
+    void stamp(Slot& slot, const void* owner, UIUpdateKind kind);
+
+    void accepted(const Ring& ring);
+
+    /**
+     * @brief Apply the overflow policy while another task's ring is full
+     * Waits a tick and adds it to waited_ms.
+     * @return true to retry the push, false to drop this keyed update
+     */
+    bool waitForRoom(bool keyed, bool& discard_requested, uint32_t& waited_ms);
+
+    /**
+     * @brief Take one outstanding DROP_OLDEST request, if there is one
+     *
+     * process() takes a request when it discards an update for it. A push
+     * that made a request takes one back once it has a slot, whether or not
+     * process() got to it. If process() already had, that withdraws another
+     * waiting producer's request, which then gets room the usual way: at worst
+     * an update runs that could have been dropped, but no request is left
+     * behind to discard an unrelated update later.
+     *
+     * @return false if none was outstanding
+     */
+    bool takeDiscardRequest();
+
+    /**
+     * @brief Run or skip one queued update and reset it, on the LVGL task
+     * @param ring Ring the update came from, where DROP_OLDEST may discard it; nullptr if spilled
+     */
+    void runSlot(Slot& slot, const Ring* ring);
+
+    /**
+     * @brief Run or skip the next update from a ring, then from its overflow list
+     * @return false if both were empty
+     */
+    bool runNext(Ring& ring);
+
+    /**
+     * @brief Take the oldest spilled update off a ring's overflow list and run it
+     * @return false if the list was empty
+     */
+    bool runSpilled(Ring& ring);
+
+    void countDrop(const char* what);
+
+    void recordHighWater(const Ring& ring);
+
+    /**
+     * @brief Wake the LVGL task if it's sleeping until its next timer
+     */
+    void wakeConsumer();
+};
+
+/**
+ * @brief Handle components use to reach the UI dispatch queue
+ *
+ * Callable like the std::function it replaces:
+ * `if (globalUIDispatch) globalUIDispatch([this]() { ... }, false);`
+ */
+struct UIDispatch {
+    UIDispatchQueue* queue = nullptr;
+
+    explicit operator bool() const { return queue != nullptr; }
+
+    template <typename F>
+    bool operator()(F&& func, bool to_front = false) const {
+        return queue ? queue->push(std::forward<F>(func), to_front) : false;
+    }
+
+    /**
+     * @brief Keyed, latest-wins dispatch
+     * A pending update with the same owner and kind is skipped in favour of this one.
+     */
+    template <typename F>
+    bool operator()(F&& func, bool to_front, const void* owner, UIUpdateKind kind) const {
+        return queue ? queue->push(std::forward<F>(func), to_front, owner, kind) : false;
+    }
+
+    void forgetOwner(const void* owner) const {
+        if (queue) queue->forgetOwner(owner);
+    }
+};
+
+#endif // UI_DISPATCH_QUEUE_H
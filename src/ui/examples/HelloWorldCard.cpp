@@ -6,6 +6,10 @@ HelloWorldCard::HelloWorldCard(lv_obj_t* parent) : _card(nullptr), _label(nullpt
     lv_obj_set_size(_card, LV_PCT(100), LV_PCT(100)); // Make it fill the entire screen
     lv_obj_set_style_bg_color(_card, lv_color_black(), 0); // Set background to black
     
+    createLabel();
+}
+
+void HelloWorldCard::createLabel() {
     _label = lv_label_create(_card); // Create a label on the card
     lv_label_set_text(_label, "Hello, world!"); // Set the text content
     lv_obj_set_style_text_color(_label, lv_color_white(), 0); // Set text color to white
@@ -13,10 +17,37 @@ HelloWorldCard::HelloWorldCard(lv_obj_t* parent) : _card(nullptr), _label(nullpt
     lv_obj_center(_label); // Center the label on the card
 }
 
+bool HelloWorldCard::releaseContent() {
+    if (!_card) return false;
+    
+    // Keep only the card's size so it still holds its slot in the stack
+    lv_coord_t width = lv_obj_get_style_width(_card, LV_PART_MAIN);
+    lv_coord_t height = lv_obj_get_style_height(_card, LV_PART_MAIN);
+    lv_obj_clean(_card);
+    _label = nullptr;
+    lv_obj_remove_style_all(_card);
+    lv_obj_set_size(_card, width, height);
+    return true;
+}
+
+void HelloWorldCard::restoreContent() {
+    if (!_card) return;
+    
+    lv_coord_t width = lv_obj_get_style_width(_card, LV_PART_MAIN);
+    lv_coord_t height = lv_obj_get_style_height(_card, LV_PART_MAIN);
+    lv_theme_apply(_card);
+    lv_obj_set_size(_card, width, height);
+    lv_obj_set_style_bg_color(_card, lv_color_black(), 0);
+    lv_obj_set_style_border_width(_card, 0, 0);
+    createLabel();
+}
+
 bool HelloWorldCard::handleButtonPress(uint8_t button_index) {
     // Toggle between black and white backgrounds
     static bool isBlack = true;
     
+    if (!_label) return false;
+    
     if (isBlack) {
         lv_obj_set_style_bg_color(_card, lv_color_white(), 0);
         lv_obj_set_style_text_color(_label, lv_color_black(), 0);
@@ -12,8 +12,12 @@ public:
     
     bool handleButtonPress(uint8_t button_index) override;
     void prepareForRemoval() override { _card = nullptr; }
+    bool releaseContent() override;
+    void restoreContent() override;
 
 private:
     lv_obj_t* _card;
     lv_obj_t* _label;
+    
+    void createLabel();
 };
\ No newline at end of file
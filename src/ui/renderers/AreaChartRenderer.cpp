@@ -0,0 +1,297 @@
+#include "AreaChartRenderer.h"
+#include "SeriesDecimator.h"
+#include <algorithm> // For std::min, std::max
+#include <new>       // For std::nothrow
+
+// Current period matches the first line graph series; the previous period is drawn in grey behind it
+static const uint32_t BG_COLOR = 0x050505;       // Same as the line graph background
+static const uint32_t CURRENT_COLOR = 0x2980b9;  // Blue
+static const uint32_t PREVIOUS_COLOR = 0x7f8c8d; // Grey
+
+AreaChartRenderer::AreaChartRenderer(std::shared_ptr<WidgetPool> widget_pool)
+    : InsightRendererBase(std::move(widget_pool)), _canvas(nullptr), _width(0), _height(0), _stride(0) {
+    lv_color_t bg = lv_color_hex(BG_COLOR);
+    lv_color_t current = lv_color_hex(CURRENT_COLOR);
+    lv_color_t previous = lv_color_hex(PREVIOUS_COLOR);
+    lv_color_t previous_fill = lv_color_mix(previous, bg, LV_OPA_20);
+
+    _bg_color = lv_color_to_u16(bg);
+    _current_fill = lv_color_to_u16(lv_color_mix(current, bg, LV_OPA_40));
+    _current_line = lv_color_to_u16(current);
+    _previous_fill = lv_color_to_u16(previous_fill);
+    _previous_line = lv_color_to_u16(previous);
+    _overlap_fill = lv_color_to_u16(lv_color_mix(current, previous_fill, LV_OPA_40));
+    // Serial.println("[AreaChartRenderer] Constructor");
+}
+
+AreaChartRenderer::~AreaChartRenderer() {
+    // Serial.println("[AreaChartRenderer] Destructor");
+    // Relies on InsightCard calling clearElements before destruction,
+    // so the canvas no longer references the pixel buffer freed here.
+}
+
+void AreaChartRenderer::createElements(lv_obj_t* parent_container) {
+    if (!isValidLVGLObject(parent_container)) {
+        Serial.println("[AreaChartRenderer-ERROR] Parent container invalid in createElements.");
+        return;
+    }
+
+    _canvas = acquireWidget(WidgetPool::Kind::CANVAS, parent_container);
+    if (!_canvas) {
+        Serial.println("[AreaChartRenderer-ERROR] Failed to create canvas object.");
+        return;
+    }
+
+    // The canvas takes its size from the pixel buffer, which is bound on the
+    // first apply() once the content geometry is known
+    lv_obj_align(_canvas, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_clear_flag(_canvas, LV_OBJ_FLAG_SCROLLABLE);
+    _width = 0;
+    _height = 0;
+}
+
+void AreaChartRenderer::columnTops(const double* values, size_t count, double range_max,
+                                   lv_coord_t width, lv_coord_t height, int16_t* tops) {
+    if (count == 0) {
+        std::fill_n(tops, width, (int16_t)height);
+        return;
+    }
+
+    // More points than columns can't be seen, so decimate to the canvas width
+    if (count > (size_t)width) {
+        _decimated_values.resize(width);
+        count = SeriesDecimator::lttb(values, count, _decimated_values.data(), width);
+        values = _decimated_values.data();
+    }
+
+    for (lv_coord_t x = 0; x < width; ++x) {
+        double value = values[0];
+        if (count > 1) {
+            // Interpolate between the two points either side of this column
+            double pos = (double)x * (count - 1) / (width - 1);
+            size_t i = (size_t)pos;
+            if (i >= count - 1) {
+                value = values[count - 1];
+            } else {
+                value = values[i] + (values[i + 1] - values[i]) * (pos - i);
+            }
+        }
+        if (value < 0) value = 0; // Area fills down to zero
+
+        int32_t filled = (int32_t)(value / range_max * (height - 1) + 0.5);
+        tops[x] = (int16_t)(height - 1 - std::min(filled, (int32_t)(height - 1)));
+    }
+}
+
+std::unique_ptr<InsightRendererBase::ViewModel> AreaChartRenderer::prepare(const InsightModel& model, const Geometry& geometry) {
+    // Runs on the event task: resampling to columns happens here, apply() only
+    // rasterises the columns that differ from the canvas.
+    lv_coord_t width = std::min(geometry.width, (lv_coord_t)MAX_WIDTH);
+    lv_coord_t height = std::min(geometry.height, (lv_coord_t)MAX_HEIGHT);
+    if (width < 2 || height < 2) {
+        Serial.println("[AreaChartRenderer-ERROR] Content area too small to draw into.");
+        return nullptr;
+    }
+
+    std::unique_ptr<AreaViewModel> view_model(new AreaViewModel());
+    view_model->width = width;
+    view_model->height = height;
+    view_model->current_top.assign(width, height);
+    view_model->previous_top.assign(width, height);
+
+    // First series of each period; further series aren't stacked
+    int current_index = -1;
+    int previous_index = -1;
+    for (size_t s = 0; s < model.series_count; ++s) {
+        if (model.series_lengths[s] == 0) continue;
+        bool is_previous = model.series_previous_mask & (1 << s);
+        if (is_previous && previous_index < 0) {
+            previous_index = s;
+        } else if (!is_previous && current_index < 0) {
+            current_index = s;
+        }
+    }
+
+    if (current_index < 0 && previous_index < 0) {
+        // No data - an all-empty view-model clears the canvas
+        return std::move(view_model);
+    }
+
+    // Both periods share one scale so they can be compared
+    double max_val = 0.0;
+    for (int s : {current_index, previous_index}) {
+        if (s < 0) continue;
+        const double* values = model.seriesData(s);
+        for (size_t i = 0; i < model.series_lengths[s]; ++i) {
+            max_val = std::max(max_val, values[i]);
+        }
+    }
+    if (max_val <= 0) max_val = 1.0; // All zero or negative, keep the area on the baseline
+    double range_max = max_val * 1.1; // Same headroom as the line graph
+
+    if (current_index >= 0) {
+        columnTops(model.seriesData(current_index), model.series_lengths[current_index],
+                   range_max, width, height, view_model->current_top.data());
+    }
+    if (previous_index >= 0) {
+        columnTops(model.seriesData(previous_index), model.series_lengths[previous_index],
+                   range_max, width, height, view_model->previous_top.data());
+        view_model->has_previous = true;
+    }
+
+    return std::move(view_model);
+}
+
+bool AreaChartRenderer::resizeCanvas(lv_coord_t width, lv_coord_t height) {
+    uint32_t stride = lv_draw_buf_width_to_stride(width, LV_COLOR_FORMAT_RGB565) / sizeof(uint16_t);
+    if (!_pixels || stride != _stride || height != _height) {
+        // Free the old buffer first so peak use stays at one canvas; nothing
+        // draws the canvas before it is rebound below on this same thread
+        _pixels.reset();
+        // Large enough to go to PSRAM; at most MAX_WIDTH x MAX_HEIGHT
+        _pixels.reset(new (std::nothrow) uint16_t[stride * height]);
+        if (!_pixels) {
+            lv_obj_add_flag(_canvas, LV_OBJ_FLAG_HIDDEN); // Still bound to the freed buffer
+            Serial.printf("[AreaChartRenderer-ERROR] Failed to allocate %ux%u canvas.\n",
+                          (unsigned int)width, (unsigned int)height);
+            _width = 0;
+            _height = 0;
+            return false;
+        }
+    }
+
+    lv_canvas_set_buffer(_canvas, _pixels.get(), width, height, LV_COLOR_FORMAT_RGB565);
+    lv_obj_clear_flag(_canvas, LV_OBJ_FLAG_HIDDEN);
+    _width = width;
+    _height = height;
+    _stride = stride;
+    _drawn_current.assign(width, height);
+    _drawn_previous.assign(width, height);
+    return true;
+}
+
+void AreaChartRenderer::fillSpan(lv_coord_t x, int32_t y1, int32_t y2, uint16_t color) {
+    y1 = std::max(y1, (int32_t)0);
+    y2 = std::min(y2, (int32_t)_height);
+    uint16_t* pixel = _pixels.get() + y1 * _stride + x;
+    for (int32_t y = y1; y < y2; ++y) {
+        *pixel = color;
+        pixel += _stride;
+    }
+}
+
+void AreaChartRenderer::fillColumn(const AreaViewModel& update, lv_coord_t x) {
+    const int32_t current = update.current_top[x];
+    const int32_t previous = update.previous_top[x];
+
+    // Top to bottom: background, the higher area alone, then both areas overlapping
+    fillSpan(x, 0, std::min(current, previous), _bg_color);
+    if (previous < current) {
+        fillSpan(x, previous, current, _previous_fill);
+        fillSpan(x, current, _height, _overlap_fill);
+    } else {
+        fillSpan(x, current, previous, _current_fill);
+        fillSpan(x, previous, _height, _overlap_fill);
+    }
+
+    // Edges run up or down to the previous column's top, two pixels thick
+    auto edge = [&](const std::vector<int16_t>& tops, uint16_t color) {
+        int32_t top = tops[x];
+        if (top >= _height) return;
+        int32_t left = (x > 0 && tops[x - 1] < _height) ? tops[x - 1] : top;
+        fillSpan(x, std::min(top, left), std::max(top, left) + 2, color);
+    };
+    if (update.has_previous) {
+        edge(update.previous_top, _previous_line);
+    }
+    edge(update.current_top, _current_line);
+}
+
+void AreaChartRenderer::invalidateColumns(lv_coord_t x1, lv_coord_t x2) {
+    lv_area_t area;
+    lv_obj_get_coords(_canvas, &area);
+    area.x2 = area.x1 + x2;
+    area.x1 += x1;
+    lv_obj_invalidate_area(_canvas, &area);
+}
+
+void AreaChartRenderer::apply(const ViewModel& view_model) {
+    const AreaViewModel& update = static_cast<const AreaViewModel&>(view_model);
+
+    if (!areElementsValid()) {
+        Serial.println("[AreaChartRenderer-WARN] Canvas invalid in apply.");
+        return;
+    }
+
+    bool full = false;
+    if (!_pixels || update.width != _width || update.height != _height) {
+        if (!resizeCanvas(update.width, update.height)) return;
+        full = true;
+    }
+
+    // A column is redrawn when its own heights changed, or its left neighbour's
+    // did, since its edge joins to that neighbour
+    lv_coord_t run_x1[MAX_INVALIDATED_RUNS];
+    lv_coord_t run_x2[MAX_INVALIDATED_RUNS];
+    size_t run_count = 0;
+    bool invalidate_all = full;
+    lv_coord_t run_start = -1;
+    bool left_changed = false;
+    size_t redrawn = 0;
+
+    for (lv_coord_t x = 0; x <= _width; ++x) {
+        bool dirty = false;
+        if (x < _width) {
+            bool changed = full ||
+                           update.current_top[x] != _drawn_current[x] ||
+                           update.previous_top[x] != _drawn_previous[x];
+            dirty = changed || left_changed;
+            left_changed = changed;
+        }
+
+        if (dirty) {
+            fillColumn(update, x);
+            redrawn++;
+            if (run_start < 0) run_start = x;
+        } else if (run_start >= 0) {
+            if (run_count < MAX_INVALIDATED_RUNS) {
+                run_x1[run_count] = run_start;
+                run_x2[run_count] = x - 1;
+                run_count++;
+            } else {
+                invalidate_all = true;
+            }
+            run_start = -1;
+        }
+    }
+
+    if (redrawn == 0) return;
+
+    _drawn_current = update.current_top;
+    _drawn_previous = update.previous_top;
+
+    if (invalidate_all) {
+        lv_obj_invalidate(_canvas);
+    } else {
+        for (size_t i = 0; i < run_count; ++i) {
+            invalidateColumns(run_x1[i], run_x2[i]);
+        }
+    }
+}
+
+void AreaChartRenderer::clearElements() {
+    // Expected to be called from LVGL UI thread.
+    releaseWidget(_canvas); // The pool unbinds our pixel buffer
+    _canvas = nullptr;
+    // Canvas no longer references the buffer, so it can go too
+    _pixels.reset();
+    _width = 0;
+    _height = 0;
+    _drawn_current.clear();
+    _drawn_previous.clear();
+}
+
+bool AreaChartRenderer::areElementsValid() const {
+    // Can be called from any thread.
+    return isValidLVGLObject(_canvas);
+}
@@ -0,0 +1,101 @@
+#ifndef AREA_CHART_RENDERER_H
+#define AREA_CHART_RENDERER_H
+
+#include "InsightRendererBase.h"
+#include "../Style.h" // For styles, colors, fonts
+#include <memory>
+#include <vector>
+
+/**
+ * @class AreaChartRenderer
+ * @brief Draws an area chart, and its compare-to-previous period, into one canvas
+ *
+ * Each pixel column of the chart is a vertical run from the series value down
+ * to the baseline, so the filled polygon is rasterised column by column as a
+ * handful of solid spans written straight into an RGB565 canvas buffer. This
+ * keeps the whole chart to a single LVGL object however many points it has.
+ *
+ * prepare() turns the series into per-column heights off the UI thread;
+ * apply() compares them with what is already on the canvas and only redraws
+ * and invalidates the columns that changed.
+ */
+class AreaChartRenderer : public InsightRendererBase {
+public:
+    explicit AreaChartRenderer(std::shared_ptr<WidgetPool> widget_pool = nullptr);
+    ~AreaChartRenderer() override;
+
+    void createElements(lv_obj_t* parent_container) override;
+    std::unique_ptr<ViewModel> prepare(const InsightModel& model, const Geometry& geometry) override;
+    void apply(const ViewModel& view_model) override;
+    void clearElements() override;
+    bool areElementsValid() const override;
+
+private:
+    // Upper bound on the canvas, so the pixel buffer never grows past MAX_WIDTH x MAX_HEIGHT x 2 bytes
+    static constexpr lv_coord_t MAX_WIDTH = 320;
+    static constexpr lv_coord_t MAX_HEIGHT = 240;
+    static constexpr size_t MAX_INVALIDATED_RUNS = 8; ///< More changed runs than this invalidate the whole canvas
+
+    struct AreaViewModel : ViewModel {
+        lv_coord_t width = 0;
+        lv_coord_t height = 0;
+        bool has_previous = false;
+        // Topmost filled row per column; `height` means the column is empty
+        std::vector<int16_t> current_top;
+        std::vector<int16_t> previous_top;
+    };
+
+    lv_obj_t* _canvas;
+
+    // Pixel buffer bound to the canvas. Only touched on the UI thread.
+    std::unique_ptr<uint16_t[]> _pixels;
+    lv_coord_t _width;
+    lv_coord_t _height;
+    uint32_t _stride; ///< Row length of _pixels in pixels
+
+    // Column heights currently on the canvas, used as the diff baseline
+    std::vector<int16_t> _drawn_current;
+    std::vector<int16_t> _drawn_previous;
+
+    // Producer-side scratch space, only touched from prepare()
+    std::vector<double> _decimated_values;
+
+    // RGB565 colors, resolved once
+    uint16_t _bg_color;
+    uint16_t _current_fill;
+    uint16_t _current_line;
+    uint16_t _previous_fill;
+    uint16_t _previous_line;
+    uint16_t _overlap_fill; ///< Current period fill over the previous period's
+
+    /**
+     * @brief Resample a series to one height per pixel column
+     * Decimates long series first, then interpolates linearly between points.
+     */
+    void columnTops(const double* values, size_t count, double range_max,
+                    lv_coord_t width, lv_coord_t height, int16_t* tops);
+
+    /**
+     * @brief (Re)bind a pixel buffer of the given size to the canvas
+     * The buffer is only reallocated when the size changes.
+     */
+    bool resizeCanvas(lv_coord_t width, lv_coord_t height);
+
+    /**
+     * @brief Rasterise one pixel column from the view-model's heights
+     * The edge joins to the previous column's top, so steep slopes stay connected.
+     */
+    void fillColumn(const AreaViewModel& update, lv_coord_t x);
+
+    /**
+     * @brief Write a solid vertical span [y1, y2) into column x
+     */
+    void fillSpan(lv_coord_t x, int32_t y1, int32_t y2, uint16_t color);
+
+    /**
+     * @brief Invalidate canvas columns [x1, x2]
+     */
+    void invalidateColumns(lv_coord_t x1, lv_coord_t x2);
+};
+
+#endif // AREA_CHART_RENDERER_H
@@ -2,8 +2,8 @@
 #include "NumberFormat.h"
 #include <algorithm> // For std::min, std::max
 
-FunnelRenderer::FunnelRenderer()
-    : _funnel_main_container(nullptr) {
+FunnelRenderer::FunnelRenderer(std::shared_ptr<WidgetPool> widget_pool)
+    : InsightRendererBase(std::move(widget_pool)), _funnel_main_container(nullptr) {
     resetElementPointers();
     initBreakdownColors(); // Initialize colors at construction
     // Serial.println("[FunnelRenderer] Constructor");
@@ -45,7 +45,7 @@ void FunnelRenderer::createElements(lv_obj_t* parent_container) {
 
     // Create a main container for all funnel elements within the parent_container
     // This allows easier clearing and management.
-    _funnel_main_container = lv_obj_create(parent_container);
+    _funnel_main_container = acquireWidget(WidgetPool::Kind::BOX, parent_container);
     if (!_funnel_main_container) {
         Serial.println("[FunnelRenderer-ERROR] Failed to create _funnel_main_container.");
         return;
@@ -61,7 +61,7 @@ void FunnelRenderer::createElements(lv_obj_t* parent_container) {
 
     for (int i = 0; i < MAX_FUNNEL_STEPS; ++i) {
         // Create bar container (a simple object to hold segments)
-        _funnel_step_bars[i] = lv_obj_create(_funnel_main_container);
+        _funnel_step_bars[i] = acquireWidget(WidgetPool::Kind::BOX, _funnel_main_container);
         if (!_funnel_step_bars[i]) continue; // Error handling: skip if creation fails
         
         lv_obj_set_size(_funnel_step_bars[i], available_width, FUNNEL_BAR_HEIGHT);
@@ -72,7 +72,7 @@ void FunnelRenderer::createElements(lv_obj_t* parent_container) {
         lv_obj_add_flag(_funnel_step_bars[i], LV_OBJ_FLAG_HIDDEN); // Initially hidden
 
         // Create label for the step
-        _funnel_step_labels[i] = lv_label_create(_funnel_main_container);
+        _funnel_step_labels[i] = acquireWidget(WidgetPool::Kind::LABEL, _funnel_main_container);
         if (!_funnel_step_labels[i]) continue;
 
         lv_obj_set_style_text_color(_funnel_step_labels[i], Style::valueColor(), 0);
@@ -84,7 +84,7 @@ void FunnelRenderer::createElements(lv_obj_t* parent_container) {
 
         // Create segments within the bar container
         for (int j = 0; j < MAX_BREAKDOWNS; ++j) {
-            _funnel_bar_segments[i][j] = lv_obj_create(_funnel_step_bars[i]);
+            _funnel_bar_segments[i][j] = acquireWidget(WidgetPool::Kind::BOX, _funnel_step_bars[i]);
             if (!_funnel_bar_segments[i][j]) continue;
 
             lv_obj_set_height(_funnel_bar_segments[i][j], FUNNEL_BAR_HEIGHT);
@@ -98,70 +98,33 @@ void FunnelRenderer::createElements(lv_obj_t* parent_container) {
     // Serial.println("[FunnelRenderer] Funnel elements created successfully.");
 }
 
-void FunnelRenderer::updateDisplay(InsightParser& parser, const String& title_str, const char* prefix, const char* suffix) {
-    // prefix and suffix are ignored for FunnelRenderer.
-    Serial.printf("[FunnelRenderer] updateDisplay for title: %s\n", title_str.c_str()); // Verify this is called
-
-    size_t raw_step_count = parser.getFunnelStepCount();
-    size_t raw_breakdown_count = parser.getFunnelBreakdownCount();
-    Serial.printf("[FunnelRenderer] Parser reports: step_count = %u, breakdown_count = %u\n",
-                  (unsigned int)raw_step_count, (unsigned int)raw_breakdown_count);
-
-    size_t step_count = std::min(raw_step_count, static_cast<size_t>(MAX_FUNNEL_STEPS));
-    size_t breakdown_count = std::min(raw_breakdown_count, static_cast<size_t>(MAX_BREAKDOWNS));
+std::unique_ptr<InsightRendererBase::ViewModel> FunnelRenderer::prepare(const InsightModel& model, const Geometry& geometry) {
+    std::unique_ptr<FunnelViewModel> view_model(new FunnelViewModel());
+    size_t step_count = model.funnel_step_count;
+    size_t breakdown_count = model.funnel_breakdown_count;
+    view_model->step_count = step_count;
+    view_model->breakdown_count = breakdown_count;
+    view_model->bar_width = geometry.width; // Main container fills the content area with no padding
     Serial.printf("[FunnelRenderer] Effective: step_count = %u, breakdown_count = %u\n",
                   (unsigned int)step_count, (unsigned int)breakdown_count);
 
     if (step_count == 0) {
         Serial.println("[FunnelRenderer] step_count is 0, hiding elements.");
-        // No steps, clear display or show message
-        dispatchToUI([this]() {
-            if (!areElementsValid()) return;
-            for (int i = 0; i < MAX_FUNNEL_STEPS; ++i) {
-                if (isValidLVGLObject(_funnel_step_bars[i])) lv_obj_add_flag(_funnel_step_bars[i], LV_OBJ_FLAG_HIDDEN);
-                if (isValidLVGLObject(_funnel_step_labels[i])) lv_obj_add_flag(_funnel_step_labels[i], LV_OBJ_FLAG_HIDDEN);
-            }
-        });
-        return;
-    }
-
-    uint32_t step_counts_total[MAX_FUNNEL_STEPS] = {0};
-    // Conversion rates not directly used for display here, but parser might need it.
-    if (!parser.getFunnelTotalCounts(0, step_counts_total, nullptr)) {
-        Serial.println("[FunnelRenderer-ERROR] Failed to get funnel total counts from parser.");
-        return;
+        return std::move(view_model);
     }
 
+    const uint32_t* step_counts_total = model.funnel_step_totals;
     uint32_t total_first_step = step_counts_total[0];
     Serial.printf("[FunnelRenderer] total_first_step = %u\n", (unsigned int)total_first_step);
-    if (total_first_step == 0 && step_count > 0) { // Allow processing if step_count is 0 (handled above)
+    if (total_first_step == 0) {
         Serial.println("[FunnelRenderer-WARN] First funnel step count is zero. Funnel will appear empty or scaled strangely.");
-        // To avoid division by zero later, if we must proceed, set to 1, but data is effectively empty.
-        // total_first_step = 1; // Or, clear display as above.
     }
 
-    // Prepare data structure for UI update lambda
-    struct FunnelStepUIData {
-        String label_text;
-        float relative_width_to_first_step; // 0.0 - 1.0
-        struct SegmentUIData {
-            float width_pixels; 
-            float offset_pixels; 
-            lv_color_t color; // Added to store color for sorted segments
-        } segments[MAX_BREAKDOWNS];
-    };
-    std::vector<FunnelStepUIData> ui_steps_data(step_count);
-
-    lv_coord_t available_width_for_bars = lv_obj_get_content_width(_funnel_main_container);
-
     for (size_t i = 0; i < step_count; ++i) {
-        FunnelStepUIData& current_ui_step = ui_steps_data[i];
-        current_ui_step.relative_width_to_first_step = (total_first_step > 0) ? 
+        FunnelViewModel::Step& current_ui_step = view_model->steps[i];
+        float relative_width_to_first_step = (total_first_step > 0) ? 
             static_cast<float>(step_counts_total[i]) / total_first_step : 0.0f;
 
-        char step_name_buffer[64] = {0};
-        parser.getFunnelStepData(0, i, step_name_buffer, sizeof(step_name_buffer), nullptr, nullptr, nullptr);
-        
         char number_buffer[20];
         NumberFormat::addThousandsSeparators(number_buffer, sizeof(number_buffer), step_counts_total[i]);
 
@@ -178,22 +141,26 @@ void FunnelRenderer::updateDisplay(InsightParser& parser, const String& title_st
             new_label_format = String(percentage_val) + "% - " + String(number_buffer);
         }
 
-        if (step_name_buffer[0] != '\0') {
+        if (model.funnel_step_names[i].length() > 0) {
             new_label_format += " - ";
-            new_label_format += step_name_buffer;
+            new_label_format += model.funnel_step_names[i];
         }
         current_ui_step.label_text = new_label_format;
 
         // Calculate breakdown segments for this step
-        uint32_t breakdown_val_counts[MAX_BREAKDOWNS] = {0};
-        if (parser.getFunnelBreakdownComparison(i, breakdown_val_counts, nullptr) && step_counts_total[i] > 0) {
-            float total_width_for_this_step_bar = available_width_for_bars * current_ui_step.relative_width_to_first_step;
+        for (size_t k = 0; k < MAX_BREAKDOWNS; ++k) {
+            current_ui_step.segments[k].width = 0;
+            current_ui_step.segments[k].offset = 0;
+            current_ui_step.segments[k].color = _breakdown_colors[k];
+        }
+        if (model.funnel_has_breakdowns[i] && step_counts_total[i] > 0) {
+            float total_width_for_this_step_bar = geometry.width * relative_width_to_first_step;
             float current_offset = 0.0f;
 
             // Create a vector of {count, original_index} to sort breakdowns
             std::vector<std::pair<uint32_t, int>> sorted_breakdowns_info;
             for (size_t k = 0; k < breakdown_count; ++k) {
-                sorted_breakdowns_info.push_back({breakdown_val_counts[k], (int)k});
+                sorted_breakdowns_info.push_back({model.funnel_breakdown_counts[i][k], (int)k});
             }
 
             // Sort descending by count (largest first)
@@ -207,85 +174,87 @@ void FunnelRenderer::updateDisplay(InsightParser& parser, const String& title_st
 
                 float segment_percentage_of_step = static_cast<float>(current_segment_count) / step_counts_total[i];
                 float segment_width_pixels = total_width_for_this_step_bar * segment_percentage_of_step;
-                
-                current_ui_step.segments[k].width_pixels = segment_width_pixels;
-                current_ui_step.segments[k].offset_pixels = current_offset;
+
+                int seg_width = static_cast<int>(segment_width_pixels);
+                // Ensure visible segments have at least 1px width if they have any data
+                if (seg_width == 0 && segment_width_pixels > 0) seg_width = 1;
+
+                current_ui_step.segments[k].width = seg_width;
+                current_ui_step.segments[k].offset = static_cast<lv_coord_t>(current_offset);
                 current_ui_step.segments[k].color = _breakdown_colors[original_segment_index]; // Assign color based on original index
                 current_offset += segment_width_pixels;
             }
         }
     }
 
-    // Dispatch UI update
-    dispatchToUI([this, captured_steps_data = std::move(ui_steps_data), step_count, breakdown_count, available_width_for_bars]() {
-        if (!areElementsValid()) {
-            Serial.println("[FunnelRenderer-WARN] Funnel elements invalid in updateDisplay lambda.");
-            return;
-        }
+    return std::move(view_model);
+}
 
-        int y_offset = 0;
-        for (size_t i = 0; i < step_count; ++i) {
-            const auto& step_data = captured_steps_data[i];
-
-            if (isValidLVGLObject(_funnel_step_bars[i])) {
-                lv_obj_clear_flag(_funnel_step_bars[i], LV_OBJ_FLAG_HIDDEN);
-                lv_obj_align(_funnel_step_bars[i], LV_ALIGN_TOP_LEFT, 0, y_offset);
-                // Ensure the bar container is set to the full available width before placing segments
-                lv_obj_set_width(_funnel_step_bars[i], available_width_for_bars); 
-
-                for (size_t j = 0; j < breakdown_count; ++j) {
-                    if (isValidLVGLObject(_funnel_bar_segments[i][j])) {
-                        int seg_width = static_cast<int>(step_data.segments[j].width_pixels);
-                        // Ensure visible segments have at least 1px width if they have any data
-                        if (seg_width == 0 && step_data.segments[j].width_pixels > 0) seg_width = 1;
-
-                        if (seg_width > 0) {
-                            lv_obj_set_size(_funnel_bar_segments[i][j], seg_width, FUNNEL_BAR_HEIGHT);
-                            lv_obj_align(_funnel_bar_segments[i][j], LV_ALIGN_LEFT_MID, static_cast<int>(step_data.segments[j].offset_pixels), 0);
-                            lv_obj_set_style_bg_color(_funnel_bar_segments[i][j], step_data.segments[j].color, 0); // Use stored color
-                            lv_obj_clear_flag(_funnel_bar_segments[i][j], LV_OBJ_FLAG_HIDDEN);
-                        } else {
-                            lv_obj_add_flag(_funnel_bar_segments[i][j], LV_OBJ_FLAG_HIDDEN);
-                        }
-                    }
-                }
-                // Hide unused segments for this step
-                for (size_t j = breakdown_count; j < MAX_BREAKDOWNS; ++j) {
-                     if (isValidLVGLObject(_funnel_bar_segments[i][j])) {
+void FunnelRenderer::apply(const ViewModel& view_model) {
+    const FunnelViewModel& funnel = static_cast<const FunnelViewModel&>(view_model);
+    if (!areElementsValid()) {
+        Serial.println("[FunnelRenderer-WARN] Funnel elements invalid in apply.");
+        return;
+    }
+
+    int y_offset = 0;
+    for (size_t i = 0; i < funnel.step_count; ++i) {
+        const auto& step_data = funnel.steps[i];
+
+        if (isValidLVGLObject(_funnel_step_bars[i])) {
+            lv_obj_clear_flag(_funnel_step_bars[i], LV_OBJ_FLAG_HIDDEN);
+            lv_obj_align(_funnel_step_bars[i], LV_ALIGN_TOP_LEFT, 0, y_offset);
+            // Ensure the bar container is set to the full available width before placing segments
+            lv_obj_set_width(_funnel_step_bars[i], funnel.bar_width); 
+
+            for (size_t j = 0; j < funnel.breakdown_count; ++j) {
+                if (isValidLVGLObject(_funnel_bar_segments[i][j])) {
+                    if (step_data.segments[j].width > 0) {
+                        lv_obj_set_size(_funnel_bar_segments[i][j], step_data.segments[j].width, FUNNEL_BAR_HEIGHT);
+                        lv_obj_align(_funnel_bar_segments[i][j], LV_ALIGN_LEFT_MID, step_data.segments[j].offset, 0);
+                        lv_obj_set_style_bg_color(_funnel_bar_segments[i][j], step_data.segments[j].color, 0); // Use stored color
+                        lv_obj_clear_flag(_funnel_bar_segments[i][j], LV_OBJ_FLAG_HIDDEN);
+                    } else {
                         lv_obj_add_flag(_funnel_bar_segments[i][j], LV_OBJ_FLAG_HIDDEN);
                     }
                 }
             }
-
-            if (isValidLVGLObject(_funnel_step_labels[i])) {
-                lv_obj_set_width(_funnel_step_labels[i], available_width_for_bars); // Ensure label width is updated
-                lv_label_set_text(_funnel_step_labels[i], step_data.label_text.c_str());
-                lv_obj_clear_flag(_funnel_step_labels[i], LV_OBJ_FLAG_HIDDEN);
-                lv_obj_align(_funnel_step_labels[i], LV_ALIGN_TOP_LEFT, 1, y_offset + FUNNEL_BAR_HEIGHT + 2); // +2 for small gap
+            // Hide unused segments for this step
+            for (size_t j = funnel.breakdown_count; j < MAX_BREAKDOWNS; ++j) {
+                 if (isValidLVGLObject(_funnel_bar_segments[i][j])) {
+                    lv_obj_add_flag(_funnel_bar_segments[i][j], LV_OBJ_FLAG_HIDDEN);
+                }
             }
-            y_offset += FUNNEL_BAR_HEIGHT + FUNNEL_BAR_GAP;
         }
 
-        // Hide unused steps (bars and labels)
-        for (size_t i = step_count; i < MAX_FUNNEL_STEPS; ++i) {
-            if (isValidLVGLObject(_funnel_step_bars[i])) lv_obj_add_flag(_funnel_step_bars[i], LV_OBJ_FLAG_HIDDEN);
-            if (isValidLVGLObject(_funnel_step_labels[i])) lv_obj_add_flag(_funnel_step_labels[i], LV_OBJ_FLAG_HIDDEN);
+        if (isValidLVGLObject(_funnel_step_labels[i])) {
+            lv_obj_set_width(_funnel_step_labels[i], funnel.bar_width); // Ensure label width is updated
+            lv_label_set_text(_funnel_step_labels[i], step_data.label_text.c_str());
+            lv_obj_clear_flag(_funnel_step_labels[i], LV_OBJ_FLAG_HIDDEN);
+            lv_obj_align(_funnel_step_labels[i], LV_ALIGN_TOP_LEFT, 1, y_offset + FUNNEL_BAR_HEIGHT + 2); // +2 for small gap
         }
-        
-        // Optional: force refresh
-        // lv_obj_invalidate(_funnel_main_container); // Invalidate the specific container
-        // lv_display_t* disp = lv_display_get_default();
-        // if (disp) { lv_refr_now(disp); }
+        y_offset += FUNNEL_BAR_HEIGHT + FUNNEL_BAR_GAP;
+    }
 
-    }, true); // Send to front for responsiveness
+    // Hide unused steps (bars and labels)
+    for (size_t i = funnel.step_count; i < MAX_FUNNEL_STEPS; ++i) {
+        if (isValidLVGLObject(_funnel_step_bars[i])) lv_obj_add_flag(_funnel_step_bars[i], LV_OBJ_FLAG_HIDDEN);
+        if (isValidLVGLObject(_funnel_step_labels[i])) lv_obj_add_flag(_funnel_step_labels[i], LV_OBJ_FLAG_HIDDEN);
+    }
 }
 
 void FunnelRenderer::clearElements() {
     // Expected to be called from LVGL UI thread.
     // Serial.println("[FunnelRenderer] Clearing elements.");
-    if (isValidLVGLObject(_funnel_main_container)) {
-        lv_obj_del(_funnel_main_container); // Deletes main container and all its children
+    // Children go back to the pool before the containers holding them
+    for (int i = 0; i < MAX_FUNNEL_STEPS; ++i) {
+        for (int j = 0; j < MAX_BREAKDOWNS; ++j) {
+            releaseWidget(_funnel_bar_segments[i][j]);
+        }
+        releaseWidget(_funnel_step_bars[i]);
+        releaseWidget(_funnel_step_labels[i]);
     }
+    releaseWidget(_funnel_main_container);
     // All pointers to children are now invalid and should be nullified.
     resetElementPointers();
 }
@@ -8,23 +8,39 @@
 
 class FunnelRenderer : public InsightRendererBase {
 public:
-    FunnelRenderer();
+    explicit FunnelRenderer(std::shared_ptr<WidgetPool> widget_pool = nullptr);
     ~FunnelRenderer() override;
 
     void createElements(lv_obj_t* parent_container) override;
-    void updateDisplay(InsightParser& parser, const String& title, const char* prefix = nullptr, const char* suffix = nullptr) override;
+    std::unique_ptr<ViewModel> prepare(const InsightModel& model, const Geometry& geometry) override;
+    void apply(const ViewModel& view_model) override;
     void clearElements() override;
     bool areElementsValid() const override;
 
 private:
     // Constants for funnel layout (previously in InsightCard)
-    static constexpr int MAX_FUNNEL_STEPS = 5;     
-    static constexpr int MAX_BREAKDOWNS = 5;       
+    static constexpr int MAX_FUNNEL_STEPS = InsightModel::MAX_FUNNEL_STEPS;
+    static constexpr int MAX_BREAKDOWNS = InsightModel::MAX_BREAKDOWNS;
     static constexpr int FUNNEL_BAR_HEIGHT = 5;    
     static constexpr int FUNNEL_BAR_GAP = 24;      
     // static constexpr int FUNNEL_LEFT_MARGIN = 0; // Might not be needed if aligning within container
     static constexpr int FUNNEL_LABEL_HEIGHT = 20; // Restored to original value, as 15 might be too small for Style::valueFont()
 
+    // Everything apply() needs, resolved to pixels by prepare()
+    struct FunnelViewModel : ViewModel {
+        struct Step {
+            String label_text;
+            struct Segment {
+                lv_coord_t width;
+                lv_coord_t offset;
+                lv_color_t color;
+            } segments[MAX_BREAKDOWNS];
+        } steps[MAX_FUNNEL_STEPS];
+        size_t step_count = 0;
+        size_t breakdown_count = 0;
+        lv_coord_t bar_width = 0;
+    };
+
     lv_obj_t* _funnel_main_container; // A container created by this renderer within parent_container
     
     // Arrays for LVGL objects
@@ -2,9 +2,11 @@
 #define INSIGHT_RENDERER_BASE_H
 
 #include "lvgl.h"
-#include "../../posthog/parsers/InsightParser.h" // Adjusted path
+#include "../../posthog/InsightModel.h" // Adjusted path
+#include "WidgetPool.h"
 #include <Arduino.h> // For String, if used in titles or other data
-#include <functional> // For std::function
+#include <atomic>
+#include <memory>
 
 #include "../UICallback.h" // For global dispatch function
 
@@ -15,24 +17,46 @@
  * Defines the interface for creating, updating, and clearing UI elements 
  * for a specific insight visualization.
  *
+ * Updates are split in two steps:
+ * - `prepare()` runs on the event task. It turns an InsightModel into a
+ *   renderer-specific view-model (pixel sizes, formatted labels, colors)
+ *   and must not call LVGL.
+ * - `apply()` runs on the LVGL task and only pushes that view-model into
+ *   the existing widgets.
+ * `update()` chains the two, so the LVGL task never does data work.
+ *
+ * Widgets come from the card's WidgetPool through acquireWidget() and go
+ * back through releaseWidget(), so switching renderers reuses LVGL objects.
+ *
  * **Important LVGL Rendering Lifecycle Note:**
- * When implementing a new renderer, be aware of LVGL's rendering and layout lifecycle.
  * LVGL may not immediately calculate the final dimensions and positions of newly created 
  * objects (especially when using flexbox or percentage-based sizing in parent containers)
- * within the same execution cycle as their creation.
- *
- * If a renderer's `updateDisplay` method relies on the final, calculated dimensions of 
- * elements just created in its `createElements` method (e.g., to size or position 
- * children accurately), it's crucial to ensure LVGL has processed these layouts.
- * In the `InsightCard` (which manages these renderers), a forced refresh 
- * (e.g., `lv_obj_invalidate()` on the container followed by `lv_refr_now()`) 
- * is performed *between* calling `createElements()` and `updateDisplay()`.
- * This allows `updateDisplay()` to work with more reliable, up-to-date element dimensions.
- * Failure to account for this can lead to elements appearing incorrectly sized, 
- * misplaced, or not appearing until a later, unrelated refresh cycle.
+ * within the same execution cycle as their creation. Size elements from the Geometry
+ * passed to `prepare()` rather than reading object sizes back from LVGL.
  */
 class InsightRendererBase {
 public:
+    /**
+     * @brief Size of the content area the renderer draws into, in pixels
+     */
+    struct Geometry {
+        lv_coord_t width = 0;
+        lv_coord_t height = 0;
+    };
+
+    /**
+     * @brief Base for the plain data each renderer hands from prepare() to apply()
+     */
+    struct ViewModel {
+        virtual ~ViewModel() = default;
+    };
+
+    /**
+     * @param widget_pool Pool of the owning card, or nullptr to create widgets directly
+     */
+    explicit InsightRendererBase(std::shared_ptr<WidgetPool> widget_pool = nullptr)
+        : _widget_pool(std::move(widget_pool)) {}
+
     virtual ~InsightRendererBase() = default;
 
     /**
@@ -40,21 +64,26 @@ public:
      * This method will be called on the LVGL UI thread.
      * 
      * @param parent_container The LVGL object within which to create the elements.
-     * @param initial_title The initial title to set for the insight.
      */
     virtual void createElements(lv_obj_t* parent_container) = 0;
 
     /**
-     * @brief Updates the display with new data from the parser.
-     * This method will be called when new data for the insight is received.
-     * The renderer is responsible for dispatching its internal LVGL calls to the UI thread.
+     * @brief Builds the view-model for new data. Runs on the event task; no LVGL calls.
+     * 
+     * @param model Extracted insight data
+     * @param geometry Current size of the content area
+     * @return View-model for apply(), or nullptr if nothing on screen needs to change
+     */
+    virtual std::unique_ptr<ViewModel> prepare(const InsightModel& model, const Geometry& geometry) = 0;
+
+    /**
+     * @brief Pushes a prepared view-model into the widgets.
+     * Called on the LVGL UI thread for every non-null result of prepare(), in order.
+     * Must cope with elements that have since been cleared.
      * 
-     * @param parser The InsightParser instance containing the new data.
-     * @param title The title of the insight.
-     * @param prefix The prefix to prepend to the title.
-     * @param suffix The suffix to append to the title.
+     * @param view_model The object returned by this renderer's prepare()
      */
-    virtual void updateDisplay(InsightParser& parser, const String& title, const char* prefix = nullptr, const char* suffix = nullptr) = 0;
+    virtual void apply(const ViewModel& view_model) = 0;
 
     /**
      * @brief Clears/deletes all UI elements created by this renderer.
@@ -63,6 +92,16 @@ public:
      */
     virtual void clearElements() = 0;
 
+    /**
+     * @brief Clears the elements and skips any apply() still queued for them.
+     * Call on the LVGL UI thread before cleaning the parent the elements live in,
+     * so the widgets go back through the pool rather than being deleted behind it.
+     */
+    void releaseElements() {
+        _release_generation.fetch_add(1, std::memory_order_relaxed);
+        clearElements();
+    }
+
     /**
      * @brief Checks if the core UI elements managed by this renderer are valid.
      * Useful for pre-update validation.
@@ -70,11 +109,36 @@ public:
      */
     virtual bool areElementsValid() const = 0;
 
+    /**
+     * @brief Prepares on the calling task and queues apply() on the UI thread.
+     * Dispatch is FIFO so it lands after any pending createElements().
+     * 
+     * @param owner Card the update is for. When set, the apply is latest-wins:
+     *              an older apply for the same card still in the queue is skipped.
+     */
+    void update(const InsightModel& model, const Geometry& geometry, const void* owner = nullptr) {
+        std::shared_ptr<ViewModel> view_model(prepare(model, geometry));
+        if (!view_model) return;
+        uint32_t generation = _release_generation.load(std::memory_order_relaxed);
+        dispatchToUI([this, view_model, generation]() {
+            // Prepared for elements that have since been released
+            if (_release_generation.load(std::memory_order_relaxed) != generation) return;
+            apply(*view_model);
+        }, false, owner);
+    }
+
 protected:
-    // Helper to dispatch UI updates to the LVGL task using global dispatch function
-    static void dispatchToUI(std::function<void()> func, bool to_front = false) {
+    // Helper to dispatch UI updates to the LVGL task using global dispatch function.
+    // With an owner the update is keyed, so only the newest one per owner and kind runs.
+    template <typename F>
+    static void dispatchToUI(F&& func, bool to_front = false, const void* owner = nullptr,
+                             UIUpdateKind kind = UIUpdateKind::RENDER) {
         if (globalUIDispatch) {
-            globalUIDispatch(std::move(func), to_front);
+            if (owner) {
+                globalUIDispatch(std::forward<F>(func), to_front, owner, kind);
+            } else {
+                globalUIDispatch(std::forward<F>(func), to_front);
+            }
         } else {
             Serial.println("[UI-ERROR] Global UI dispatch not set, cannot dispatch UI update.");
         }
@@ -84,6 +148,25 @@ protected:
     static bool isValidLVGLObject(lv_obj_t* obj) {
         return obj && lv_obj_is_valid(obj);
     }
+
+    // Borrow a widget from the card's pool. UI thread only.
+    lv_obj_t* acquireWidget(WidgetPool::Kind kind, lv_obj_t* parent) {
+        return _widget_pool ? _widget_pool->acquire(kind, parent) : WidgetPool::create(kind, parent);
+    }
+
+    // Hand a widget back to the pool, children first. UI thread only.
+    void releaseWidget(lv_obj_t* obj) {
+        if (!isValidLVGLObject(obj)) return;
+        if (_widget_pool) {
+            _widget_pool->release(obj);
+        } else {
+            lv_obj_del(obj);
+        }
+    }
+
+private:
+    std::shared_ptr<WidgetPool> _widget_pool;
+    std::atomic<uint32_t> _release_generation{0}; ///< Bumped by releaseElements(), checked by queued applies
 };
 
-#endif // INSIGHT_RENDERER_BASE_H 
\ No newline at end of file
+#endif // INSIGHT_RENDERER_BASE_H 
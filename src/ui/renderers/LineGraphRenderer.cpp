@@ -1,15 +1,192 @@
 #include "LineGraphRenderer.h"
+#include "SeriesDecimator.h"
 #include <memory> // For std::unique_ptr for data arrays
 #include <algorithm> // For std::min
+#include <vector>
 
-LineGraphRenderer::LineGraphRenderer()
-    : _chart(nullptr), _series(nullptr) {
+// Series colors, matching the funnel breakdown palette
+static const uint32_t SERIES_COLORS[] = {
+    0x2980b9, // Blue
+    0x8e44ad, // Purple
+    0xd35400, // Orange
+    0xc0392b, // Red
+    0x27ae60  // Green
+};
+
+LineGraphRenderer::LineGraphRenderer(std::shared_ptr<WidgetPool> widget_pool)
+    : InsightRendererBase(std::move(widget_pool)), _chart(nullptr), _front_buffer(0), _buffer_mutex(nullptr),
+      _start_point(0), _front_point_count(0), _front_visible_mask(0), _front_range_max(0),
+      _prepared_sequence(0), _applied_sequence(0) {
+    for (size_t i = 0; i < MAX_SERIES; ++i) {
+        _series[i] = nullptr;
+    }
+    // Allocated once for the renderer's lifetime; large enough to go to PSRAM
+    for (int b = 0; b < 2; ++b) {
+        _y_buffers[b].reset(new int32_t[MAX_SERIES * MAX_POINTS]);
+        std::fill_n(_y_buffers[b].get(), MAX_SERIES * MAX_POINTS, (int32_t)LV_CHART_POINT_NONE);
+    }
+    _buffer_mutex = xSemaphoreCreateMutex();
     // Serial.println("[LineGraphRenderer] Constructor");
 }
 
 LineGraphRenderer::~LineGraphRenderer() {
     // Serial.println("[LineGraphRenderer] Destructor");
-    // Relies on InsightCard calling clearElements before destruction.
+    // Relies on InsightCard calling clearElements before destruction,
+    // so the chart no longer references the Y buffers freed here.
+    if (_buffer_mutex) {
+        vSemaphoreDelete(_buffer_mutex);
+    }
+}
+
+void LineGraphRenderer::bindBuffer(uint8_t buffer_index) {
+    int32_t* buffer = _y_buffers[buffer_index].get();
+    for (size_t i = 0; i < MAX_SERIES; ++i) {
+        lv_chart_set_ext_y_array(_chart, _series[i], buffer + i * MAX_POINTS);
+        lv_chart_set_x_start_point(_chart, _series[i], 0); // Back buffers are filled in logical order
+    }
+    _front_buffer = buffer_index;
+    _start_point = 0;
+}
+
+LineGraphRenderer::UpdateKind LineGraphRenderer::diffAgainstFront(const int32_t* back, size_t point_count,
+                                                                  uint8_t visible_mask, ChartPatch& patch) const {
+    const int32_t* front = _y_buffers[_front_buffer].get();
+    auto frontValue = [&](size_t s, size_t i) {
+        return front[s * MAX_POINTS + (_start_point + i) % point_count];
+    };
+
+    // First logical point that differs in any visible series
+    size_t first_changed = point_count;
+    for (size_t s = 0; s < MAX_SERIES; ++s) {
+        if (!(visible_mask & (1 << s))) continue;
+        for (size_t i = 0; i < first_changed; ++i) {
+            if (back[s * MAX_POINTS + i] != frontValue(s, i)) {
+                first_changed = i;
+                break;
+            }
+        }
+    }
+
+    if (first_changed == point_count) {
+        return UpdateKind::UNCHANGED;
+    }
+
+    UpdateKind kind;
+    size_t first;
+    if (point_count - first_changed <= MAX_PATCH_POINTS) {
+        kind = UpdateKind::TAIL;
+        first = first_changed;
+    } else {
+        // Window slid by one bucket: new[i] == old[i + 1] apart from the newest points
+        size_t slide_changed = point_count - 1;
+        for (size_t s = 0; s < MAX_SERIES; ++s) {
+            if (!(visible_mask & (1 << s))) continue;
+            for (size_t i = 0; i < slide_changed; ++i) {
+                if (back[s * MAX_POINTS + i] != frontValue(s, i + 1)) {
+                    slide_changed = i;
+                    break;
+                }
+            }
+        }
+        if (point_count - slide_changed > MAX_PATCH_POINTS) {
+            return UpdateKind::FULL;
+        }
+        kind = UpdateKind::SLIDE;
+        first = slide_changed;
+    }
+
+    patch.point_count = point_count;
+    patch.first = first;
+    patch.count = point_count - first;
+    for (size_t s = 0; s < MAX_SERIES; ++s) {
+        if (!(visible_mask & (1 << s))) continue;
+        std::copy_n(back + s * MAX_POINTS + first, patch.count, patch.values[s]);
+    }
+    return kind;
+}
+
+bool LineGraphRenderer::applyPatch(const ChartPatch& patch, UpdateKind kind) {
+    if (xSemaphoreTake(_buffer_mutex, portMAX_DELAY) != pdTRUE) return false;
+
+    // createElements() empties the chart, e.g. when the card's widgets are rebuilt
+    // while this patch was queued; there is nothing left to patch
+    const size_t point_count = _front_point_count;
+    if (point_count == 0 || point_count != patch.point_count) {
+        xSemaphoreGive(_buffer_mutex);
+        return false;
+    }
+
+    if (kind == UpdateKind::SLIDE) {
+        // Oldest point becomes the newest slot; nothing else in the buffer moves
+        _start_point = (_start_point + 1) % point_count;
+        for (size_t s = 0; s < MAX_SERIES; ++s) {
+            lv_chart_set_x_start_point(_chart, _series[s], _start_point);
+        }
+    }
+
+    int32_t* front = _y_buffers[_front_buffer].get();
+    for (size_t s = 0; s < MAX_SERIES; ++s) {
+        if (!(_front_visible_mask & (1 << s))) continue;
+        for (size_t k = 0; k < patch.count; ++k) {
+            front[s * MAX_POINTS + (_start_point + patch.first + k) % point_count] = patch.values[s][k];
+        }
+    }
+
+    xSemaphoreGive(_buffer_mutex);
+
+    if (kind == UpdateKind::SLIDE) {
+        lv_obj_invalidate(_chart); // Every point moved one bucket left
+    } else {
+        invalidatePoints(patch.first, point_count - 1);
+    }
+    return true;
+}
+
+void LineGraphRenderer::applyFull(const LineGraphViewModel& update, bool only_if_latest) {
+    // Only a pointer swap: the values were written on the event task
+    if (xSemaphoreTake(_buffer_mutex, portMAX_DELAY) != pdTRUE) return;
+    if (only_if_latest && update.sequence != _prepared_sequence) {
+        xSemaphoreGive(_buffer_mutex);
+        return; // The back buffer holds newer data now, and its own update is queued
+    }
+    bindBuffer(update.back_buffer);
+    _front_point_count = update.point_count;
+    _front_visible_mask = update.visible_mask;
+    _front_range_max = update.range_max;
+    xSemaphoreGive(_buffer_mutex);
+
+    lv_chart_set_point_count(_chart, update.point_count);
+    for (size_t s = 0; s < MAX_SERIES; ++s) {
+        lv_chart_hide_series(_chart, _series[s], !(update.visible_mask & (1 << s)));
+    }
+    lv_chart_set_range(_chart, LV_CHART_AXIS_PRIMARY_Y, 0, update.range_max);
+    lv_chart_refresh(_chart);
+}
+
+void LineGraphRenderer::invalidatePoints(size_t first, size_t last) {
+    uint32_t point_count = lv_chart_get_point_count(_chart);
+    if (point_count < 2) {
+        lv_obj_invalidate(_chart);
+        return;
+    }
+
+    lv_area_t content;
+    lv_obj_get_content_coords(_chart, &content);
+    int32_t w = lv_area_get_width(&content);
+    int32_t margin = lv_obj_get_style_line_width(_chart, LV_PART_ITEMS) +
+                     lv_obj_get_style_width(_chart, LV_PART_INDICATOR);
+
+    // A point's value shapes the segments to both of its neighbours
+    size_t from = first > 0 ? first - 1 : 0;
+    size_t to = std::min<size_t>(last + 1, point_count - 1);
+
+    lv_area_t area;
+    lv_obj_get_coords(_chart, &area);
+    area.x1 = content.x1 + (int32_t)((w * from) / (point_count - 1)) - margin;
+    area.x2 = content.x1 + (int32_t)((w * to) / (point_count - 1)) + margin;
+    area.y1 -= margin;
+    area.y2 += margin;
+    lv_obj_invalidate_area(_chart, &area);
 }
 
 void LineGraphRenderer::createElements(lv_obj_t* parent_container) {
@@ -18,17 +195,15 @@ void LineGraphRenderer::createElements(lv_obj_t* parent_container) {
         return;
     }
 
-    // Use parent_container dimensions for the chart
-    lv_coord_t container_width = lv_obj_get_content_width(parent_container); // Use content width to respect padding
-    lv_coord_t container_height = lv_obj_get_content_height(parent_container);
-
-    _chart = lv_chart_create(parent_container);
+    _chart = acquireWidget(WidgetPool::Kind::CHART, parent_container);
     if (!_chart) {
         Serial.println("[LineGraphRenderer-ERROR] Failed to create chart object.");
         return;
     }
 
-    lv_obj_set_size(_chart, container_width, container_height);
+    // Fill the parent's content area; sized relatively so it doesn't depend on
+    // the parent having been laid out yet
+    lv_obj_set_size(_chart, lv_pct(100), lv_pct(100));
     lv_obj_align(_chart, LV_ALIGN_CENTER, 0, 0); // Center in parent
     lv_chart_set_type(_chart, LV_CHART_TYPE_LINE);
     lv_obj_clear_flag(_chart, LV_OBJ_FLAG_SCROLLABLE); // Ensure no scrollbars
@@ -41,12 +216,27 @@ void LineGraphRenderer::createElements(lv_obj_t* parent_container) {
     // Remove padding from the chart itself to use full area
     lv_obj_set_style_pad_all(_chart, 0, LV_PART_MAIN);
 
-    _series = lv_chart_add_series(_chart, lv_color_hex(0x2980b9), LV_CHART_AXIS_PRIMARY_Y);
-    if (!_series) {
-        Serial.println("[LineGraphRenderer-ERROR] Failed to create chart series.");
-        lv_obj_del(_chart); // Clean up chart if series fails
-        _chart = nullptr;
-        return;
+    // Create every series up front; unused ones stay hidden until data arrives
+    for (size_t i = 0; i < MAX_SERIES; ++i) {
+        _series[i] = lv_chart_add_series(_chart, lv_color_hex(SERIES_COLORS[i]), LV_CHART_AXIS_PRIMARY_Y);
+        if (!_series[i]) {
+            Serial.println("[LineGraphRenderer-ERROR] Failed to create chart series.");
+            releaseWidget(_chart); // Clean up chart if series fails
+            _chart = nullptr;
+            for (size_t j = 0; j < MAX_SERIES; ++j) {
+                _series[j] = nullptr;
+            }
+            return;
+        }
+        lv_chart_hide_series(_chart, _series[i], i > 0);
+    }
+
+    // Bind the external buffers before the point count ever grows, so LVGL frees
+    // its own small default arrays instead of reallocating them from its pool
+    if (_buffer_mutex && xSemaphoreTake(_buffer_mutex, portMAX_DELAY) == pdTRUE) {
+        bindBuffer(_front_buffer);
+        _front_point_count = 0; // Fresh chart, the next update is always a full one
+        xSemaphoreGive(_buffer_mutex);
     }
 
     lv_obj_set_style_size(_chart, 0, 0, LV_PART_INDICATOR); // No indicators (dots on points)
@@ -57,99 +247,160 @@ void LineGraphRenderer::createElements(lv_obj_t* parent_container) {
     // InsightCard will do a global refresh after calling createElements if needed.
 }
 
-void LineGraphRenderer::updateDisplay(InsightParser& parser, const String& title, const char* prefix, const char* suffix) {
-    // Title is handled by InsightCard. This renderer updates the chart data.
-    // prefix and suffix are ignored for LineGraphRenderer.
-    size_t point_count = parser.getSeriesPointCount();
-    if (point_count == 0) {
+std::unique_ptr<InsightRendererBase::ViewModel> LineGraphRenderer::prepare(const InsightModel& model, const Geometry& geometry) {
+    // Runs on the event task: decimation and scaling happen here, apply() only
+    // swaps the bound buffer or patches a few points.
+    std::unique_ptr<LineGraphViewModel> view_model(new LineGraphViewModel());
+    size_t series_count = model.series_count;
+    if (series_count == 0) {
         // No data points, maybe clear the chart or show a message?
         // For now, clear existing points if any.
-        dispatchToUI([this]() {
-            if (isValidLVGLObject(_chart) && _series) {
-                lv_chart_set_point_count(_chart, 0);
-                lv_chart_refresh(_chart);
-            }
-        });
-        return;
+        view_model->kind = UpdateKind::CLEAR;
+        view_model->sequence = ++_prepared_sequence;
+        return std::move(view_model);
     }
 
-    // Allocate memory for Y values from the parser
-    // Using unique_ptr for automatic memory management.
-    std::unique_ptr<double[]> y_values_from_parser(new double[point_count]);
-    if (!parser.getSeriesYValues(y_values_from_parser.get())) {
-        Serial.println("[LineGraphRenderer-ERROR] Failed to get Y series values from parser.");
-        return;
-    }
+    // More points than pixel columns can't be seen, so decimate to the chart width
+    const size_t chart_width = geometry.width > 3 ? geometry.width : 3;
+    const size_t target_points = std::min(chart_width, static_cast<size_t>(MAX_POINTS));
+
+    // Scale from the raw data so decimation never hides the true maximum
+    double max_val = model.series_max;
 
-    // Find max value for scaling (logic from original InsightCard)
-    double max_val = 0.0;
-    if (point_count > 0) {
-        max_val = y_values_from_parser[0];
-        for (size_t i = 1; i < point_count; ++i) {
-            if (y_values_from_parser[i] > max_val) max_val = y_values_from_parser[i];
-        }
-    }
     // Ensure max_val is not zero to avoid division by zero; if all values are <=0, chart range needs care.
     if (max_val <= 0) max_val = 1.0; // Default to 1 if all data is zero or negative to prevent scaling issues.
 
     double scale_factor = (max_val > 1000.0) ? (1000.0 / max_val) : 1.0;
 
-    // Copy data for the UI thread: Capture y_values_from_parser by moving its contents to a shared_ptr.
-    // This is because the lambda might outlive the current scope.
-    // The parser itself is passed by reference but assumed to be valid during the lambda's queuing/execution
-    // due to the shared_ptr in InsightCard::handleParsedData.
-    
-    // To pass the array safely to the lambda, we copy it into a structure that can be captured.
-    // A std::vector is easier to capture by value for lambdas.
-    std::vector<double> values_for_lambda(point_count);
-    for(size_t i = 0; i < point_count; ++i) {
-        values_for_lambda[i] = y_values_from_parser[i];
-    }
-
-    dispatchToUI([this, captured_values = std::move(values_for_lambda), point_count, max_val, scale_factor]() {
-        if (!areElementsValid()) {
-            Serial.println("[LineGraphRenderer-WARN] Chart/Series invalid in updateDisplay lambda.");
-            return;
-        }
+    if (!_buffer_mutex || xSemaphoreTake(_buffer_mutex, portMAX_DELAY) != pdTRUE) {
+        Serial.println("[LineGraphRenderer-ERROR] Failed to lock series buffers.");
+        return nullptr;
+    }
 
-        // Limit display points for performance/readability if desired, though original fix was to show all.
-        // const size_t display_points = std::min(point_count, static_cast<size_t>(50)); // Example: Max 50 points
-        const size_t display_points = point_count; // Show all points as per previous fixes
+    // Fill the buffer the chart isn't drawing from with final, pre-scaled values
+    const uint8_t back_buffer = _front_buffer ^ 1;
+    int32_t* buffer = _y_buffers[back_buffer].get();
+    size_t lengths[MAX_SERIES] = {0};
+    size_t point_count = 0;
 
-        lv_chart_set_point_count(_chart, display_points);
-        // lv_chart_set_all_value(_chart, _series, 0); // Zero out before setting new values
+    for (size_t s = 0; s < series_count; ++s) {
+        size_t raw_count = model.series_lengths[s];
+        if (raw_count == 0) continue;
 
-        for (size_t i = 0; i < display_points; ++i) {
-            int16_t y_val = static_cast<int16_t>(captured_values[i] * scale_factor);
+        const double* values = model.seriesData(s);
+        size_t count = raw_count;
+        if (raw_count > target_points) {
+            _decimated_values.resize(target_points);
+            count = SeriesDecimator::lttb(values, raw_count, _decimated_values.data(), target_points);
+            values = _decimated_values.data();
+        }
+
+        int32_t* row = buffer + s * MAX_POINTS;
+        for (size_t i = 0; i < count; ++i) {
             // LVGL chart y-values are typically positive. If your data can be negative,
-            // you might need to adjust the range and how y_val is calculated.
-            lv_chart_set_value_by_id(_chart, _series, i, y_val);
+            // you might need to adjust the range and how the value is calculated.
+            row[i] = static_cast<int32_t>(values[i] * scale_factor);
         }
+        lengths[s] = count;
+        point_count = std::max(point_count, count);
+    }
 
-        // Set chart range dynamically
-        // LVGL charts typically handle positive values. If your data min is negative or very different,
-        // the Y-axis range (lv_chart_set_range) needs to be set carefully.
-        // For simplicity, assuming positive values and scaling towards a max of ~1000 * 1.1 on chart.
-        lv_chart_set_range(_chart, LV_CHART_AXIS_PRIMARY_Y, 0, static_cast<int32_t>(max_val * scale_factor * 1.1));
-        
-        lv_chart_refresh(_chart);
-
-        // Optional: Force a global display refresh if needed, though InsightCard might handle it.
-        // lv_display_t* disp = lv_display_get_default();
-        // if (disp) { lv_refr_now(disp); }
-    }, true); // Send to front to prioritize data update rendering
+    // Shorter series end in a gap instead of repeating stale points
+    for (size_t s = 0; s < series_count; ++s) {
+        std::fill(buffer + s * MAX_POINTS + lengths[s], buffer + s * MAX_POINTS + point_count,
+                  (int32_t)LV_CHART_POINT_NONE);
+    }
+
+    uint8_t visible_mask = 0;
+    for (size_t s = 0; s < series_count; ++s) {
+        if (lengths[s] > 0) visible_mask |= (1 << s);
+    }
+
+    // Set chart range dynamically
+    // LVGL charts typically handle positive values. If your data min is negative or very different,
+    // the Y-axis range (lv_chart_set_range) needs to be set carefully.
+    // For simplicity, assuming positive values and scaling towards a max of ~1000 * 1.1 on chart.
+    int32_t range_max = static_cast<int32_t>(max_val * scale_factor * 1.1);
+
+    // A refresh of a daily/hourly trend usually only touches the newest bucket,
+    // so try to update the chart in place before falling back to a full swap
+    UpdateKind kind = UpdateKind::FULL;
+    if (point_count > 0 && _applied_sequence == _prepared_sequence && point_count == _front_point_count &&
+        visible_mask == _front_visible_mask && range_max == _front_range_max) {
+        kind = diffAgainstFront(buffer, point_count, visible_mask, view_model->patch);
+    }
+
+    // Numbered before the back buffer is released, so apply() can tell whether
+    // the buffer still holds this view-model's series
+    if (point_count > 0 && kind != UpdateKind::UNCHANGED) {
+        view_model->sequence = ++_prepared_sequence;
+    }
+
+    xSemaphoreGive(_buffer_mutex);
+
+    if (point_count == 0) {
+        Serial.println("[LineGraphRenderer-ERROR] Failed to get Y series values from model.");
+        return nullptr;
+    }
+
+    if (kind == UpdateKind::UNCHANGED) {
+        return nullptr;
+    }
+
+    view_model->kind = kind;
+    view_model->back_buffer = back_buffer;
+    view_model->point_count = point_count;
+    view_model->visible_mask = visible_mask;
+    view_model->range_max = range_max;
+    return std::move(view_model);
+}
+
+void LineGraphRenderer::apply(const ViewModel& view_model) {
+    const LineGraphViewModel& update = static_cast<const LineGraphViewModel&>(view_model);
+
+    if (!areElementsValid()) {
+        Serial.println("[LineGraphRenderer-WARN] Chart/Series invalid in apply.");
+        _applied_sequence = update.sequence;
+        return;
+    }
+
+    switch (update.kind) {
+        case UpdateKind::CLEAR:
+            lv_chart_set_point_count(_chart, 0);
+            lv_chart_refresh(_chart);
+            if (xSemaphoreTake(_buffer_mutex, portMAX_DELAY) == pdTRUE) {
+                _front_point_count = 0;
+                xSemaphoreGive(_buffer_mutex);
+            }
+            break;
+
+        case UpdateKind::TAIL:
+        case UpdateKind::SLIDE:
+            if (!applyPatch(update.patch, update.kind)) {
+                // The chart was rebuilt after prepare() diffed against it. The
+                // back buffer holds the whole series, so draw that instead
+                applyFull(update, true);
+            }
+            break;
+
+        default:
+            applyFull(update, false);
+            break;
+    }
+
+    _applied_sequence = update.sequence;
 }
 
 void LineGraphRenderer::clearElements() {
     // Expected to be called from LVGL UI thread.
-    if (isValidLVGLObject(_chart)) {
-        lv_obj_del(_chart); // This also deletes series associated with the chart
-    }
+    releaseWidget(_chart); // The pool removes the series bound to our Y buffers
     _chart = nullptr;
-    _series = nullptr; // Series is owned by chart, but good to nullify pointer.
+    for (size_t i = 0; i < MAX_SERIES; ++i) {
+        _series[i] = nullptr; // Series are owned by chart, but good to nullify pointers.
+    }
 }
 
 bool LineGraphRenderer::areElementsValid() const {
     // Can be called from any thread.
-    return isValidLVGLObject(_chart) && _series; // Series validity is tied to chart, but check both for clarity.
-} 
\ No newline at end of file
+    return isValidLVGLObject(_chart) && _series[0]; // Series validity is tied to chart, but check both for clarity.
+}
@@ -3,21 +3,114 @@
 
 #include "InsightRendererBase.h"
 #include "../Style.h" // For styles, colors, fonts
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 // NumberFormat might not be directly needed here if data comes pre-formatted or scaling is internal
 
 class LineGraphRenderer : public InsightRendererBase {
 public:
-    LineGraphRenderer();
+    explicit LineGraphRenderer(std::shared_ptr<WidgetPool> widget_pool = nullptr);
     ~LineGraphRenderer() override;
 
     void createElements(lv_obj_t* parent_container) override;
-    void updateDisplay(InsightParser& parser, const String& title, const char* prefix = nullptr, const char* suffix = nullptr) override;
+    std::unique_ptr<ViewModel> prepare(const InsightModel& model, const Geometry& geometry) override;
+    void apply(const ViewModel& view_model) override;
     void clearElements() override;
     bool areElementsValid() const override;
 
 private:
-    lv_obj_t* _chart;           // LVGL chart object
-    lv_chart_series_t* _series; // LVGL chart series object
+    static constexpr size_t MAX_SERIES = InsightParser::MAX_SERIES;
+    static constexpr size_t MAX_POINTS = 256; ///< Decimation cap, at least the chart's pixel width
+    static constexpr size_t MAX_PATCH_POINTS = 4; ///< Most trailing points an in-place update may touch
+
+    // How a new series relates to the one currently on screen
+    enum class UpdateKind {
+        CLEAR,     ///< No data - empty the chart
+        UNCHANGED, ///< Nothing to do
+        TAIL,      ///< Only the newest points changed - rewrite them in place
+        SLIDE,     ///< Window moved by one bucket - rotate the ring start, rewrite the newest points
+        FULL       ///< Anything else - swap in the back buffer
+    };
+
+    // Values for an in-place update: logical points [first, first + count) of each visible series
+    struct ChartPatch {
+        size_t point_count; ///< Points in the front buffer it was diffed against
+        size_t first;
+        size_t count;
+        int32_t values[MAX_SERIES][MAX_PATCH_POINTS];
+    };
+
+    struct LineGraphViewModel : ViewModel {
+        UpdateKind kind = UpdateKind::FULL;
+        uint8_t back_buffer = 0;   ///< FULL: buffer filled by prepare()
+        size_t point_count = 0;
+        uint8_t visible_mask = 0;  ///< Bit per series with data
+        int32_t range_max = 0;
+        ChartPatch patch;          ///< TAIL/SLIDE: values to write in place
+        uint32_t sequence = 0;     ///< Order in which prepare() produced it
+    };
+
+    lv_obj_t* _chart;                       // LVGL chart object
+    lv_chart_series_t* _series[MAX_SERIES]; // One LVGL series per insight series, hidden when unused
+
+    // Pre-scaled Y values bound to the chart with lv_chart_set_ext_y_array, one
+    // MAX_SERIES x MAX_POINTS block per buffer. The event task fills the back
+    // buffer; the LVGL thread only rebinds it and invalidates the chart.
+    std::unique_ptr<int32_t[]> _y_buffers[2];
+    uint8_t _front_buffer;          ///< Buffer currently bound to the chart
+    SemaphoreHandle_t _buffer_mutex; ///< Guards the front buffer state below against a swap mid-fill
+
+    // What the front buffer currently shows, used as the diff baseline
+    size_t _start_point;            ///< Ring offset of logical point 0 in the front buffer
+    size_t _front_point_count;
+    uint8_t _front_visible_mask;
+    int32_t _front_range_max;
+
+    // Sequence of the newest view-model prepared and the newest applied. Diffing
+    // is only done when they match, otherwise the front buffer isn't the right
+    // baseline yet. Sequence numbers rather than a counter, because the UI queue
+    // may skip a superseded view-model without applying it.
+    std::atomic<uint32_t> _prepared_sequence;
+    std::atomic<uint32_t> _applied_sequence;
+
+    // Producer-side scratch space, only touched from prepare()
+    std::vector<double> _decimated_values;
+
+    /**
+     * @brief Bind one buffer's rows to the chart series
+     * Must be called on the LVGL thread with _buffer_mutex held.
+     */
+    void bindBuffer(uint8_t buffer_index);
+
+    /**
+     * @brief Compare a freshly filled back buffer with what the chart shows
+     * Must be called with _buffer_mutex held and no chart updates pending.
+     * @param patch Receives the changed trailing values for TAIL and SLIDE
+     */
+    UpdateKind diffAgainstFront(const int32_t* back, size_t point_count, uint8_t visible_mask, ChartPatch& patch) const;
+
+    /**
+     * @brief Write a TAIL or SLIDE patch into the front buffer and invalidate what moved
+     * Must be called on the LVGL thread.
+     * @return false, changing nothing, if the front buffer no longer holds the points it was diffed against
+     */
+    bool applyPatch(const ChartPatch& patch, UpdateKind kind);
+
+    /**
+     * @brief Bind the back buffer prepare() filled and redraw the whole chart
+     * Must be called on the LVGL thread.
+     * @param only_if_latest Skip it if a newer view-model has been prepared into the back buffer since
+     */
+    void applyFull(const LineGraphViewModel& update, bool only_if_latest);
+
+    /**
+     * @brief Invalidate only the x-range covering points [first, last]
+     * Mirrors LVGL's own per-point invalidation: the line segments either side, full height.
+     */
+    void invalidatePoints(size_t first, size_t last);
 
     // Constants for chart appearance - can be defined here or moved to Style.h if more global
     // For now, keeping them local to the renderer.
@@ -26,4 +119,4 @@ private:
     // These might be determined by parent_container size in createElements instead.
 };
 
-#endif // LINE_GRAPH_RENDERER_H 
\ No newline at end of file
+#endif // LINE_GRAPH_RENDERER_H 
@@ -1,8 +1,8 @@
 #include "NumericCardRenderer.h"
 #include "NumberFormat.h"
 
-NumericCardRenderer::NumericCardRenderer()
-    : _value_label(nullptr) {
+NumericCardRenderer::NumericCardRenderer(std::shared_ptr<WidgetPool> widget_pool)
+    : InsightRendererBase(std::move(widget_pool)), _value_label(nullptr) {
     // Serial.println("[NumericRenderer] Constructor");
 }
 
@@ -29,7 +29,7 @@ void NumericCardRenderer::createElements(lv_obj_t* parent_container) {
 
     // Serial.printf("[NumericRenderer] Creating elements in container %p. Core: %d\n", parent_container, xPortGetCoreID());
 
-    _value_label = lv_label_create(parent_container);
+    _value_label = acquireWidget(WidgetPool::Kind::LABEL, parent_container);
     if (!_value_label) {
         Serial.println("[NumericRenderer-ERROR] Failed to create value label.");
         return;
@@ -40,38 +40,32 @@ void NumericCardRenderer::createElements(lv_obj_t* parent_container) {
     lv_label_set_text(_value_label, "..."); // Initial placeholder text
 }
 
-void NumericCardRenderer::updateDisplay(InsightParser& parser, const String& title, const char* prefix, const char* suffix) {
-    // Title is handled by InsightCard, we only update the value label here.
-    double value = parser.getNumericCardValue();
+std::unique_ptr<InsightRendererBase::ViewModel> NumericCardRenderer::prepare(const InsightModel& model, const Geometry& geometry) {
+    // Title is handled by InsightCard, we only format the value label text here.
+    char numeric_buffer[32];
+    formatNumericValue(model.numeric_value, numeric_buffer, sizeof(numeric_buffer));
 
-    // Data processing (getting value) is done here.
-    // LVGL operations are dispatched to the UI thread.
-    dispatchToUI([this, value, p = String(prefix ? prefix : ""), s = String(suffix ? suffix : "")]() {
-        // Serial.printf("[NumericRenderer] Updating display on UI thread. Label: %p, Core: %d\n", _value_label, xPortGetCoreID());
-        if (isValidLVGLObject(_value_label)) {
-            char numeric_buffer[32];
-            formatNumericValue(value, numeric_buffer, sizeof(numeric_buffer));
-
-            String final_value_str = p;
-            final_value_str += numeric_buffer;
-            final_value_str += s;
+    std::unique_ptr<NumericViewModel> view_model(new NumericViewModel());
+    view_model->text = model.prefix;
+    view_model->text += numeric_buffer;
+    view_model->text += model.suffix;
+    return std::move(view_model);
+}
 
-            lv_label_set_text(_value_label, final_value_str.c_str());
-        } else {
-            Serial.println("[NumericRenderer-WARN] _value_label invalid in updateDisplay lambda.");
-        }
-        // Optional: force refresh if this specific update needs it immediately.
-        // lv_display_t* disp = lv_display_get_default();
-        // if (disp) { lv_refr_now(disp); }
-    });
+void NumericCardRenderer::apply(const ViewModel& view_model) {
+    // Serial.printf("[NumericRenderer] Updating display on UI thread. Label: %p, Core: %d\n", _value_label, xPortGetCoreID());
+    const NumericViewModel& numeric = static_cast<const NumericViewModel&>(view_model);
+    if (isValidLVGLObject(_value_label)) {
+        lv_label_set_text(_value_label, numeric.text.c_str());
+    } else {
+        Serial.println("[NumericRenderer-WARN] _value_label invalid in apply.");
+    }
 }
 
 void NumericCardRenderer::clearElements() {
     // This method is expected to be called from the LVGL UI thread.
     // Serial.printf("[NumericRenderer] Clearing elements. Label: %p. Core: %d\n", _value_label, xPortGetCoreID());
-    if (isValidLVGLObject(_value_label)) {
-        lv_obj_del(_value_label); // lv_obj_del is safe if obj is already deleted or null
-    }
+    releaseWidget(_value_label); // Safe if obj is already deleted or null
     _value_label = nullptr; // Ensure pointer is nullified
 }
 
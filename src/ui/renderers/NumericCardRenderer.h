@@ -7,15 +7,20 @@
 
 class NumericCardRenderer : public InsightRendererBase {
 public:
-    NumericCardRenderer();
+    explicit NumericCardRenderer(std::shared_ptr<WidgetPool> widget_pool = nullptr);
     ~NumericCardRenderer() override;
 
     void createElements(lv_obj_t* parent_container) override;
-    void updateDisplay(InsightParser& parser, const String& title, const char* prefix = nullptr, const char* suffix = nullptr) override;
+    std::unique_ptr<ViewModel> prepare(const InsightModel& model, const Geometry& geometry) override;
+    void apply(const ViewModel& view_model) override;
     void clearElements() override;
     bool areElementsValid() const override;
 
 private:
+    struct NumericViewModel : ViewModel {
+        String text; // Fully formatted value including prefix/suffix
+    };
+
     lv_obj_t* _value_label; // LVGL label object for displaying the numeric value
     // Title is handled by InsightCard itself, this renderer only cares about the value display.
 
@@ -0,0 +1,203 @@
+#include "RetentionRenderer.h"
+#include <algorithm> // For std::min, std::fill_n, std::equal
+#include <new>       // For std::nothrow
+#include <string.h>  // For memcpy
+
+static const uint32_t BG_COLOR = 0x050505;   // Same as the chart backgrounds
+static const uint32_t CELL_COLOR = 0x2980b9; // Blue, matching the first series
+
+RetentionRenderer::RetentionRenderer(std::shared_ptr<WidgetPool> widget_pool)
+    : InsightRendererBase(std::move(widget_pool)), _canvas(nullptr), _width(0), _height(0), _stride(0),
+      _drawn_period_count(0), _drawn_cell_width(0), _drawn_cell_height(0) {
+    lv_color_t bg = lv_color_hex(BG_COLOR);
+    lv_color_t cell = lv_color_hex(CELL_COLOR);
+    _bg_color = lv_color_to_u16(bg);
+    for (int i = 0; i < 256; ++i) {
+        _color_table[i] = lv_color_to_u16(lv_color_mix(cell, bg, i));
+    }
+    std::fill_n(_drawn_levels, MAX_COHORTS * MAX_PERIODS, NO_DATA);
+    // Serial.println("[RetentionRenderer] Constructor");
+}
+
+RetentionRenderer::~RetentionRenderer() {
+    // Serial.println("[RetentionRenderer] Destructor");
+    // Relies on InsightCard calling clearElements before destruction,
+    // so the canvas no longer references the pixel buffer freed here.
+}
+
+void RetentionRenderer::createElements(lv_obj_t* parent_container) {
+    if (!isValidLVGLObject(parent_container)) {
+        Serial.println("[RetentionRenderer-ERROR] Parent container invalid in createElements.");
+        return;
+    }
+
+    _canvas = acquireWidget(WidgetPool::Kind::CANVAS, parent_container);
+    if (!_canvas) {
+        Serial.println("[RetentionRenderer-ERROR] Failed to create canvas object.");
+        return;
+    }
+
+    // Sized by its pixel buffer, bound on the first apply()
+    lv_obj_align(_canvas, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_clear_flag(_canvas, LV_OBJ_FLAG_SCROLLABLE);
+    _width = 0;
+    _height = 0;
+}
+
+std::unique_ptr<InsightRendererBase::ViewModel> RetentionRenderer::prepare(const InsightModel& model, const Geometry& geometry) {
+    // Runs on the event task: layout and color quantisation happen here
+    if (model.retention_cohort_count == 0 || model.retention_period_count == 0) {
+        Serial.println("[RetentionRenderer-WARN] No retention data in model.");
+        return nullptr;
+    }
+
+    lv_coord_t width = std::min(geometry.width, (lv_coord_t)MAX_WIDTH);
+    lv_coord_t height = std::min(geometry.height, (lv_coord_t)MAX_HEIGHT);
+
+    std::unique_ptr<RetentionViewModel> view_model(new RetentionViewModel());
+    view_model->cohort_count = model.retention_cohort_count;
+    view_model->period_count = model.retention_period_count;
+    view_model->cell_width = width / (lv_coord_t)model.retention_period_count;
+    view_model->cell_height = height / (lv_coord_t)model.retention_cohort_count;
+    if (view_model->cell_width < 1 || view_model->cell_height < 1) {
+        Serial.println("[RetentionRenderer-ERROR] Content area too small for the grid.");
+        return nullptr;
+    }
+
+    // Separate cells with a 1px gap once they are big enough to afford it
+    view_model->gap = (view_model->cell_width >= 4 && view_model->cell_height >= 4) ? 1 : 0;
+    view_model->width = view_model->cell_width * (lv_coord_t)model.retention_period_count;
+    view_model->height = view_model->cell_height * (lv_coord_t)model.retention_cohort_count;
+
+    std::fill_n(view_model->levels, MAX_COHORTS * MAX_PERIODS, NO_DATA);
+    for (size_t c = 0; c < model.retention_cohort_count; ++c) {
+        // Share of the cohort (period 0) still around in each later period
+        uint32_t cohort_size = model.retentionCount(c, 0);
+        for (size_t p = 0; p < model.retention_lengths[c]; ++p) {
+            uint32_t count = model.retentionCount(c, p);
+            int16_t level = 0;
+            if (cohort_size > 0) {
+                level = (int16_t)std::min<uint32_t>(255, ((uint64_t)count * 255 + cohort_size / 2) / cohort_size);
+            }
+            view_model->levels[c * MAX_PERIODS + p] = level;
+        }
+    }
+
+    return std::move(view_model);
+}
+
+bool RetentionRenderer::resizeCanvas(lv_coord_t width, lv_coord_t height) {
+    uint32_t stride = lv_draw_buf_width_to_stride(width, LV_COLOR_FORMAT_RGB565) / sizeof(uint16_t);
+    if (!_pixels || stride != _stride || height != _height) {
+        // Free the old buffer first so peak use stays at one canvas; nothing
+        // draws the canvas before it is rebound below on this same thread
+        _pixels.reset();
+        _pixels.reset(new (std::nothrow) uint16_t[stride * height]);
+        if (!_pixels) {
+            lv_obj_add_flag(_canvas, LV_OBJ_FLAG_HIDDEN); // Still bound to the freed buffer
+            Serial.printf("[RetentionRenderer-ERROR] Failed to allocate %ux%u canvas.\n",
+                          (unsigned int)width, (unsigned int)height);
+            _width = 0;
+            _height = 0;
+            return false;
+        }
+    }
+
+    lv_canvas_set_buffer(_canvas, _pixels.get(), width, height, LV_COLOR_FORMAT_RGB565);
+    lv_obj_clear_flag(_canvas, LV_OBJ_FLAG_HIDDEN);
+    _width = width;
+    _height = height;
+    _stride = stride;
+    return true;
+}
+
+void RetentionRenderer::fillBand(const RetentionViewModel& update, size_t cohort) {
+    const lv_coord_t cell_rows = update.cell_height - update.gap;
+    const lv_coord_t cell_columns = update.cell_width - update.gap;
+    uint16_t* first_row = _pixels.get() + cohort * update.cell_height * _stride;
+
+    // Build the band's first scanline from the color table...
+    uint16_t* pixel = first_row;
+    for (size_t p = 0; p < update.period_count; ++p) {
+        int16_t level = update.levels[cohort * MAX_PERIODS + p];
+        uint16_t color = level == NO_DATA ? _bg_color : _color_table[level];
+        pixel = std::fill_n(pixel, cell_columns, color);
+        pixel = std::fill_n(pixel, update.gap, _bg_color);
+    }
+
+    // ...then copy it down the rest of the cells, and clear the gap rows below
+    const size_t row_bytes = update.width * sizeof(uint16_t);
+    for (lv_coord_t y = 1; y < cell_rows; ++y) {
+        memcpy(first_row + y * _stride, first_row, row_bytes);
+    }
+    for (lv_coord_t y = cell_rows; y < update.cell_height; ++y) {
+        std::fill_n(first_row + y * _stride, update.width, _bg_color);
+    }
+}
+
+void RetentionRenderer::apply(const ViewModel& view_model) {
+    const RetentionViewModel& update = static_cast<const RetentionViewModel&>(view_model);
+
+    if (!areElementsValid()) {
+        Serial.println("[RetentionRenderer-WARN] Canvas invalid in apply.");
+        return;
+    }
+
+    // A new grid shape redraws everything; otherwise only cohorts whose cells changed
+    bool full = false;
+    if (!_pixels || update.width != _width || update.height != _height ||
+        update.period_count != _drawn_period_count ||
+        update.cell_width != _drawn_cell_width || update.cell_height != _drawn_cell_height) {
+        if (!resizeCanvas(update.width, update.height)) return;
+        full = true;
+    }
+
+    lv_area_t coords;
+    lv_obj_get_coords(_canvas, &coords);
+
+    size_t redrawn = 0;
+    for (size_t c = 0; c < update.cohort_count; ++c) {
+        const int16_t* levels = update.levels + c * MAX_PERIODS;
+        if (!full && std::equal(levels, levels + update.period_count, _drawn_levels + c * MAX_PERIODS)) {
+            continue;
+        }
+
+        fillBand(update, c);
+        redrawn++;
+
+        if (!full) {
+            lv_area_t band = coords;
+            band.y1 = coords.y1 + c * update.cell_height;
+            band.y2 = band.y1 + update.cell_height - 1;
+            lv_obj_invalidate_area(_canvas, &band);
+        }
+    }
+
+    if (redrawn == 0) return;
+    if (full) {
+        lv_obj_invalidate(_canvas);
+    }
+
+    memcpy(_drawn_levels, update.levels, sizeof(_drawn_levels));
+    _drawn_period_count = update.period_count;
+    _drawn_cell_width = update.cell_width;
+    _drawn_cell_height = update.cell_height;
+}
+
+void RetentionRenderer::clearElements() {
+    // Expected to be called from LVGL UI thread.
+    releaseWidget(_canvas); // The pool unbinds our pixel buffer
+    _canvas = nullptr;
+    // Canvas no longer references the buffer, so it can go too
+    _pixels.reset();
+    _width = 0;
+    _height = 0;
+    _drawn_period_count = 0;
+    _drawn_cell_width = 0;
+    _drawn_cell_height = 0;
+}
+
+bool RetentionRenderer::areElementsValid() const {
+    // Can be called from any thread.
+    return isValidLVGLObject(_canvas);
+}
@@ -0,0 +1,78 @@
+#ifndef RETENTION_RENDERER_H
+#define RETENTION_RENDERER_H
+
+#include "InsightRendererBase.h"
+#include "../Style.h" // For styles, colors, fonts
+#include <memory>
+
+/**
+ * @class RetentionRenderer
+ * @brief Draws a retention cohort grid as a heatmap in one canvas
+ *
+ * One lv_obj per cell would exhaust LVGL's memory pool long before a 12x12
+ * grid, so cells are written as RGB565 pixels straight into a canvas buffer.
+ * Retention percentages are quantised to 0-255 in prepare() and looked up in
+ * a 256-entry color table, so apply() is only table lookups and row copies:
+ * each cohort's first scanline is built once and copied down the band.
+ *
+ * Memory is fixed: the canvas never exceeds MAX_WIDTH x MAX_HEIGHT pixels.
+ */
+class RetentionRenderer : public InsightRendererBase {
+public:
+    explicit RetentionRenderer(std::shared_ptr<WidgetPool> widget_pool = nullptr);
+    ~RetentionRenderer() override;
+
+    void createElements(lv_obj_t* parent_container) override;
+    std::unique_ptr<ViewModel> prepare(const InsightModel& model, const Geometry& geometry) override;
+    void apply(const ViewModel& view_model) override;
+    void clearElements() override;
+    bool areElementsValid() const override;
+
+private:
+    static constexpr size_t MAX_COHORTS = InsightModel::MAX_RETENTION_COHORTS;
+    static constexpr size_t MAX_PERIODS = InsightModel::MAX_RETENTION_PERIODS;
+    static constexpr lv_coord_t MAX_WIDTH = 320;
+    static constexpr lv_coord_t MAX_HEIGHT = 240;
+    static constexpr int16_t NO_DATA = -1; ///< Level of a cell the cohort hasn't reached yet
+
+    struct RetentionViewModel : ViewModel {
+        lv_coord_t width = 0;   ///< Grid size in pixels, a whole number of cells
+        lv_coord_t height = 0;
+        size_t cohort_count = 0;
+        size_t period_count = 0;
+        lv_coord_t cell_width = 0;
+        lv_coord_t cell_height = 0;
+        lv_coord_t gap = 0;     ///< Background pixels right of and below each cell
+        int16_t levels[MAX_COHORTS * MAX_PERIODS]; ///< Color table index per cell, or NO_DATA
+    };
+
+    lv_obj_t* _canvas;
+
+    // Pixel buffer bound to the canvas. Only touched on the UI thread.
+    std::unique_ptr<uint16_t[]> _pixels;
+    lv_coord_t _width;
+    lv_coord_t _height;
+    uint32_t _stride; ///< Row length of _pixels in pixels
+
+    // Layout and levels currently on the canvas, used as the diff baseline
+    size_t _drawn_period_count;
+    lv_coord_t _drawn_cell_width;
+    lv_coord_t _drawn_cell_height;
+    int16_t _drawn_levels[MAX_COHORTS * MAX_PERIODS];
+
+    uint16_t _bg_color;
+    uint16_t _color_table[256]; ///< RGB565, background at 0 to full color at 255
+
+    /**
+     * @brief (Re)bind a pixel buffer of the given size to the canvas
+     * The buffer is only reallocated when the size changes.
+     */
+    bool resizeCanvas(lv_coord_t width, lv_coord_t height);
+
+    /**
+     * @brief Rasterise one cohort's row of cells
+     */
+    void fillBand(const RetentionViewModel& update, size_t cohort);
+};
+
+#endif // RETENTION_RENDERER_H
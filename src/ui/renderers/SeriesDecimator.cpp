@@ -0,0 +1,69 @@
+#include "SeriesDecimator.h"
+#include <math.h>
+
+size_t SeriesDecimator::lttb(const double* input, size_t count, double* output, size_t threshold) {
+    if (!input || !output || count == 0 || threshold == 0) return 0;
+
+    // Nothing to reduce - copy straight through
+    if (count <= threshold) {
+        for (size_t i = 0; i < count; ++i) {
+            output[i] = input[i];
+        }
+        return count;
+    }
+
+    // Too few buckets for triangles: keep the end points only
+    if (threshold < 3) {
+        output[0] = input[0];
+        if (threshold == 2) output[1] = input[count - 1];
+        return threshold;
+    }
+
+    // First and last points are fixed, the rest is split into threshold - 2 buckets
+    const double bucket_size = static_cast<double>(count - 2) / (threshold - 2);
+
+    size_t written = 0;
+    size_t a = 0; // Index of the previously selected point
+    output[written++] = input[0];
+
+    for (size_t bucket = 0; bucket < threshold - 2; ++bucket) {
+        // Average of the next bucket is the third vertex of the triangle
+        size_t avg_start = static_cast<size_t>(floor((bucket + 1) * bucket_size)) + 1;
+        size_t avg_end = static_cast<size_t>(floor((bucket + 2) * bucket_size)) + 1;
+        if (avg_end > count) avg_end = count;
+        if (avg_start >= avg_end) avg_start = avg_end - 1;
+
+        double avg_x = 0.0;
+        double avg_y = 0.0;
+        for (size_t j = avg_start; j < avg_end; ++j) {
+            avg_x += j;
+            avg_y += input[j];
+        }
+        const size_t avg_len = avg_end - avg_start;
+        avg_x /= avg_len;
+        avg_y /= avg_len;
+
+        // Pick the point in this bucket forming the largest triangle with a and the average
+        size_t range_start = static_cast<size_t>(floor(bucket * bucket_size)) + 1;
+        size_t range_end = static_cast<size_t>(floor((bucket + 1) * bucket_size)) + 1;
+        if (range_end > count - 1) range_end = count - 1;
+
+        const double a_x = static_cast<double>(a);
+        const double a_y = input[a];
+        double max_area = -1.0;
+        size_t selected = range_start;
+        for (size_t j = range_start; j < range_end; ++j) {
+            double area = fabs((a_x - avg_x) * (input[j] - a_y) - (a_x - j) * (avg_y - a_y));
+            if (area > max_area) {
+                max_area = area;
+                selected = j;
+            }
+        }
+
+        output[written++] = input[selected];
+        a = selected;
+    }
+
+    output[written++] = input[count - 1];
+    return written;
+}
@@ -0,0 +1,40 @@
+#ifndef SERIES_DECIMATOR_H
+#define SERIES_DECIMATOR_H
+
+#include <stddef.h>
+
+/**
+ * @class SeriesDecimator
+ * @brief Shape-preserving downsampling for chart series
+ *
+ * A 240px-wide chart can't show more than one point per pixel column, so long
+ * ranges are reduced to the chart width before they reach LVGL. Uses
+ * Largest-Triangle-Three-Buckets, which keeps peaks and dips that a plain
+ * stride or average would flatten.
+ *
+ * Pure computation with no LVGL calls - safe to run off the UI thread.
+ */
+class SeriesDecimator {
+public:
+    /**
+     * @brief Downsample a series with Largest-Triangle-Three-Buckets
+     *
+     * @param input Source values, X is the sample index
+     * @param count Number of source values
+     * @param output Destination array with room for at least `threshold` values
+     * @param threshold Maximum number of points to keep
+     * @return Number of values written to output
+     *
+     * First and last points are always kept. Each kept point stays within its
+     * own bucket, so plotting the result at uniform spacing moves it by at most
+     * one bucket along X - under a pixel when threshold is the chart width.
+     * If count <= threshold the series is copied unchanged.
+     */
+    static size_t lttb(const double* input, size_t count, double* output, size_t threshold);
+
+private:
+    // Private constructor to prevent instantiation
+    SeriesDecimator() {}
+};
+
+#endif // SERIES_DECIMATOR_H
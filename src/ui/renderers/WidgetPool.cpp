@@ -0,0 +1,127 @@
+#include "WidgetPool.h"
+#include "../UICallback.h"
+
+// Worst LVGL heap state seen by any pool since boot, for long soak runs
+static uint8_t s_peak_frag_pct = 0;
+static uint32_t s_min_free_biggest = UINT32_MAX;
+
+WidgetPool::WidgetPool(lv_obj_t* owner)
+    : _owner(owner), _park(nullptr), _created(0), _reused(0) {
+}
+
+lv_obj_t* WidgetPool::create(Kind kind, lv_obj_t* parent) {
+    switch (kind) {
+        case Kind::LABEL:  return lv_label_create(parent);
+        case Kind::CHART:  return lv_chart_create(parent);
+        case Kind::CANVAS: return lv_canvas_create(parent);
+        default:           return lv_obj_create(parent);
+    }
+}
+
+WidgetPool::Kind WidgetPool::kindOf(lv_obj_t* obj) {
+    if (lv_obj_check_type(obj, &lv_label_class)) return Kind::LABEL;
+    if (lv_obj_check_type(obj, &lv_chart_class)) return Kind::CHART;
+    if (lv_obj_check_type(obj, &lv_canvas_class)) return Kind::CANVAS;
+    return Kind::BOX;
+}
+
+lv_obj_t* WidgetPool::acquire(Kind kind, lv_obj_t* parent) {
+    UI_THREAD_ASSERT();
+    std::vector<lv_obj_t*>& parked = _parked[(size_t)kind];
+    while (!parked.empty()) {
+        lv_obj_t* obj = parked.back();
+        parked.pop_back();
+        if (!lv_obj_is_valid(obj)) continue; // Went with the card's object tree
+
+        lv_obj_set_parent(obj, parent);
+        lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+        _reused++;
+        return obj;
+    }
+
+    lv_obj_t* obj = create(kind, parent);
+    if (obj) {
+        _created++;
+    }
+    return obj;
+}
+
+void WidgetPool::release(lv_obj_t* obj) {
+    UI_THREAD_ASSERT();
+    if (!obj || !lv_obj_is_valid(obj)) return;
+
+    Kind kind = kindOf(obj);
+    std::vector<lv_obj_t*>& parked = _parked[(size_t)kind];
+
+    if (!_park || !lv_obj_is_valid(_park)) {
+        _park = nullptr;
+        if (_owner && lv_obj_is_valid(_owner)) {
+            _park = lv_obj_create(_owner);
+            if (_park) {
+                lv_obj_add_flag(_park, LV_OBJ_FLAG_HIDDEN);
+                lv_obj_add_flag(_park, LV_OBJ_FLAG_IGNORE_LAYOUT);
+            }
+        }
+    }
+
+    if (!_park || parked.size() >= MAX_PARKED_PER_KIND) {
+        lv_obj_del(obj);
+        return;
+    }
+
+    // Drop whatever the last renderer attached, back to a freshly created widget
+    lv_obj_clean(obj);
+    switch (kind) {
+        case Kind::LABEL:
+            lv_label_set_text(obj, "");
+            lv_label_set_long_mode(obj, LV_LABEL_LONG_WRAP);
+            break;
+        case Kind::CHART: {
+            lv_chart_series_t* series;
+            while ((series = lv_chart_get_series_next(obj, nullptr)) != nullptr) {
+                lv_chart_remove_series(obj, series);
+            }
+            lv_chart_set_point_count(obj, 0);
+            break;
+        }
+        case Kind::CANVAS:
+            lv_image_set_src(obj, nullptr); // The renderer frees its pixel buffer
+            break;
+        default:
+            break;
+    }
+    // Size, position and alignment are styles too in LVGL 9
+    lv_obj_remove_style_all(obj);
+    lv_theme_apply(obj);
+
+    lv_obj_set_parent(obj, _park);
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    parked.push_back(obj);
+}
+
+void WidgetPool::reset() {
+    // The objects themselves go with the owner's tree; only drop the pointers,
+    // so a recycled address can never be handed out as a parked widget
+    for (std::vector<lv_obj_t*>& list : _parked) {
+        list.clear();
+    }
+    _park = nullptr;
+}
+
+void WidgetPool::logStats(const char* tag) const {
+    size_t parked = 0;
+    for (const std::vector<lv_obj_t*>& list : _parked) {
+        parked += list.size();
+    }
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    if (mon.frag_pct > s_peak_frag_pct) s_peak_frag_pct = mon.frag_pct;
+    if (mon.free_biggest_size < s_min_free_biggest) s_min_free_biggest = mon.free_biggest_size;
+
+    Serial.printf("[WidgetPool-%s] created %lu, reused %lu, parked %u | LVGL heap used %u%%, frag %u%% (peak %u%%), "
+                  "biggest free %lu (min %lu)\n",
+                  tag, (unsigned long)_created, (unsigned long)_reused, (unsigned int)parked,
+                  (unsigned int)mon.used_pct, (unsigned int)mon.frag_pct, (unsigned int)s_peak_frag_pct,
+                  (unsigned long)mon.free_biggest_size, (unsigned long)s_min_free_biggest);
+}
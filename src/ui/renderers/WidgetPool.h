@@ -0,0 +1,82 @@
+#ifndef WIDGET_POOL_H
+#define WIDGET_POOL_H
+
+#include "lvgl.h"
+#include <Arduino.h>
+#include <vector>
+
+/**
+ * @class WidgetPool
+ * @brief Per-card cache of LVGL widgets shared by its renderers
+ *
+ * Renderers borrow labels, plain boxes, charts and canvases instead of
+ * creating them, and hand them back from clearElements(). Returned widgets
+ * are reset to their theme styles, hidden and parked under a hidden child of
+ * the card, so flipping an insight between types, or rebuilding it, reuses
+ * the same objects rather than churning the small LVGL heap.
+ *
+ * UI thread only. Parked widgets are deleted along with the card's object
+ * tree, so the pool itself never deletes them.
+ */
+class WidgetPool {
+public:
+    enum class Kind : uint8_t {
+        LABEL,  ///< lv_label
+        BOX,    ///< Plain lv_obj, used for containers and bars
+        CHART,  ///< lv_chart
+        CANVAS, ///< lv_canvas
+        COUNT
+    };
+
+    /**
+     * @param owner Card object the parked widgets live under
+     */
+    explicit WidgetPool(lv_obj_t* owner);
+
+    /**
+     * @brief Borrow a widget, reusing a parked one when available
+     *
+     * @param kind Type of widget
+     * @param parent Object to attach it to
+     * @return Visible widget with default styles, or nullptr if creation failed
+     */
+    lv_obj_t* acquire(Kind kind, lv_obj_t* parent);
+
+    /**
+     * @brief Return a widget to the pool
+     *
+     * Release children before their parent: anything still attached to a
+     * released widget is deleted. Widgets beyond MAX_PARKED_PER_KIND are deleted.
+     */
+    void release(lv_obj_t* obj);
+
+    /**
+     * @brief Forget every parked widget
+     * Call before deleting the owner's children, which takes the park with them.
+     */
+    void reset();
+
+    /**
+     * @brief Log pool counters alongside LVGL heap usage and fragmentation
+     */
+    void logStats(const char* tag) const;
+
+    /**
+     * @brief Create a new widget without a pool
+     */
+    static lv_obj_t* create(Kind kind, lv_obj_t* parent);
+
+private:
+    static constexpr size_t MAX_PARKED_PER_KIND = 40; ///< Enough for a full funnel's boxes
+
+    lv_obj_t* _owner;
+    lv_obj_t* _park; ///< Hidden holder for released widgets, created on first release
+    std::vector<lv_obj_t*> _parked[(size_t)Kind::COUNT];
+
+    uint32_t _created;
+    uint32_t _reused;
+
+    static Kind kindOf(lv_obj_t* obj);
+};
+
+#endif // WIDGET_POOL_H